@@ -16,6 +16,7 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "ReaderCallbacks.hpp"
+#include "src/SelfTracer.hpp"
 #include "src/models/communication/Communication.hpp"
 #include "src/models/Slot.hpp"
 #include "lib/otf2xx/include/otf2xx/otf2.hpp"
@@ -27,13 +28,25 @@
 #include <utility>
 #include <type_traits>
 
-ReaderCallbacks::ReaderCallbacks(otf2::reader::reader &rdr) :
+ReaderCallbacks::ReaderCallbacks(otf2::reader::reader &rdr, LoadOptions options) :
     slots_(std::vector<Slot*>()),
     communications_(std::vector<Communication*>()),
     collectiveCommunications_(std::vector<CollectiveCommunicationEvent*>()),
     slotsBuilding(),
     program_start_(),
+    options_(std::move(options)),
     rdr_(rdr) {
+    if (options_.summaryOnly) {
+        summary_ = new TraceSummary();
+    } else if (options_.progressSnapshots) {
+        progress_ = new TraceSummary();
+    }
+}
+
+ReaderCallbacks::~ReaderCallbacks() {
+    delete summary_;
+    delete progress_;
+    delete callingContextTree_;
 
 }
 
@@ -46,12 +59,87 @@ otf2::chrono::duration ReaderCallbacks::duration() const {
     return this->program_end_ - this->program_start_;
 }
 
+otf2::chrono::duration ReaderCallbacks::definedDuration() const {
+    return this->definedDuration_;
+}
+
+size_t ReaderCallbacks::excludedSlotCount() const {
+    return this->excludedSlotCount_;
+}
+
+const std::map<uint64_t, SlotKind> &ReaderCallbacks::getRegionKinds() const {
+    return this->regionKinds_;
+}
+
+TraceSummary *ReaderCallbacks::takeSummary() {
+    return std::exchange(this->summary_, nullptr);
+}
+
+void ReaderCallbacks::requestSnapshot() {
+    this->snapshotRequested_ = true;
+}
+
+TraceSummary::Snapshot ReaderCallbacks::latestSnapshot() {
+    std::lock_guard lock(this->snapshotMutex_);
+    return this->snapshot_;
+}
+
+types::TraceTime ReaderCallbacks::currentTime() const {
+    return this->currentTime_;
+}
+
+void ReaderCallbacks::publishProgress(types::TraceTime time) {
+    this->currentTime_.store(std::max(time, this->currentTime_.load(std::memory_order_relaxed)),
+                             std::memory_order_relaxed);
+    if (this->progress_ && this->snapshotRequested_.exchange(false)) {
+        auto snapshot = this->progress_->snapshot(PROGRESS_SNAPSHOT_ROWS);
+        std::lock_guard lock(this->snapshotMutex_);
+        this->snapshot_ = std::move(snapshot);
+    }
+}
+
+bool ReaderCallbacks::isOutsideWindow(const TimedElement *element) const {
+    return element->getEndTime() < this->options_.windowBegin || element->getStartTime() > this->options_.windowEnd;
+}
+
+bool ReaderCallbacks::isExcluded(const otf2::definition::region &region) {
+    if (this->options_.regionFilter.isEmpty()) return false;
+
+    // The rules are evaluated once per region
+    auto ref = region.ref().get();
+    if (ref >= this->regionExcluded_.size()) {
+        this->regionExcluded_.resize(ref + 1, 0);
+    }
+    if (this->regionExcluded_[ref] == 0) {
+        this->regionExcluded_[ref] = this->options_.regionFilter.isExcluded(region) ? 2 : 1;
+    }
+    return this->regionExcluded_[ref] == 2;
+}
+
+void ReaderCallbacks::definition(const otf2::definition::clock_properties &properties) {
+    otf2::chrono::convert convert(properties.ticks_per_second());
+    this->definedDuration_ = convert(properties.length()).time_since_epoch();
+}
+
 void ReaderCallbacks::definition(const otf2::definition::location &loc) {
+    // Sampling skips the events of whole ranks, as OTF2 stores them per location
+    if (loc.location_group().ref().get() % this->options_.rankStride != 0) return;
     rdr_.register_location(loc);
 }
 
+void ReaderCallbacks::definition(const otf2::definition::region &region) {
+    // The kind is derived from the region name like for any other slot
+    otf2::definition::region copy(region);
+    Slot probe(types::TraceTime(0), types::TraceTime(0), nullptr, &copy);
+    this->regionKinds_[region.ref().get()] = probe.getKind();
+}
+
 void ReaderCallbacks::event(const otf2::definition::location &, const otf2::event::program_begin &event) {
-    this->program_start_ = event.timestamp();
+    // All times are relative to the earliest program begin of all locations, whichever location is read first
+    if (!this->programStarted_ || event.timestamp() < this->program_start_) {
+        this->programStarted_ = true;
+        this->program_start_ = event.timestamp();
+    }
 }
 
 void ReaderCallbacks::event(const otf2::definition::location &, const otf2::event::program_end &event) {
@@ -60,36 +148,103 @@ void ReaderCallbacks::event(const otf2::definition::location &, const otf2::even
 
 
 void ReaderCallbacks::event(const otf2::definition::location &loc, const otf2::event::enter &event) {
+    // Time spent in excluded regions is accounted to their caller in the summary
+    if (this->summary_) {
+        if (!isExcluded(event.region())) {
+            this->summary_->enter(loc, event.region(), relative(event.timestamp()));
+        } else {
+            this->excludedSlotCount_++;
+        }
+        return;
+    }
+
+    std::vector<SlotFrame> *frames;
+    auto framesIt = this->slotsBuilding.find(loc.ref().get());
+    if (framesIt == this->slotsBuilding.end()) {
+        frames = new std::vector<SlotFrame>();
+        this->slotsBuilding.insert({loc.ref().get(), frames});
+    } else {
+        frames = framesIt->second;
+    }
+
+    auto parentNode = frames->empty() ? CallingContextTree::ROOT : frames->back().node;
+    auto depth = frames->empty() ? 0 : frames->back().childDepth;
+
     auto start = event.timestamp() - this->program_start_;
+    publishProgress(start);
+
+    // Excluded regions get neither a slot nor a calling context, their children are attached to the enclosing slot.
+    // Calls starting after the window are skipped the same way.
+    auto excluded = isExcluded(event.region());
+    if (excluded || start > this->options_.windowEnd) {
+        SlotFrame frame{{}, parentNode, {}, true, 0, depth};
+        if (!frames->empty()) {
+            frame.owner = frames->back().excluded ? frames->back().owner : frames->size() - 1;
+        }
+        frames->push_back(std::move(frame));
+        this->excludedSlotCount_ += excluded;
+        return;
+    }
 
     Slot::Builder builder{};
     auto region = new otf2::definition::region(event.region());
     auto location = new otf2::definition::location(loc);
     builder.start(start)->location(location)->region(region);
 
-    std::vector<Slot::Builder> *builders;
-    auto buildersIt = this->slotsBuilding.find(location->ref().get());
-    if (buildersIt == this->slotsBuilding.end()) {
-        builders = new std::vector<Slot::Builder>();
-        this->slotsBuilding.insert({location->ref().get(), builders});
-    } else {
-        builders = buildersIt->second;
+    auto node = this->callingContextTree_->enter(parentNode, event.region());
+    frames->push_back({builder, node, {}, false, 0, depth + 1});
+    if (this->progress_) {
+        this->progress_->enter(loc, event.region(), start);
     }
-
-    builders->push_back(builder);
 }
 
 void ReaderCallbacks::event(const otf2::definition::location &location, const otf2::event::leave &event) {
-    auto builders = this->slotsBuilding.at(location.ref().get());
+    if (this->summary_) {
+        if (!isExcluded(event.region())) {
+            this->summary_->leave(location, relative(event.timestamp()));
+        }
+        return;
+    }
+
+    auto frames = this->slotsBuilding.at(location.ref().get());
 
-    Slot::Builder &builder = builders->back();
+    SlotFrame &frame = frames->back();
+    if (frame.excluded) {
+        frames->pop_back();
+        return;
+    }
 
     auto end = event.timestamp() - this->program_start_;
-    builder.end(end);
+    frame.builder.end(end);
+    if (this->progress_) {
+        this->progress_->leave(location, end);
+    }
+
+    auto slot = new Slot(frame.builder.build());
+    slot->depth = frame.childDepth - 1;
+
+    // Calls ending before the window are dropped, their children ended before as well and were dropped already. Their
+    // nodes in the calling context tree stay without visits.
+    if (slot->endTime < this->options_.windowBegin) {
+        delete slot->region;
+        delete slot->location;
+        delete slot;
+        frames->pop_back();
+        return;
+    }
 
-    this->slots_.push_back(new Slot(builder.build()));
+    this->callingContextTree_->leave(frame.node, slot->endTime - slot->startTime);
+    slot->callPath = static_cast<uint32_t>(frame.node);
+    for (const auto &child: frame.children) {
+        child->parent = slot;
+    }
+    this->slots_.push_back(slot);
 
-    builders->pop_back();
+    frames->pop_back();
+    if (!frames->empty()) {
+        auto &parent = frames->back().excluded ? (*frames)[frames->back().owner] : frames->back();
+        parent.children.push_back(slot);
+    }
 }
 
 
@@ -104,7 +259,13 @@ void ReaderCallbacks::communicationEvent(T* self, uint32_t matching,
         auto matchingEvent = matchingEvents->back();
 
         auto communication = new Communication(matchingEvent, self);
-        communications_.push_back(communication);
+        if (isOutsideWindow(communication)) {
+            delete communication;
+            delete matchingEvent;
+            delete self;
+        } else {
+            communications_.push_back(communication);
+        }
 
         matchingEvents->pop_back();
         if (matchingEvents->empty()) {
@@ -126,37 +287,50 @@ void ReaderCallbacks::communicationEvent(T* self, uint32_t matching,
 }
 
 void ReaderCallbacks::event(const otf2::definition::location &loc, const otf2::event::mpi_send &send) {
+    if (this->summary_) return;
+
     auto location = new otf2::definition::location(loc);
     auto comm = new types::communicator(send.comm());
-    auto ev = new BlockingSendEvent(relative(send.timestamp()), location, comm);
+    auto ev = new BlockingSendEvent(relative(send.timestamp()), location, comm, send.msg_length(), send.msg_tag());
 
     this->communicationEvent<BlockingSendEvent>(ev, send.receiver(), pendingSends, pendingReceives);
 }
 
 void ReaderCallbacks::event(const otf2::definition::location &loc, const otf2::event::mpi_receive &receive) {
+    if (this->summary_) return;
+
     auto location = new otf2::definition::location(loc);
     auto comm = new types::communicator(receive.comm());
-    auto ev = new BlockingReceiveEvent(relative(receive.timestamp()), location, comm);
+    auto ev = new BlockingReceiveEvent(relative(receive.timestamp()), location, comm, receive.msg_length(),
+                                       receive.msg_tag());
 
     this->communicationEvent(ev, receive.sender(), pendingReceives, pendingSends);
 }
 
 void ReaderCallbacks::event(const otf2::definition::location &location, const otf2::event::mpi_isend_request &request) {
+    if (this->summary_) return;
+
     NonBlockingSendEvent::Builder builder;
     auto comm = new types::communicator (request.comm());
     auto loc = new otf2::definition::location(location);
     auto start = relative(request.timestamp());
     auto receiver = request.receiver();
+    auto messageLength = request.msg_length();
+    auto messageTag = request.msg_tag();
     builder.communicator(comm);
     builder.location(loc);
     builder.start(start);
     builder.receiver(receiver);
+    builder.messageLength(messageLength);
+    builder.messageTag(messageTag);
 
     this->uncompletedRequests.insert({request.request_id(), builder});
 }
 
 void
 ReaderCallbacks::event(const otf2::definition::location &, const otf2::event::mpi_isend_complete &complete) {
+    if (this->summary_) return;
+
     if (!uncompletedRequests.contains(complete.request_id())) {
         throw std::logic_error("Found a mpi_isend_complete event with no matching mpi_isend_request event!");
     }
@@ -178,6 +352,8 @@ ReaderCallbacks::event(const otf2::definition::location &, const otf2::event::mp
 
 void
 ReaderCallbacks::event(const otf2::definition::location &, const otf2::event::mpi_ireceive_complete &complete) {
+    if (this->summary_) return;
+
     if (!uncompletedRequests.contains(complete.request_id())) {
         throw std::logic_error("Found a mpi_ireceive_complete event with no matching mpi_ireceive_request event!");
     }
@@ -199,16 +375,21 @@ ReaderCallbacks::event(const otf2::definition::location &, const otf2::event::mp
 
 void
 ReaderCallbacks::event(const otf2::definition::location &location, const otf2::event::mpi_ireceive_request &request) {
+    if (this->summary_) return;
 
     NonBlockingReceiveEvent::Builder builder;
     auto comm = new types::communicator (request.comm());
     auto loc = new otf2::definition::location(location);
     auto start = relative(request.timestamp());
     auto sender = request.sender();
+    auto messageLength = request.msg_length();
+    auto messageTag = request.msg_tag();
     builder.communicator(comm);
     builder.location(loc);
     builder.start(start);
     builder.sender(sender);
+    builder.messageLength(messageLength);
+    builder.messageTag(messageTag);
 
     this->uncompletedRequests.insert({request.request_id(), builder});
 }
@@ -224,6 +405,8 @@ void ReaderCallbacks::event(const otf2::definition::location &location,
 
 void
 ReaderCallbacks::event(const otf2::definition::location &location, const otf2::event::mpi_collective_begin &begin) {
+    if (this->summary_) return;
+
     CollectiveCommunicationEvent::Member::Builder builder;
     auto loc = new otf2::definition::location(location);
     auto start = relative(begin.timestamp());
@@ -235,6 +418,8 @@ ReaderCallbacks::event(const otf2::definition::location &location, const otf2::e
 }
 
 void ReaderCallbacks::event(const otf2::definition::location &location, const otf2::event::mpi_collective_end &anEnd) {
+    if (this->summary_) return;
+
     if(ongoingCollectiveCommunication == nullptr) {
         ongoingCollectiveCommunication = new CollectiveCommunicationEvent::Builder();
         std::vector<CollectiveCommunicationEvent::Member*> members;
@@ -259,7 +444,11 @@ void ReaderCallbacks::event(const otf2::definition::location &location, const ot
     // If the map is now empty, all ranks have completed the collective operation and the communication event can be build
     if(ongoingCollectiveCommunicationMembers.empty()){
         auto event = new CollectiveCommunicationEvent(ongoingCollectiveCommunication->build());
-        collectiveCommunications_.push_back(event);
+        if (isOutsideWindow(event)) {
+            delete event;
+        } else {
+            collectiveCommunications_.push_back(event);
+        }
         delete ongoingCollectiveCommunication;
         ongoingCollectiveCommunication = nullptr;
     }
@@ -267,6 +456,7 @@ void ReaderCallbacks::event(const otf2::definition::location &location, const ot
 
 
 void ReaderCallbacks::events_done(const otf2::reader::reader &) {
+    SelfTracer::Scope scope("sorting");
     std::sort(this->slots_.begin(), this->slots_.end(), [](Slot *rhs, Slot *lhs) {
         return rhs->startTime < lhs->startTime;
     });
@@ -295,12 +485,20 @@ void ReaderCallbacks::events_done(const otf2::reader::reader &) {
     std::destroy(this->pendingSends.begin(), this->pendingSends.end());
     std::destroy(this->pendingReceives.begin(), this->pendingReceives.end());
     std::destroy(this->uncompletedRequests.begin(), this->uncompletedRequests.end());
+
+    // The progress summary is only needed while reading
+    delete this->progress_;
+    this->progress_ = nullptr;
 }
 
 otf2::chrono::duration ReaderCallbacks::relative(otf2::chrono::time_point timepoint) const {
     return timepoint - program_start_;
 }
 
+CallingContextTree *ReaderCallbacks::takeCallingContextTree() {
+    return std::exchange(this->callingContextTree_, nullptr);
+}
+
 std::vector<Communication*> ReaderCallbacks::getCommunications() {
     return communications_;
 }
@@ -19,14 +19,24 @@
 #define MOTIV_READERCALLBACKS_HPP
 
 #include <otf2xx/otf2.hpp>
+#include <atomic>
 #include <cstdint>
+#include <mutex>
 
+#include "src/models/CallingContextTree.hpp"
+#include "src/models/LoadOptions.hpp"
+#include "src/models/TraceSummary.hpp"
 #include "src/models/Slot.hpp"
 #include "src/models/communication/Communication.hpp"
 #include "src/models/communication/NonBlockingSendEvent.hpp"
 #include "src/models/communication/NonBlockingReceiveEvent.hpp"
 #include "src/models/communication/CollectiveCommunicationEvent.hpp"
 
+/**
+ * Defines the maximum number of rows of the progress snapshots, neighbouring locations are combined beyond that
+ */
+#define PROGRESS_SNAPSHOT_ROWS 256
+
 template<typename T>
 using BuilderSetLocation = std::function<typename T::Builder *(typename T::Builder &,
                                                                otf2::definition::location &)>;
@@ -50,14 +60,46 @@ class ReaderCallbacks : public otf2::reader::callback {
     using otf2::reader::callback::event;
     using otf2::reader::callback::definition;
 private:
+    /**
+     * A slot that has been entered but not left yet
+     */
+    struct SlotFrame {
+        Slot::Builder builder;
+        /**
+         * Node of the slot in the calling context tree
+         */
+        size_t node;
+        /**
+         * Completed slots called from this slot, their parent is set once this slot is completed
+         */
+        std::vector<Slot *> children;
+        /**
+         * Whether the region is excluded by the region filter. Such frames only keep enter and leave events balanced.
+         */
+        bool excluded = false;
+        /**
+         * Index of the closest frame that is not excluded, which takes the children of an excluded frame
+         */
+        size_t owner = 0;
+        /**
+         * Depth of the slots called from this slot, excluded frames do not count
+         */
+        uint32_t childDepth = 0;
+    };
+
     std::vector<Slot *> slots_;
     std::vector<Communication *> communications_;
     std::vector<CollectiveCommunicationEvent *> collectiveCommunications_;
 
     /**
-     * Vectors for building the slot datatypes. Key is the location of the events.
+     * Calling context tree of all locations, the call stacks of the locations are followed separately
      */
-    std::map<otf2::reference<otf2::definition::location>, std::vector<Slot::Builder> *> slotsBuilding;
+    CallingContextTree *callingContextTree_ = new CallingContextTree();
+
+    /**
+     * Call stacks for building the slot datatypes. Key is the location of the events.
+     */
+    std::map<otf2::reference<otf2::definition::location>, std::vector<SlotFrame> *> slotsBuilding;
 
     /**
      * Vectors for building the blocking communication datatypes. Key is the location id of the sender.
@@ -79,17 +121,70 @@ private:
 
     otf2::chrono::time_point program_start_;
     otf2::chrono::time_point program_end_;
+    bool programStarted_ = false;
+
+    /**
+     * Length of the trace as stated by the clock properties
+     */
+    otf2::chrono::duration definedDuration_{0};
+
+    /**
+     * Regions whose enter and leave events are skipped and the time window to keep
+     */
+    LoadOptions options_;
+
+    /**
+     * Receives the enter and leave events if only a summary is loaded
+     */
+    TraceSummary *summary_ = nullptr;
+
+    /**
+     * Receives the enter and leave events in addition to the slots if LoadOptions::progressSnapshots is set
+     */
+    TraceSummary *progress_ = nullptr;
+
+    /**
+     * Set by the UI thread, the reader thread takes a snapshot of the progress summary on the next event
+     */
+    std::atomic<bool> snapshotRequested_ = false;
+
+    /**
+     * Time of the latest enter event relative to the program start
+     */
+    std::atomic<types::TraceTime> currentTime_{};
+
+    std::mutex snapshotMutex_;
+    TraceSummary::Snapshot snapshot_;
+
+    /**
+     * Evaluated region filter by region reference: 0 if not evaluated yet, 1 if included, 2 if excluded
+     */
+    std::vector<uint8_t> regionExcluded_;
+
+    size_t excludedSlotCount_ = 0;
+
+    /**
+     * Kinds of all defined regions by region reference
+     */
+    std::map<uint64_t, SlotKind> regionKinds_;
 
     otf2::reader::reader &rdr_;
 public:
     /**
      * @brief Creates a new instance of the ReaderCallbacks class
      * @param rdr Initialized reader
+     * @param options Options defining which elements are kept
      */
-    explicit ReaderCallbacks(otf2::reader::reader &rdr);
+    explicit ReaderCallbacks(otf2::reader::reader &rdr, LoadOptions options = LoadOptions());
+
+    ~ReaderCallbacks();
+
+    void definition(const otf2::definition::clock_properties &properties) override;
 
     void definition(const otf2::definition::location &loc) override;
 
+    void definition(const otf2::definition::region &region) override;
+
     void event(const otf2::definition::location &location, const otf2::event::program_begin &event) override;
 
     void event(const otf2::definition::location &location, const otf2::event::program_end &event) override;
@@ -131,6 +226,16 @@ public:
      */
     std::vector<Communication *> getCommunications();
 
+    /**
+     * @brief Returns the calling context tree of the calls of all locations
+     *
+     * The tree will only contain the calls read by the reader when calling @link (otf2::reader::reader::read_events).
+     * Ownership is transferred to the caller, later calls return nullptr.
+     *
+     * @return The calling context tree, the slots store the indices of its nodes
+     */
+    [[nodiscard]] CallingContextTree *takeCallingContextTree();
+
 
     /**
      * @brief Returns all read collective communications
@@ -156,6 +261,61 @@ public:
      */
     [[nodiscard]] otf2::chrono::duration duration() const;
 
+    /**
+     * @brief Returns the length of the trace as stated by its clock properties
+     *
+     * Unlike duration() this is known as soon as the reader has called @link (otf2::reader::reader::read_definitions).
+     *
+     * @return Length of the trace, zero if the archive does not state it
+     */
+    [[nodiscard]] otf2::chrono::duration definedDuration() const;
+
+    /**
+     * Number of calls skipped because their region is excluded by the region filter
+     * @return Number of skipped calls
+     */
+    [[nodiscard]] size_t excludedSlotCount() const;
+
+    /**
+     * @brief Returns the kinds of all regions
+     *
+     * The map will only contain the regions read by the reader when calling @link (otf2::reader::reader::read_definitions)
+     *
+     * @return The kinds by region reference
+     */
+    [[nodiscard]] const std::map<uint64_t, SlotKind> &getRegionKinds() const;
+
+    /**
+     * @brief Returns the summary the events were accumulated into when loading with LoadOptions::summaryOnly
+     *
+     * Ownership is transferred to the caller, later calls return nullptr.
+     * @return The summary or nullptr if all events were kept
+     */
+    [[nodiscard]] TraceSummary *takeSummary();
+
+    /**
+     * @brief Asks the reader thread to take a snapshot of the events read so far
+     *
+     * Only has an effect when loading with LoadOptions::progressSnapshots. May be called from any thread.
+     */
+    void requestSnapshot();
+
+    /**
+     * @brief Returns the latest snapshot taken after a call to requestSnapshot()
+     *
+     * May be called from any thread.
+     * @return Copy of the snapshot, empty if none was taken yet
+     */
+    [[nodiscard]] TraceSummary::Snapshot latestSnapshot();
+
+    /**
+     * @brief Returns how far the events have been read
+     *
+     * Events are read location by location in chunks, so this is only a rough indication. May be called from any thread.
+     * @return Time of the latest enter event relative to the program start
+     */
+    [[nodiscard]] types::TraceTime currentTime() const;
+
 private:
     template<typename T>
     void communicationEvent(T *self, uint32_t matching,
@@ -163,6 +323,15 @@ private:
                             std::map<uint32_t, std::vector<CommunicationEvent *> *> &matchingPending);
 
     [[nodiscard]] otf2::chrono::duration relative(otf2::chrono::time_point) const;
+
+    [[nodiscard]] bool isExcluded(const otf2::definition::region &region);
+
+    [[nodiscard]] bool isOutsideWindow(const TimedElement *element) const;
+
+    /**
+     * Records the progress and takes a snapshot if one was requested
+     */
+    void publishProgress(types::TraceTime time);
 };
 
 #endif //MOTIV_READERCALLBACKS_HPP
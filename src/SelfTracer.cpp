@@ -0,0 +1,92 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SelfTracer.hpp"
+
+#include <fstream>
+#include <set>
+
+SelfTracer::Scope::Scope(const char *name) : name(name), enabled(SelfTracer::getInstance().isEnabled()) {
+    if (enabled) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+SelfTracer::Scope::~Scope() {
+    if (enabled) {
+        SelfTracer::getInstance().record(name, start, std::chrono::steady_clock::now());
+    }
+}
+
+void SelfTracer::start(const std::string &tracePath) {
+    std::lock_guard lock(mutex);
+    path = tracePath;
+    events.clear();
+    origin = std::chrono::steady_clock::now();
+    enabled = true;
+}
+
+bool SelfTracer::stop() {
+    if (!enabled) return true;
+
+    std::lock_guard lock(mutex);
+    enabled = false;
+
+    std::ofstream file(path);
+    if (!file) return false;
+
+    auto microseconds = [this](std::chrono::steady_clock::time_point time) {
+        return std::chrono::duration<double, std::micro>(time - origin).count();
+    };
+
+    std::set<uint32_t> threads;
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const auto &event: events) {
+        threads.insert(event.thread);
+        file << "{\"name\":\"" << event.name << "\",\"cat\":\"motiv\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+             << ",\"ts\":" << microseconds(event.begin) << ",\"dur\":" << microseconds(event.end) - microseconds(event.begin)
+             << "},\n";
+    }
+    for (const auto &thread: threads) {
+        auto name = thread == 0 ? std::string("main") : "worker " + std::to_string(thread);
+        file << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread << ",\"args\":{\"name\":\""
+             << name << "\"}},\n";
+    }
+    file << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"motiv\"}}\n]}\n";
+
+    events.clear();
+    return static_cast<bool>(file);
+}
+
+bool SelfTracer::isEnabled() const {
+    return enabled;
+}
+
+void SelfTracer::record(const char *name, std::chrono::steady_clock::time_point begin,
+                        std::chrono::steady_clock::time_point end) {
+    auto thread = threadId();
+    std::lock_guard lock(mutex);
+    if (!enabled) return;
+    events.push_back({name, thread, begin, end});
+}
+
+uint32_t SelfTracer::threadId() {
+    // Threads are numbered in the order they record their first phase, the main thread usually records first
+    static std::atomic<uint32_t> nextId = 0;
+    thread_local uint32_t id = nextId++;
+    return id;
+}
@@ -0,0 +1,117 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_SELFTRACER_HPP
+#define MOTIV_SELFTRACER_HPP
+
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Singleton recording the phases of MOTIV itself
+ *
+ * Phases are recorded with their thread while tracing is started and written as Chrome trace JSON when it is stopped.
+ * The file can be opened with chrome://tracing, Perfetto or Speedscope. While tracing is stopped scopes only check an
+ * atomic flag.
+ */
+class SelfTracer {
+private:
+    SelfTracer() = default;
+
+public:
+    /**
+     * @brief Records the time between its construction and destruction as a phase
+     */
+    class Scope {
+    public:
+        /**
+         * Starts the phase if tracing is started
+         * @param name Name of the phase, has to outlive the tracer, e.g. a string literal
+         */
+        explicit Scope(const char *name);
+        ~Scope();
+
+    private:
+        const char *name;
+        bool enabled;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    /**
+     * @return instance of SelfTracer
+     */
+    static SelfTracer &getInstance() {
+        static SelfTracer instance;
+        return instance;
+    }
+
+    // Do not implement copy and copy assignment constructor.
+    SelfTracer(SelfTracer const &) = delete;
+    void operator=(SelfTracer const &) = delete;
+
+    /**
+     * @brief Starts recording phases
+     * @param path Path of the file the trace is written to on stop()
+     */
+    void start(const std::string &path);
+
+    /**
+     * @brief Stops recording and writes the recorded phases
+     * @return false if the trace could not be written
+     */
+    bool stop();
+
+    /**
+     * @brief Whether phases are recorded
+     * @return true if phases are recorded
+     */
+    [[nodiscard]] bool isEnabled() const;
+
+    /**
+     * @brief Records a phase
+     * @param name Name of the phase, has to outlive the tracer
+     * @param begin Start of the phase
+     * @param end End of the phase
+     */
+    void record(const char *name, std::chrono::steady_clock::time_point begin,
+                std::chrono::steady_clock::time_point end);
+
+private:
+    struct Event {
+        const char *name;
+        uint32_t thread;
+        std::chrono::steady_clock::time_point begin;
+        std::chrono::steady_clock::time_point end;
+    };
+
+    static uint32_t threadId();
+
+private:
+    std::atomic_bool enabled = false;
+    std::mutex mutex;
+    std::vector<Event> events;
+    std::string path;
+    std::chrono::steady_clock::time_point origin;
+};
+
+
+#endif //MOTIV_SELFTRACER_HPP
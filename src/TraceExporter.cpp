@@ -0,0 +1,365 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TraceExporter.hpp"
+#include "src/SelfTracer.hpp"
+
+#include <otf2xx/otf2.hpp>
+#include <otf2xx/writer/archive.hpp>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+namespace {
+    /**
+     * @brief Callbacks copying the definitions and the events inside the window from a reader to a writer
+     */
+    class ExportCallbacks : public otf2::reader::callback {
+        using otf2::reader::callback::event;
+        using otf2::reader::callback::definition;
+
+        /**
+         * Progress of a location through the window
+         */
+        struct LocationState {
+            explicit LocationState(otf2::definition::location definition) : definition(std::move(definition)) {
+            }
+
+            otf2::definition::location definition;
+            /**
+             * Regions entered but not left yet
+             */
+            std::vector<otf2::definition::region> stack;
+            /**
+             * Whether the calls active at the start of the window have been entered
+             */
+            bool opened = false;
+            /**
+             * Whether the end of the window has been passed and the active calls have been left
+             */
+            bool closed = false;
+            /**
+             * Non blocking requests whose start was written, only their completions are written
+             */
+            std::set<uint64_t> requests;
+            /**
+             * Whether a collective operation has begun inside the window and its end has not been read yet
+             */
+            bool collectivePending = false;
+            /**
+             * Writes the begin of the pending collective operation followed by the events read after it. They are
+             * held back until the end shows whether the operation can be written completely.
+             */
+            std::vector<std::function<void()>> heldBack;
+        };
+
+    public:
+        ExportCallbacks(otf2::reader::reader &reader, otf2::writer::archive &archive, const TraceExportOptions &options)
+            : reader(reader), archive(archive), options(options) {
+        }
+
+        [[nodiscard]] uint64_t writtenEvents() const {
+            return written;
+        }
+
+        void definition(const otf2::definition::clock_properties &definition) override {
+            archive << definition;
+        }
+
+        void definition(const otf2::definition::string &definition) override {
+            archive << definition;
+        }
+
+        void definition(const otf2::definition::system_tree_node &definition) override {
+            archive << definition;
+        }
+
+        void definition(const otf2::definition::location_group &definition) override {
+            archive << definition;
+        }
+
+        void definition(const otf2::definition::location &definition) override {
+            archive << definition;
+            // Every location gets an event file, even if its events are not exported
+            archive(definition);
+            if (options.ranks.empty() || options.ranks.contains(definition.location_group().ref().get())) {
+                reader.register_location(definition);
+            }
+        }
+
+        void definition(const otf2::definition::region &definition) override {
+            archive << definition;
+        }
+
+        void definition(const otf2::definition::comm_locations_group &definition) override {
+            archive << definition;
+        }
+
+        void definition(const otf2::definition::comm_group &definition) override {
+            archive << definition;
+        }
+
+        void definition(const otf2::definition::comm &definition) override {
+            archive << definition;
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::program_begin &event) override {
+            // The window is relative to the earliest program begin, like the times shown by ReaderCallbacks. The events
+            // are streamed, so the window has to be fixed by the first program begin read. The global event reader
+            // merges the locations by time, which makes it the earliest one.
+            if (!windowKnown) {
+                windowKnown = true;
+                windowBegin = event.timestamp() + options.begin;
+                windowEnd = options.end == types::TraceTime::max() ? otf2::chrono::time_point::max()
+                                                                    : event.timestamp() + options.end;
+            }
+            write(stateOf(location), otf2::event::program_begin(event, std::max(event.timestamp(), windowBegin)));
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::program_end &event) override {
+            programEnd = programEnd == otf2::chrono::time_point::max() ? event.timestamp()
+                                                                       : std::max(programEnd, event.timestamp());
+            auto time = std::clamp(event.timestamp(), windowBegin, windowEnd);
+            auto &state = stateOf(location);
+            if (!state.closed) {
+                close(state, time);
+            }
+            write(state, otf2::event::program_end(event, time));
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::enter &event) override {
+            auto &state = stateOf(location);
+            auto inWindow = advance(state, event.timestamp());
+            if (state.closed) return;
+
+            state.stack.push_back(event.region());
+            if (inWindow) write(state, event);
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::leave &event) override {
+            auto &state = stateOf(location);
+            auto inWindow = advance(state, event.timestamp());
+            if (state.closed || state.stack.empty()) return;
+
+            state.stack.pop_back();
+            if (inWindow) write(state, event);
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::mpi_send &event) override {
+            forward(location, event);
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::mpi_receive &event) override {
+            forward(location, event);
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::mpi_isend_request &event) override {
+            forwardRequest(location, event);
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::mpi_isend_complete &event) override {
+            forwardCompletion(location, event);
+        }
+
+        void
+        event(const otf2::definition::location &location, const otf2::event::mpi_ireceive_request &event) override {
+            forwardRequest(location, event);
+        }
+
+        void
+        event(const otf2::definition::location &location, const otf2::event::mpi_ireceive_complete &event) override {
+            forwardCompletion(location, event);
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::mpi_request_test &event) override {
+            auto &state = stateOf(location);
+            if (advance(state, event.timestamp()) && state.requests.contains(event.request_id())) {
+                write(state, event);
+            }
+        }
+
+        void
+        event(const otf2::definition::location &location, const otf2::event::mpi_request_cancelled &event) override {
+            forwardCompletion(location, event);
+        }
+
+        void
+        event(const otf2::definition::location &location, const otf2::event::mpi_collective_begin &event) override {
+            auto &state = stateOf(location);
+            if (!advance(state, event.timestamp())) return;
+
+            // A begin without end is dropped
+            if (state.collectivePending) release(state, false);
+            state.heldBack.emplace_back([this, location = state.definition, event] {
+                archive(location) << event;
+                written++;
+            });
+            state.collectivePending = true;
+        }
+
+        void event(const otf2::definition::location &location, const otf2::event::mpi_collective_end &event) override {
+            // Ends of operations begun before the window would not match any begin. Operations ending after the window
+            // have been dropped when advance() closed the location.
+            auto &state = stateOf(location);
+            if (advance(state, event.timestamp()) && state.collectivePending) {
+                release(state, true);
+                write(state, event);
+            }
+        }
+
+        void events_done(const otf2::reader::reader &) override {
+            // Locations without events after the window still have to leave their active calls
+            auto end = std::min(windowEnd, programEnd);
+            for (auto &[ref, state]: states) {
+                if (!state.closed) close(state, end);
+            }
+        }
+
+    private:
+        template<typename T>
+        void write(LocationState &state, const T &event) {
+            if (state.collectivePending) {
+                state.heldBack.emplace_back([this, location = state.definition, event] {
+                    archive(location) << event;
+                    written++;
+                });
+                return;
+            }
+            archive(state.definition) << event;
+            written++;
+        }
+
+        /**
+         * Writes the events held back during a collective operation, with or without the begin of the operation
+         */
+        void release(LocationState &state, bool withBegin) {
+            auto heldBack = std::move(state.heldBack);
+            state.heldBack.clear();
+            state.collectivePending = false;
+            for (size_t i = withBegin ? 0 : 1; i < heldBack.size(); i++) {
+                heldBack[i]();
+            }
+        }
+
+        template<typename T>
+        void forward(const otf2::definition::location &location, const T &event) {
+            auto &state = stateOf(location);
+            if (advance(state, event.timestamp())) {
+                write(state, event);
+            }
+        }
+
+        /**
+         * Writes the start of a non blocking request inside the window and remembers it
+         */
+        template<typename T>
+        void forwardRequest(const otf2::definition::location &location, const T &event) {
+            auto &state = stateOf(location);
+            if (advance(state, event.timestamp())) {
+                state.requests.insert(event.request_id());
+                write(state, event);
+            }
+        }
+
+        /**
+         * Writes the completion of a non blocking request whose start was written
+         */
+        template<typename T>
+        void forwardCompletion(const otf2::definition::location &location, const T &event) {
+            auto &state = stateOf(location);
+            if (advance(state, event.timestamp()) && state.requests.erase(event.request_id())) {
+                write(state, event);
+            }
+        }
+
+        LocationState &stateOf(const otf2::definition::location &location) {
+            return states.try_emplace(location.ref().get(), location).first->second;
+        }
+
+        /**
+         * Moves a location to the time of its next event, returns whether the event lies inside the window
+         */
+        bool advance(LocationState &state, otf2::chrono::time_point time) {
+            if (state.closed) return false;
+            if (time > windowEnd) {
+                close(state, windowEnd);
+                return false;
+            }
+            if (time < windowBegin) return false;
+            if (!state.opened) open(state);
+            return true;
+        }
+
+        /**
+         * Enters the calls active at the start of the window
+         */
+        void open(LocationState &state) {
+            for (const auto &region: state.stack) {
+                write(state, otf2::event::enter(windowBegin, region));
+            }
+            state.opened = true;
+        }
+
+        /**
+         * Leaves the calls active at the end of the window, no further events of the location are written
+         */
+        void close(LocationState &state, otf2::chrono::time_point time) {
+            // A collective operation still pending has no end inside the window and is dropped
+            if (state.collectivePending) release(state, false);
+            if (!state.opened) open(state);
+            for (auto it = state.stack.rbegin(); it != state.stack.rend(); it++) {
+                write(state, otf2::event::leave(std::max(time, windowBegin), *it));
+            }
+            state.stack.clear();
+            state.closed = true;
+        }
+
+        otf2::reader::reader &reader;
+        otf2::writer::archive &archive;
+        const TraceExportOptions &options;
+
+        /**
+         * States of the locations by location reference
+         */
+        std::map<uint64_t, LocationState> states;
+
+        bool windowKnown = false;
+        otf2::chrono::time_point programEnd = otf2::chrono::time_point::max();
+        otf2::chrono::time_point windowBegin{};
+        otf2::chrono::time_point windowEnd = otf2::chrono::time_point::max();
+        uint64_t written = 0;
+    };
+}
+
+TraceExporter::TraceExporter(std::string sourcePath, TraceExportOptions options) :
+    sourcePath(std::move(sourcePath)), options(std::move(options)) {
+}
+
+uint64_t TraceExporter::write(const std::string &directory, const std::string &name) {
+    SelfTracer::Scope scope("export");
+    otf2::reader::reader reader(sourcePath);
+    otf2::writer::archive archive(directory, name);
+    ExportCallbacks callbacks(reader, archive, options);
+
+    reader.set_callback(callbacks);
+    reader.read_definitions();
+    reader.read_events();
+    return callbacks.writtenEvents();
+}
@@ -0,0 +1,81 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_TRACEEXPORTER_HPP
+#define MOTIV_TRACEEXPORTER_HPP
+
+
+#include <cstdint>
+#include <set>
+#include <string>
+
+#include "src/types.hpp"
+
+/**
+ * @brief Parts of a trace written by the TraceExporter
+ */
+struct TraceExportOptions {
+    /**
+     * Start of the exported time window relative to the program start
+     */
+    types::TraceTime begin{0};
+    /**
+     * End of the exported time window relative to the program start
+     */
+    types::TraceTime end = types::TraceTime::max();
+    /**
+     * References of the location groups whose events are exported, all if empty
+     */
+    std::set<uint64_t> ranks;
+};
+
+/**
+ * @brief Writes a time window and a subset of the ranks of an OTF2 archive to a new archive
+ *
+ * The source archive is read again and every event is written as soon as it is read, so the events are never held in
+ * memory. All definitions are copied. Calls crossing the borders of the window are cut off: calls active at its start
+ * are entered at the start and calls active at its end are left at the end. The program begins at the start of the
+ * window, so times in the exported trace are relative to it.
+ *
+ * Messages whose peer is not exported or whose matching event lies outside of the window remain unmatched.
+ */
+class TraceExporter {
+public:
+    /**
+     * @brief Creates a new instance of the TraceExporter class
+     * @param sourcePath Path of the anchor file of the archive to export from
+     * @param options The parts of the trace to export
+     */
+    TraceExporter(std::string sourcePath, TraceExportOptions options);
+
+    /**
+     * @brief Writes the archive
+     *
+     * Blocks until the whole source archive is read, may be run in a background thread.
+     * @param directory Directory the archive is created in
+     * @param name Name of the archive, the anchor file is named @c name.otf2
+     * @return Number of written events
+     */
+    uint64_t write(const std::string &directory, const std::string &name);
+
+private:
+    std::string sourcePath;
+    TraceExportOptions options;
+};
+
+
+#endif //MOTIV_TRACEEXPORTER_HPP
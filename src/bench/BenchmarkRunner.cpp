@@ -0,0 +1,92 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "BenchmarkRunner.hpp"
+
+#include <QJsonArray>
+#include <algorithm>
+
+BenchmarkRunner::BenchmarkRunner(std::chrono::milliseconds minTime, size_t minIterations, QRegularExpression filter)
+    : minTime(minTime), minIterations(minIterations), filter(std::move(filter)) {}
+
+void BenchmarkRunner::run(const std::string &name, const std::function<void()> &fn,
+                          const std::function<void()> &setup, const std::function<void()> &teardown) {
+    if (!filter.match(QString::fromStdString(name)).hasMatch()) return;
+
+    std::vector<std::chrono::nanoseconds> timings;
+    std::chrono::nanoseconds total{0};
+    while (timings.size() < minIterations || total < minTime) {
+        if (setup) setup();
+
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto duration = std::chrono::steady_clock::now() - start;
+
+        if (teardown) teardown();
+
+        timings.emplace_back(duration);
+        total += duration;
+    }
+
+    std::sort(timings.begin(), timings.end());
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = timings.size();
+    result.min = timings.front();
+    result.median = timings[timings.size() / 2];
+    result.mean = total / timings.size();
+    result.max = timings.back();
+    results.push_back(result);
+}
+
+void BenchmarkRunner::addContext(const QString &key, const QJsonValue &value) {
+    context.insert(key, value);
+}
+
+QJsonObject BenchmarkRunner::toJson() const {
+    QJsonArray benchmarks;
+    for (const auto &result: results) {
+        QJsonObject benchmark;
+        benchmark.insert("name", QString::fromStdString(result.name));
+        benchmark.insert("iterations", static_cast<qint64>(result.iterations));
+        benchmark.insert("min_ns", static_cast<qint64>(result.min.count()));
+        benchmark.insert("median_ns", static_cast<qint64>(result.median.count()));
+        benchmark.insert("mean_ns", static_cast<qint64>(result.mean.count()));
+        benchmark.insert("max_ns", static_cast<qint64>(result.max.count()));
+        benchmarks.append(benchmark);
+    }
+
+    QJsonObject json;
+    json.insert("context", context);
+    json.insert("benchmarks", benchmarks);
+    return json;
+}
+
+void BenchmarkRunner::print(QTextStream &stream) const {
+    auto ms = [](std::chrono::nanoseconds duration) {
+        return QString::number(static_cast<double>(duration.count()) / 1e6, 'f', 3);
+    };
+
+    stream << qSetFieldWidth(40) << Qt::left << "benchmark" << qSetFieldWidth(12) << Qt::right
+           << "iterations" << "min ms" << "median ms" << "mean ms" << "max ms" << qSetFieldWidth(0) << Qt::endl;
+    for (const auto &result: results) {
+        stream << qSetFieldWidth(40) << Qt::left << QString::fromStdString(result.name) << qSetFieldWidth(12)
+               << Qt::right << result.iterations << ms(result.min) << ms(result.median) << ms(result.mean)
+               << ms(result.max) << qSetFieldWidth(0) << Qt::endl;
+    }
+}
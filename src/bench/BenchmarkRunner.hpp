@@ -0,0 +1,112 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_BENCHMARKRUNNER_HPP
+#define MOTIV_BENCHMARKRUNNER_HPP
+
+
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QTextStream>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Timings of a single benchmark
+ */
+struct BenchmarkResult {
+    /**
+     * Name of the benchmark, parameters are appended separated by slashes, e.g. "subtrace/width=0.01"
+     */
+    std::string name;
+    /**
+     * Number of timed iterations
+     */
+    size_t iterations = 0;
+    std::chrono::nanoseconds min{0};
+    std::chrono::nanoseconds median{0};
+    std::chrono::nanoseconds mean{0};
+    std::chrono::nanoseconds max{0};
+};
+
+/**
+ * @brief Runs benchmarks and collects their timings
+ *
+ * Every benchmark is repeated until it ran for a minimum time and a minimum number of iterations. Setup and teardown
+ * functions run before and after each iteration and are not timed. The results can be exported as JSON which is
+ * understood by compare.py.
+ */
+class BenchmarkRunner {
+public:
+    /**
+     * Creates a new instance
+     * @param minTime Minimum accumulated time of the timed iterations of each benchmark
+     * @param minIterations Minimum number of iterations of each benchmark
+     * @param filter Only benchmarks whose name matches the filter are run
+     */
+    BenchmarkRunner(std::chrono::milliseconds minTime, size_t minIterations, QRegularExpression filter);
+
+    /**
+     * Runs a benchmark
+     * @param name Name of the benchmark
+     * @param fn Function to be timed
+     * @param setup Function run before each iteration
+     * @param teardown Function run after each iteration
+     */
+    void run(const std::string &name, const std::function<void()> &fn,
+             const std::function<void()> &setup = {}, const std::function<void()> &teardown = {});
+
+    /**
+     * Adds information about the environment to the JSON output
+     * @param key Name of the information
+     * @param value Value of the information
+     */
+    void addContext(const QString &key, const QJsonValue &value);
+
+    /**
+     * Exports the context and the results as JSON
+     * @return The JSON representation
+     */
+    [[nodiscard]] QJsonObject toJson() const;
+
+    /**
+     * Prints a human readable table of the results
+     * @param stream The stream to print to
+     */
+    void print(QTextStream &stream) const;
+
+private:
+    std::chrono::milliseconds minTime;
+    size_t minIterations;
+    QRegularExpression filter;
+    QJsonObject context;
+    std::vector<BenchmarkResult> results;
+};
+
+/**
+ * Prevents the compiler from optimizing away a computed value
+ * @param value The value to keep
+ */
+template<typename T>
+inline void doNotOptimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+
+#endif //MOTIV_BENCHMARKRUNNER_HPP
@@ -0,0 +1,42 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoadedTrace.hpp"
+
+LoadedTrace LoadedTrace::load(const std::string &path) {
+    LoadedTrace loaded;
+    loaded.reader = new otf2::reader::reader(path);
+    loaded.callbacks = new ReaderCallbacks(*loaded.reader);
+    loaded.reader->set_callback(*loaded.callbacks);
+    loaded.reader->read_definitions();
+    loaded.reader->read_events();
+
+    auto slots = loaded.callbacks->getSlots();
+    auto communications = loaded.callbacks->getCommunications();
+    auto collectives = loaded.callbacks->getCollectiveCommunications();
+    loaded.trace = new FileTrace(slots, communications, collectives, loaded.callbacks->duration());
+    return loaded;
+}
+
+void LoadedTrace::unload() {
+    delete trace;
+    delete callbacks;
+    delete reader;
+    trace = nullptr;
+    callbacks = nullptr;
+    reader = nullptr;
+}
@@ -0,0 +1,51 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_LOADEDTRACE_HPP
+#define MOTIV_LOADEDTRACE_HPP
+
+
+#include <string>
+
+#include "src/ReaderCallbacks.hpp"
+#include "src/models/Filetrace.hpp"
+
+/**
+ * @brief A trace read into memory
+ *
+ * The reader is kept alive as the trace refers to its definitions.
+ */
+struct LoadedTrace {
+    otf2::reader::reader *reader = nullptr;
+    ReaderCallbacks *callbacks = nullptr;
+    FileTrace *trace = nullptr;
+
+    /**
+     * Reads a trace
+     * @param path Path to the anchor file of the trace
+     * @return The read trace
+     */
+    static LoadedTrace load(const std::string &path);
+
+    /**
+     * Deletes the trace and the reader
+     */
+    void unload();
+};
+
+
+#endif //MOTIV_LOADEDTRACE_HPP
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+#
+# Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+# Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <http://www.gnu.org/licenses/>.
+"""Compares two result files of motiv-bench.
+
+Benchmarks are matched by name and compared by their median. The script exits with status 1 if any benchmark got
+slower than the threshold, so it can gate changes in CI:
+
+    motiv-bench --output baseline.json      # on the base revision
+    motiv-bench --output contender.json     # on the changed revision
+    compare.py baseline.json contender.json --threshold 0.1
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as file:
+        return {benchmark["name"]: benchmark for benchmark in json.load(file)["benchmarks"]}
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="results of the base revision")
+    parser.add_argument("contender", help="results of the changed revision")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slowdown of the median considered a regression (default: 0.1)")
+    parser.add_argument("--metric", default="median_ns", choices=["min_ns", "median_ns", "mean_ns", "max_ns"],
+                        help="timing compared between the runs (default: median_ns)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    contender = load(args.contender)
+
+    regressions = []
+    print(f"{'benchmark':40} {'baseline ms':>12} {'contender ms':>12} {'change':>8}")
+    for name in sorted(baseline.keys() | contender.keys()):
+        if name not in baseline or name not in contender:
+            print(f"{name:40} {'only in ' + ('baseline' if name in baseline else 'contender'):>34}")
+            continue
+
+        old = baseline[name][args.metric]
+        new = contender[name][args.metric]
+        change = (new - old) / old if old else 0
+        marker = ""
+        if change > args.threshold:
+            regressions.append(name)
+            marker = " !"
+        print(f"{name:40} {old / 1e6:12.3f} {new / 1e6:12.3f} {change:+8.1%}{marker}")
+
+    if regressions:
+        print(f"\n{len(regressions)} regression(s) above {args.threshold:.0%}: {', '.join(regressions)}")
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,272 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QVBoxLayout>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <new>
+
+#include "src/bench/LoadedTrace.hpp"
+#include "src/tracegen/TraceGenerator.hpp"
+#include "src/ui/PerformanceMonitor.hpp"
+#include "src/ui/TraceDataProxy.hpp"
+#include "src/ui/views/TraceOverviewTimelineView.hpp"
+#include "src/ui/widgets/Timeline.hpp"
+
+/**
+ * Number of heap allocations made by the process, counted by the replaced global operator new
+ */
+static std::atomic<uint64_t> allocations = 0;
+
+void *operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+/**
+ * Measurements of a single scripted action
+ */
+struct Frame {
+    QString action;
+    qint64 nanoseconds;
+    uint64_t allocations;
+};
+
+static double percentile(std::vector<qint64> values, double p) {
+    if (values.empty()) return 0;
+    std::sort(values.begin(), values.end());
+    auto index = static_cast<size_t>(p * static_cast<double>(values.size() - 1) + .5);
+    return static_cast<double>(values[index]);
+}
+
+int main(int argc, char *argv[]) {
+    // The benchmark is meant for headless machines, an explicitly chosen platform is respected
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+
+    QApplication app(argc, argv);
+    QApplication::setApplicationName("motiv-guibench");
+    QApplication::setApplicationVersion(MOTIV_VERSION_STRING);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays scripted navigation in the MOTIV timeline and reports frame times");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption traceOption("trace", "trace to benchmark, a trace is generated if omitted", "file");
+    QCommandLineOption ranksOption("ranks", "number of ranks of the generated trace", "n", "16");
+    QCommandLineOption durationOption("duration", "length of the generated trace in milliseconds", "ms", "2000");
+    QCommandLineOption callRateOption("call-rate", "call trees per second and thread of the generated trace", "rate",
+                                      "2000");
+    QCommandLineOption repetitionsOption("repetitions", "how often the script is replayed", "n", "3");
+    QCommandLineOption outputOption("output", "write the results as JSON to a file", "file");
+    parser.addOptions({traceOption, ranksOption, durationOption, callRateOption, repetitionsOption, outputOption});
+    parser.process(app);
+
+    QTemporaryDir generatedDir;
+    std::string tracePath;
+    if (parser.isSet(traceOption)) {
+        tracePath = parser.value(traceOption).toStdString();
+    } else {
+        TraceGeneratorOptions options;
+        options.ranks = parser.value(ranksOption).toUInt();
+        options.duration = std::chrono::milliseconds(parser.value(durationOption).toLongLong());
+        options.callRate = parser.value(callRateOption).toDouble();
+        TraceGenerator(options).write(generatedDir.path().toStdString(), "traces");
+        tracePath = generatedDir.filePath("traces.otf2").toStdString();
+    }
+
+    auto loaded = LoadedTrace::load(tracePath);
+    auto settings = new ViewSettings();
+    auto data = new TraceDataProxy(loaded.trace, settings);
+
+    QWidget window;
+    auto layout = new QVBoxLayout(&window);
+    auto overview = new TraceOverviewTimelineView(data->getFullTrace(), nullptr, &window);
+    auto timeline = new Timeline(data, &window);
+    layout->addWidget(overview, 1);
+    layout->addWidget(timeline, 9);
+    window.resize(1920, 1080);
+    window.show();
+
+    // Stage timings are recorded alongside the frame times
+    PerformanceMonitor::getInstance().setEnabled(true);
+
+    std::vector<Frame> frames;
+    auto frame = [&](const QString &name, const std::function<void()> &action) {
+        QElapsedTimer timer;
+        auto allocationsBefore = allocations.load();
+        timer.start();
+
+        action();
+        QApplication::processEvents();
+        // The selection at full resolution is computed in the background
+        while (data->isSelectionComputing()) {
+            QApplication::processEvents(QEventLoop::WaitForMoreEvents, 1);
+        }
+        // Rendering into a pixmap paints all widgets synchronously
+        window.grab();
+
+        frames.push_back({name, timer.nsecsElapsed(), allocations.load() - allocationsBefore});
+    };
+
+    auto runtime = data->getTotalRuntime();
+    auto repetitions = parser.value(repetitionsOption).toInt();
+    for (int repetition = 0; repetition < repetitions; repetition++) {
+        for (int i = 0; i < 10; i++) {
+            frame("zoom_in", [&] {
+                auto quarter = (data->getEnd() - data->getBegin()) / 4;
+                data->setSelection(data->getBegin() + quarter, data->getEnd() - quarter);
+            });
+        }
+        for (int i = 0; i < 10; i++) {
+            frame("pan", [&] {
+                auto step = (data->getEnd() - data->getBegin()) / 4;
+                data->setSelection(data->getBegin() + step, data->getEnd() + step);
+            });
+        }
+        for (auto kinds: {SlotKind::MPI, static_cast<SlotKind>(SlotKind::MPI | SlotKind::OpenMP), FILTER_DEFAULT}) {
+            frame("filter", [&] {
+                Filter filter;
+                filter.setSlotKinds(kinds);
+                data->setFilter(filter);
+            });
+        }
+        for (auto width: {800, 1280, 2560, 1920}) {
+            frame("resize", [&] { window.resize(width, 1080); });
+        }
+        for (int i = 0; i < 10; i++) {
+            frame("zoom_out", [&] {
+                auto half = data->getEnd() - data->getBegin();
+                data->setSelection(data->getBegin() - half, data->getEnd() + half);
+            });
+        }
+        frame("reset", [&] { data->setSelection(types::TraceTime(0), runtime); });
+    }
+
+    // Summarize per action and for all frames
+    QJsonObject actions;
+    QStringList names{"all"};
+    for (const auto &f: frames) {
+        if (!names.contains(f.action)) names.append(f.action);
+    }
+
+    QTextStream out(stdout);
+    out << qSetFieldWidth(10) << Qt::left << "action" << qSetFieldWidth(12) << Qt::right << "frames" << "p50 ms"
+        << "p90 ms" << "p99 ms" << "max ms" << "allocs" << qSetFieldWidth(0) << Qt::endl;
+    for (const auto &name: names) {
+        std::vector<qint64> times;
+        uint64_t allocationSum = 0;
+        for (const auto &f: frames) {
+            if (name != "all" && f.action != name) continue;
+            times.push_back(f.nanoseconds);
+            allocationSum += f.allocations;
+        }
+
+        QJsonObject summary;
+        summary.insert("frames", static_cast<qint64>(times.size()));
+        summary.insert("p50_ns", percentile(times, .5));
+        summary.insert("p90_ns", percentile(times, .9));
+        summary.insert("p99_ns", percentile(times, .99));
+        summary.insert("max_ns", percentile(times, 1));
+        summary.insert("allocations_per_frame", static_cast<double>(allocationSum) / static_cast<double>(times.size()));
+        actions.insert(name, summary);
+
+        out << qSetFieldWidth(10) << Qt::left << name << qSetFieldWidth(12) << Qt::right << times.size()
+            << QString::number(percentile(times, .5) / 1e6, 'f', 2)
+            << QString::number(percentile(times, .9) / 1e6, 'f', 2)
+            << QString::number(percentile(times, .99) / 1e6, 'f', 2)
+            << QString::number(percentile(times, 1) / 1e6, 'f', 2)
+            << allocationSum / times.size() << qSetFieldWidth(0) << Qt::endl;
+    }
+
+    QJsonObject stages;
+    auto history = PerformanceMonitor::getInstance().getHistory();
+    auto meanStage = [&history](auto member) {
+        double sum = 0;
+        for (const auto &sample: history) sum += static_cast<double>((sample.*member).count());
+        return history.empty() ? 0. : sum / static_cast<double>(history.size()) * 1000;
+    };
+    stages.insert("subtrace_mean_ns", meanStage(&PerformanceSample::subtrace));
+    stages.insert("for_resolution_mean_ns", meanStage(&PerformanceSample::forResolution));
+    stages.insert("populate_scene_mean_ns", meanStage(&PerformanceSample::populateScene));
+    stages.insert("paint_mean_ns", meanStage(&PerformanceSample::paint));
+
+    if (parser.isSet(outputOption)) {
+        QJsonObject context;
+        context.insert("trace", QString::fromStdString(tracePath));
+        context.insert("version", MOTIV_VERSION_STRING);
+        context.insert("platform", QApplication::platformName());
+
+        QJsonObject json;
+        json.insert("context", context);
+        json.insert("actions", actions);
+        json.insert("stages", stages);
+
+        QFile file(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly)) {
+            QTextStream(stderr) << "Cannot write " << file.fileName() << Qt::endl;
+            return EXIT_FAILURE;
+        }
+        file.write(QJsonDocument(json).toJson());
+    }
+
+    window.close();
+    delete timeline;
+    delete overview;
+    delete data;
+    delete settings;
+    loaded.trace = nullptr;
+    loaded.unload();
+
+    return EXIT_SUCCESS;
+}
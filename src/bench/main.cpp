@@ -0,0 +1,189 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+
+#include "src/bench/BenchmarkRunner.hpp"
+#include "src/bench/LoadedTrace.hpp"
+#include "src/models/UITrace.hpp"
+#include "src/tracegen/TraceGenerator.hpp"
+#include "src/utils.hpp"
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("motiv-bench");
+    QCoreApplication::setApplicationVersion(MOTIV_VERSION_STRING);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Microbenchmarks of the MOTIV trace model");
+    parser.addHelpOption();
+    parser.addVersionOption();
+
+    QCommandLineOption traceOption("trace", "trace to benchmark, a trace is generated if omitted", "file");
+    QCommandLineOption ranksOption("ranks", "number of ranks of the generated trace", "n", "16");
+    QCommandLineOption durationOption("duration", "length of the generated trace in milliseconds", "ms", "2000");
+    QCommandLineOption callRateOption("call-rate", "call trees per second and thread of the generated trace", "rate",
+                                      "2000");
+    QCommandLineOption outputOption("output", "write the results as JSON to a file, - for stdout", "file");
+    QCommandLineOption filterOption("filter", "only run benchmarks matching a regular expression", "regex", ".*");
+    QCommandLineOption minTimeOption("min-time", "minimum time each benchmark runs", "ms", "500");
+    QCommandLineOption minIterationsOption("min-iterations", "minimum iterations of each benchmark", "n", "5");
+    parser.addOptions({traceOption, ranksOption, durationOption, callRateOption, outputOption, filterOption,
+                       minTimeOption, minIterationsOption});
+    parser.process(app);
+
+    QTemporaryDir generatedDir;
+    std::string tracePath;
+    if (parser.isSet(traceOption)) {
+        tracePath = parser.value(traceOption).toStdString();
+    } else {
+        TraceGeneratorOptions options;
+        options.ranks = parser.value(ranksOption).toUInt();
+        options.duration = std::chrono::milliseconds(parser.value(durationOption).toLongLong());
+        options.callRate = parser.value(callRateOption).toDouble();
+        TraceGenerator(options).write(generatedDir.path().toStdString(), "traces");
+        tracePath = generatedDir.filePath("traces.otf2").toStdString();
+    }
+
+    BenchmarkRunner runner(std::chrono::milliseconds(parser.value(minTimeOption).toLongLong()),
+                           parser.value(minIterationsOption).toULongLong(),
+                           QRegularExpression(parser.value(filterOption)));
+    runner.addContext("trace", QString::fromStdString(tracePath));
+    runner.addContext("date", QDateTime::currentDateTime().toString(Qt::ISODate));
+    runner.addContext("version", MOTIV_VERSION_STRING);
+
+    // Reading events through the ReaderCallbacks, definitions are read beforehand
+    {
+        LoadedTrace loaded;
+        runner.run("read_events", [&] { loaded.reader->read_events(); }, [&] {
+            loaded.reader = new otf2::reader::reader(tracePath);
+            loaded.callbacks = new ReaderCallbacks(*loaded.reader);
+            loaded.reader->set_callback(*loaded.callbacks);
+            loaded.reader->read_definitions();
+        }, [&] {
+            // The FileTrace takes care of deleting the read elements
+            auto slots = loaded.callbacks->getSlots();
+            auto communications = loaded.callbacks->getCommunications();
+            auto collectives = loaded.callbacks->getCollectiveCommunications();
+            loaded.trace = new FileTrace(slots, communications, collectives, loaded.callbacks->duration());
+            loaded.unload();
+        });
+    }
+
+    auto loaded = LoadedTrace::load(tracePath);
+    auto trace = loaded.trace;
+    auto slots = loaded.callbacks->getSlots();
+    auto communications = loaded.callbacks->getCommunications();
+    auto collectives = loaded.callbacks->getCollectiveCommunications();
+    runner.addContext("slots", static_cast<qint64>(slots.size()));
+    runner.addContext("communications", static_cast<qint64>(communications.size()));
+    runner.addContext("collective_communications", static_cast<qint64>(collectives.size()));
+
+    // A FileTrace deletes the elements it was constructed from, so each instance is built from copies made beforehand
+    std::vector<Slot *> slotCopies;
+    std::vector<Communication *> communicationCopies;
+    std::vector<CollectiveCommunicationEvent *> collectiveCopies;
+    FileTrace *fileTrace = nullptr;
+    runner.run("file_trace", [&] {
+        fileTrace = new FileTrace(slotCopies, communicationCopies, collectiveCopies, trace->getRuntime());
+        doNotOptimize(fileTrace);
+    }, [&] {
+        slotCopies.clear();
+        for (const auto &slot: slots) {
+            slotCopies.push_back(new Slot(*slot));
+        }
+        communicationCopies.clear();
+        for (const auto &communication: communications) {
+            communicationCopies.push_back(new Communication(*communication));
+        }
+        collectiveCopies.clear();
+        for (const auto &collective: collectives) {
+            collectiveCopies.push_back(new CollectiveCommunicationEvent(*collective));
+        }
+    }, [&] {
+        delete fileTrace;
+        fileTrace = nullptr;
+    });
+
+    runner.run("group_by", [&] {
+        auto groups = groupBy<Slot *, uint64_t>(
+            Range(slots),
+            [](const Slot *s) { return s->location->location_group().ref().get(); },
+            [](const Slot *l, const Slot *r) {
+                auto groupL = l->location->location_group().ref();
+                auto groupR = r->location->location_group().ref();
+                if (groupL == groupR) {
+                    return l->startTime < r->startTime;
+                }
+                return groupL < groupR;
+            });
+        doNotOptimize(groups.size());
+    });
+
+    Range<Slot *> slotRange(slots);
+    runner.run("range_copy", [&] {
+        Range<Slot *> copy(slotRange);
+        doNotOptimize(copy.begin());
+    });
+
+    auto runtime = trace->getRuntime();
+    for (auto width: {1., .1, .01, .001}) {
+        auto windowRuntime = std::chrono::duration_cast<types::TraceTime>(runtime * width);
+        auto begin = (runtime - windowRuntime) / 2;
+        auto end = begin + windowRuntime;
+
+        runner.run("subtrace/width=" + QString::number(width).toStdString(), [&] {
+            delete trace->subtrace(begin, end);
+        });
+    }
+
+    ViewSettings settings;
+    for (auto resolution: {480, 1920, 3840, 7680}) {
+        runner.run("for_resolution/px=" + std::to_string(resolution), [&] {
+            delete UITrace::forResolution(trace, runtime / resolution, settings);
+        });
+    }
+
+    loaded.unload();
+
+    // The table goes to stderr if stdout is reserved for JSON
+    auto jsonToStdout = parser.value(outputOption) == "-";
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    runner.print(jsonToStdout ? err : out);
+
+    if (parser.isSet(outputOption)) {
+        auto json = QJsonDocument(runner.toJson()).toJson();
+        if (jsonToStdout) {
+            out << json;
+        } else {
+            QFile file(parser.value(outputOption));
+            if (!file.open(QIODevice::WriteOnly)) {
+                err << "Cannot write " << file.fileName() << Qt::endl;
+                return EXIT_FAILURE;
+            }
+            file.write(json);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
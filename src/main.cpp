@@ -18,13 +18,50 @@
 #include <QApplication>
 #include <QCommandLineParser>
 #include <QFile>
+#include <QFileInfo>
 #include <QIODeviceBase>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
 
+#include "src/SelfTracer.hpp"
+#include "src/models/MemoryAccounting.hpp"
 #include "src/ui/windows/MainWindow.hpp"
 #include "src/ui/windows/RecentFilesDialog.hpp"
 
+/**
+ * Loads a trace without showing a window and prints the memory used per category as TSV
+ */
+static int printMemoryReport(const QString &filepath, const LoadOptions &options) {
+    otf2::reader::reader reader(filepath.toStdString());
+    ReaderCallbacks callbacks(reader, options);
+    reader.set_callback(callbacks);
+    reader.read_definitions();
+    reader.read_events();
+
+    auto summary = callbacks.takeSummary();
+    auto slots = summary ? summary->createSlots() : callbacks.getSlots();
+    auto communications = callbacks.getCommunications();
+    auto collectives = callbacks.getCollectiveCommunications();
+    ViewSettings settings;
+    {
+        TraceDataProxy data(new FileTrace(slots, communications, collectives, callbacks.duration()), &settings);
+        data.setSummary(summary);
+        data.setCallingContextTree(callbacks.takeCallingContextTree());
+        std::cout << MemoryAccounting::getInstance().report().toTsv();
+    }
+    return EXIT_SUCCESS;
+}
+
 int main(int argc, char *argv[])
 {
+    // The memory report does not show a window and should work on nodes without a display
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--memory-report") == 0 && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM")) {
+            qputenv("QT_QPA_PLATFORM", "offscreen");
+        }
+    }
+
     QApplication app(argc, argv);
     QApplication::setApplicationName("Motiv");
     QApplication::setApplicationVersion(MOTIV_VERSION_STRING);
@@ -43,6 +80,20 @@ int main(int argc, char *argv[])
 
     QCommandLineOption helpOption = parser.addHelpOption();
     QCommandLineOption versionOption = parser.addVersionOption();
+    QCommandLineOption selfTraceOption("self-trace", QCoreApplication::translate("main", "record the phases of Motiv as Chrome trace JSON to <file>"), "file");
+    parser.addOption(selfTraceOption);
+    QCommandLineOption memoryReportOption("memory-report", QCoreApplication::translate("main", "print the memory used per category for [file] as TSV and exit"));
+    parser.addOption(memoryReportOption);
+    QCommandLineOption regionFilterOption("region-filter", QCoreApplication::translate("main", "skip the regions excluded by the Score-P filter <file> while reading"), "file");
+    parser.addOption(regionFilterOption);
+    QCommandLineOption excludeRegionsOption("exclude-regions", QCoreApplication::translate("main", "skip the regions matching one of the comma separated wildcard <patterns> while reading"), "patterns");
+    parser.addOption(excludeRegionsOption);
+    QCommandLineOption summaryOption("summary", QCoreApplication::translate("main", "only keep a summary of the events at the resolution of the overview, for very large traces"));
+    parser.addOption(summaryOption);
+    QCommandLineOption windowOption("window", QCoreApplication::translate("main", "only keep the elements within <begin:end>, given in nanoseconds since the program start"), "begin:end");
+    parser.addOption(windowOption);
+    QCommandLineOption rankStrideOption("rank-stride", QCoreApplication::translate("main", "only read the locations of every <n>-th rank"), "n");
+    parser.addOption(rankStrideOption);
     parser.addPositionalArgument("file", QCoreApplication::translate("main", "filepath of the .otf2 trace file to open"), "[file]");
     parser.process(app);
 
@@ -51,20 +102,78 @@ int main(int argc, char *argv[])
         return EXIT_SUCCESS;
     }
 
+    if (parser.isSet(selfTraceOption)) {
+        SelfTracer::getInstance().start(parser.value(selfTraceOption).toStdString());
+    }
+
     QStringList positionalArguments = parser.positionalArguments();
     QString filepath;
     if (!positionalArguments.isEmpty()) {
         filepath = positionalArguments.first();
     }
 
+    LoadOptions loadOptions;
+    try {
+        if (parser.isSet(regionFilterOption)) {
+            // The path is kept absolute so that it can be passed on to new windows
+            loadOptions.regionFilterFile = QFileInfo(parser.value(regionFilterOption)).absoluteFilePath();
+            loadOptions.regionFilter = RegionFilter::fromFile(loadOptions.regionFilterFile);
+        }
+    } catch (const std::invalid_argument &e) {
+        qCritical("Invalid region filter: %s", e.what());
+        return EXIT_FAILURE;
+    }
+    if (parser.isSet(excludeRegionsOption)) {
+        loadOptions.excludedRegions = parser.value(excludeRegionsOption).split(',', Qt::SkipEmptyParts);
+        loadOptions.regionFilter.exclude(loadOptions.excludedRegions);
+    }
+    loadOptions.summaryOnly = parser.isSet(summaryOption);
+    if (parser.isSet(windowOption)) {
+        auto bounds = parser.value(windowOption).split(':');
+        bool beginValid = false;
+        bool endValid = false;
+        if (bounds.size() == 2) {
+            loadOptions.windowBegin = types::TraceTime(bounds[0].toLongLong(&beginValid));
+            loadOptions.windowEnd = types::TraceTime(bounds[1].toLongLong(&endValid));
+        }
+        if (!beginValid || !endValid || loadOptions.windowEnd < loadOptions.windowBegin) {
+            qCritical("--window expects <begin:end> in nanoseconds");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (parser.isSet(rankStrideOption)) {
+        bool strideValid = false;
+        loadOptions.rankStride = parser.value(rankStrideOption).toULongLong(&strideValid);
+        if (!strideValid || loadOptions.rankStride == 0) {
+            qCritical("--rank-stride expects a positive number");
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (parser.isSet(memoryReportOption)) {
+        if (filepath.isEmpty()) {
+            qCritical("--memory-report requires a trace file");
+            return EXIT_FAILURE;
+        }
+        auto result = printMemoryReport(filepath, loadOptions);
+        SelfTracer::getInstance().stop();
+        return result;
+    }
+
     RecentFilesDialog recentFilesDialog(&filepath);
     if(!filepath.isEmpty() || recentFilesDialog.exec() == QDialog::Accepted) {
-        auto mainWindow = new MainWindow(filepath);
-        mainWindow->show();
+        // The window shows itself once the trace has been read
+        new MainWindow(filepath, loadOptions);
     } else {
         app.quit();
+        SelfTracer::getInstance().stop();
         return EXIT_SUCCESS;
     }
 
-    return app.exec();
+    auto result = app.exec();
+    if (!SelfTracer::getInstance().stop()) {
+        qWarning("Could not write the self trace");
+    }
+    return result;
 }
@@ -23,6 +23,7 @@
 
 AppSettings::AppSettings() {
     this->recentlyOpenedFiles_ = this->settings.value("recentlyOpenedFiles").toStringList();
+    this->memoryBudget_ = this->settings.value("memoryBudget", DEFAULT_MEMORY_BUDGET_MB).toULongLong();
 }
 
 const QStringList &AppSettings::recentlyOpenedFiles() const {
@@ -45,3 +46,12 @@ void AppSettings::recentlyOpenedFilesClear() {
     this->recentlyOpenedFiles_.clear();
     SET_AND_EMIT(recentlyOpenedFiles)
 }
+
+qulonglong AppSettings::memoryBudget() const {
+    return memoryBudget_;
+}
+
+void AppSettings::memoryBudgetSet(qulonglong newBudget) {
+    memoryBudget_ = newBudget;
+    SET_AND_EMIT(memoryBudget)
+}
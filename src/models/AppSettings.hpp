@@ -21,6 +21,11 @@
 
 #include <QSettings>
 
+/**
+ * Default budget of all caches in MiB
+ */
+#define DEFAULT_MEMORY_BUDGET_MB 4096
+
 /**
  * @brief Singleton holding persistent information
  */
@@ -74,16 +79,37 @@ public:
      */
     void recentlyOpenedFilesClear();
 
+    /**
+     * @brief Returns the budget all caches have to share
+     * @return The budget in MiB
+     */
+    [[nodiscard]] qulonglong memoryBudget() const;
+
+    /**
+     * @brief Sets the budget all caches have to share
+     *
+     * The budget is saved. It is not applied to the running MemoryBudget.
+     *
+     * @param newBudget The new budget in MiB
+     */
+    void memoryBudgetSet(qulonglong newBudget);
+
 public: Q_SIGNALS:
     /**
      * @brief Signals a change in the recently opened files
      */
     void recentlyOpenedFilesChanged(QStringList);
 
+    /**
+     * @brief Signals a change in the memory budget
+     */
+    void memoryBudgetChanged(qulonglong);
+
 private:
     QSettings settings;
     QString leastRecentDirectory_;
     QStringList recentlyOpenedFiles_;
+    qulonglong memoryBudget_;
 };
 
 
@@ -0,0 +1,83 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CallingContextTree.hpp"
+
+CallingContextTree::CallingContextTree() : nodes(1) {
+}
+
+CallingContextTree::~CallingContextTree() {
+    for (const auto &node: nodes) {
+        delete node.region;
+    }
+}
+
+size_t CallingContextTree::enter(size_t parent, const otf2::definition::region &region) {
+    auto ref = region.ref().get();
+    auto it = nodes[parent].children.find(ref);
+    if (it != nodes[parent].children.end()) {
+        return it->second;
+    }
+
+    auto index = nodes.size();
+    Node node;
+    // Slots own their region copies and may be dropped while loading, so the tree needs its own
+    node.region = new otf2::definition::region(region);
+    node.parent = parent;
+    node.depth = parent == ROOT ? 0 : nodes[parent].depth + 1;
+    nodes.push_back(node);
+    nodes[parent].children.insert({ref, index});
+    return index;
+}
+
+void CallingContextTree::leave(size_t node, types::TraceTime duration) {
+    nodes[node].visits++;
+    nodes[node].inclusive += duration;
+}
+
+types::TraceTime CallingContextTree::exclusive(size_t node) const {
+    auto time = nodes[node].inclusive;
+    for (const auto &[ref, child]: nodes[node].children) {
+        time -= nodes[child].inclusive;
+    }
+    return time;
+}
+
+const std::vector<CallingContextTree::Node> &CallingContextTree::getNodes() const {
+    return nodes;
+}
+
+std::string CallingContextTree::pathName(size_t node, const std::string &separator) const {
+    std::vector<size_t> path;
+    for (; node != ROOT; node = nodes[node].parent) {
+        path.push_back(node);
+    }
+
+    std::string name;
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        if (!name.empty()) name += separator;
+        name += nodes[*it].region->name().str();
+    }
+    return name;
+}
+
+size_t CallingContextTree::memoryUsage() const {
+    // Every node but the root is the child of another node and has its own region copy
+    auto bytes = sizeof(CallingContextTree) + nodes.capacity() * sizeof(Node);
+    auto children = nodes.size() - 1;
+    return bytes + children * (sizeof(std::map<uint64_t, size_t>::node_type) + sizeof(otf2::definition::region));
+}
@@ -0,0 +1,123 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_CALLINGCONTEXTTREE_HPP
+#define MOTIV_CALLINGCONTEXTTREE_HPP
+
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <otf2xx/otf2.hpp>
+#include "src/types.hpp"
+
+/**
+ * @brief Calling context tree of a trace
+ *
+ * Every node stands for a call path, i.e. a region together with the regions calling it. Calls of the same region on
+ * the same call path share a node, which sums their visits and times over all locations. The root node has no region.
+ * Slots store the index of their node, so analyses can aggregate them by call path.
+ */
+class CallingContextTree {
+public:
+    /**
+     * @brief A call path of the tree
+     */
+    struct Node {
+        /**
+         * Copy of the region of the node owned by the tree, nullptr for the root
+         */
+        otf2::definition::region *region = nullptr;
+        size_t parent = 0;
+        /**
+         * Call depth of the region, regions called from the root have depth 0
+         */
+        uint32_t depth = 0;
+        uint64_t visits = 0;
+        /**
+         * Time spent in the region including its callees
+         */
+        types::TraceTime inclusive{0};
+        /**
+         * Child nodes by region reference
+         */
+        std::map<uint64_t, size_t> children;
+    };
+
+    /**
+     * @brief Index of the root node
+     */
+    static constexpr size_t ROOT = 0;
+
+    /**
+     * @brief Creates a tree only containing the root
+     */
+    CallingContextTree();
+    CallingContextTree(const CallingContextTree &) = delete;
+    CallingContextTree &operator=(const CallingContextTree &) = delete;
+    ~CallingContextTree();
+
+    /**
+     * @brief Returns the node of a region called from a node, the node is created if it does not exist yet
+     * @param parent The calling node
+     * @param region The called region, the tree keeps its own copy
+     * @return Index of the node
+     */
+    size_t enter(size_t parent, const otf2::definition::region &region);
+
+    /**
+     * @brief Records a completed visit of a node
+     * @param node Index of the node
+     * @param duration Duration of the visit
+     */
+    void leave(size_t node, types::TraceTime duration);
+
+    /**
+     * @brief Returns the time spent in a node excluding its callees
+     * @param node Index of the node
+     * @return The exclusive time
+     */
+    [[nodiscard]] types::TraceTime exclusive(size_t node) const;
+
+    /**
+     * @brief Returns all nodes, parents are stored before their children
+     * @return The nodes of the tree
+     */
+    [[nodiscard]] const std::vector<Node> &getNodes() const;
+
+    /**
+     * @brief Returns the names of the regions on the call path of a node, starting with the outermost one
+     * @param node Index of the node
+     * @param separator Separator put between the names
+     * @return The call path, empty for the root
+     */
+    [[nodiscard]] std::string pathName(size_t node, const std::string &separator) const;
+
+    /**
+     * @brief Returns the bytes used by the tree
+     * @return The used bytes
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    std::vector<Node> nodes;
+};
+
+
+#endif //MOTIV_CALLINGCONTEXTTREE_HPP
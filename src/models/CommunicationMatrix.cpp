@@ -0,0 +1,123 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CommunicationMatrix.hpp"
+
+#include <algorithm>
+#include <map>
+
+void CommunicationMatrixCell::add(const CommunicationMatrixCell &other) {
+    messages += other.messages;
+    bytes += other.bytes;
+    transferTime += other.transferTime;
+}
+
+CommunicationMatrix::CommunicationMatrix(Trace *trace) {
+    std::map<uint64_t, uint32_t> rankIndices;
+    for (const auto &[group, slots]: trace->getSlots()) {
+        rankIndices.emplace(group->ref().get(), static_cast<uint32_t>(ranks.size()));
+        ranks.push_back(group);
+    }
+
+    for (const auto &communication: trace->getCommunications()) {
+        auto send = communication->getSendEvent();
+        auto receive = communication->getReceiveEvent();
+        auto sender = rankIndices.find(send->getLocation()->location_group().ref().get());
+        auto receiver = rankIndices.find(receive->getLocation()->location_group().ref().get());
+        if (sender == rankIndices.end() || receiver == rankIndices.end()) continue;
+
+        entries.push_back({
+            communication->getStartTime().count(), sender->second, receiver->second,
+            communication->getMessageLength(), communication->getEndTime() - communication->getStartTime()
+        });
+    }
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry &lhs, const Entry &rhs) {
+        return lhs.start < rhs.start;
+    });
+}
+
+void CommunicationMatrix::setWindow(types::TraceTime from, types::TraceTime to) {
+    auto byStart = [](const Entry &entry, types::TraceTime::rep time) { return entry.start < time; };
+    auto newBegin = static_cast<size_t>(std::lower_bound(entries.begin(), entries.end(), from.count(), byStart) -
+                                        entries.begin());
+    auto newEnd = static_cast<size_t>(std::lower_bound(entries.begin(), entries.end(), to.count(), byStart) -
+                                      entries.begin());
+    newEnd = std::max(newBegin, newEnd);
+
+    // Moving the borders costs the communications passed by them, rebuilding costs the new window
+    auto moveCost = std::max(newBegin, windowBegin) - std::min(newBegin, windowBegin) +
+                    std::max(newEnd, windowEnd) - std::min(newEnd, windowEnd);
+    if (newBegin >= windowEnd || newEnd <= windowBegin || moveCost > newEnd - newBegin) {
+        cells.clear();
+        for (auto i = newBegin; i < newEnd; i++) apply(entries[i], true);
+    } else {
+        for (auto i = newBegin; i < windowBegin; i++) apply(entries[i], true);
+        for (auto i = windowBegin; i < newBegin; i++) apply(entries[i], false);
+        for (auto i = windowEnd; i < newEnd; i++) apply(entries[i], true);
+        for (auto i = newEnd; i < windowEnd; i++) apply(entries[i], false);
+    }
+    windowBegin = newBegin;
+    windowEnd = newEnd;
+}
+
+const std::vector<otf2::definition::location_group *> &CommunicationMatrix::getRanks() const {
+    return ranks;
+}
+
+CommunicationMatrixCell CommunicationMatrix::get(size_t sender, size_t receiver) const {
+    auto it = cells.find(key(sender, receiver));
+    return it != cells.end() ? it->second : CommunicationMatrixCell();
+}
+
+size_t CommunicationMatrix::windowSize() const {
+    return windowEnd - windowBegin;
+}
+
+size_t CommunicationMatrix::blocksPerAxis(size_t blockSize) const {
+    return (ranks.size() + blockSize - 1) / blockSize;
+}
+
+std::vector<CommunicationMatrixCell> CommunicationMatrix::aggregate(size_t blockSize) const {
+    auto blocks = blocksPerAxis(blockSize);
+    std::vector<CommunicationMatrixCell> result(blocks * blocks);
+    for (const auto &[cellKey, cell]: cells) {
+        auto sender = cellKey / ranks.size();
+        auto receiver = cellKey % ranks.size();
+        result[sender / blockSize * blocks + receiver / blockSize].add(cell);
+    }
+    return result;
+}
+
+void CommunicationMatrix::apply(const CommunicationMatrix::Entry &entry, bool add) {
+    auto &cell = cells[key(entry.sender, entry.receiver)];
+    if (add) {
+        cell.messages++;
+        cell.bytes += entry.bytes;
+        cell.transferTime += entry.transferTime;
+    } else {
+        cell.messages--;
+        cell.bytes -= entry.bytes;
+        cell.transferTime -= entry.transferTime;
+        if (cell.messages == 0) {
+            cells.erase(key(entry.sender, entry.receiver));
+        }
+    }
+}
+
+uint64_t CommunicationMatrix::key(size_t sender, size_t receiver) const {
+    return static_cast<uint64_t>(sender) * ranks.size() + receiver;
+}
@@ -0,0 +1,125 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_COMMUNICATIONMATRIX_HPP
+#define MOTIV_COMMUNICATIONMATRIX_HPP
+
+
+#include <unordered_map>
+#include <vector>
+
+#include "Trace.hpp"
+
+/**
+ * @brief Messages, bytes and transfer time between a sender and a receiver or between blocks of them
+ */
+struct CommunicationMatrixCell {
+    uint64_t messages = 0;
+    uint64_t bytes = 0;
+    types::TraceTime transferTime{0};
+
+    /**
+     * @brief Adds the values of another cell
+     * @param other The other cell
+     */
+    void add(const CommunicationMatrixCell &other);
+};
+
+/**
+ * @brief Sender × receiver matrix of the point to point communications started in a time window
+ *
+ * Only the cells of rank pairs that communicate are stored, so even traces with many thousand ranks fit. Moving the
+ * window only adds the communications entering it and removes the ones leaving it, unless rebuilding the window is
+ * cheaper. For display the matrix is aggregated into square blocks of ranks.
+ */
+class CommunicationMatrix {
+public:
+    /**
+     * @brief Prepares the matrix of a trace, the window is initially empty
+     * @param trace The trace
+     */
+    explicit CommunicationMatrix(Trace *trace);
+
+    /**
+     * @brief Sets the time window, communications starting in [from, to) are counted
+     * @param from Start of the window
+     * @param to End of the window
+     */
+    void setWindow(types::TraceTime from, types::TraceTime to);
+
+    /**
+     * @brief Returns the ranks in the order of the rows and columns
+     * @return The ranks
+     */
+    [[nodiscard]] const std::vector<otf2::definition::location_group *> &getRanks() const;
+
+    /**
+     * @brief Returns the communication from one rank to another in the current window
+     * @param sender Index of the sending rank
+     * @param receiver Index of the receiving rank
+     * @return The cell of the rank pair
+     */
+    [[nodiscard]] CommunicationMatrixCell get(size_t sender, size_t receiver) const;
+
+    /**
+     * @brief Returns the number of communications in the current window
+     * @return The number of communications
+     */
+    [[nodiscard]] size_t windowSize() const;
+
+    /**
+     * @brief Sums the cells of blocks of blockSize × blockSize ranks
+     * @param blockSize Number of ranks per block along each axis
+     * @return Row-major blocks, blocksPerAxis(blockSize) per row
+     */
+    [[nodiscard]] std::vector<CommunicationMatrixCell> aggregate(size_t blockSize) const;
+
+    /**
+     * @brief Returns the number of blocks along each axis
+     * @param blockSize Number of ranks per block along each axis
+     * @return The number of blocks
+     */
+    [[nodiscard]] size_t blocksPerAxis(size_t blockSize) const;
+
+private:
+    struct Entry {
+        types::TraceTime::rep start;
+        uint32_t sender;
+        uint32_t receiver;
+        uint64_t bytes;
+        types::TraceTime transferTime;
+    };
+
+    void apply(const Entry &entry, bool add);
+    [[nodiscard]] uint64_t key(size_t sender, size_t receiver) const;
+
+private:
+    std::vector<otf2::definition::location_group *> ranks;
+    /**
+     * All communications ordered by start
+     */
+    std::vector<Entry> entries;
+    std::unordered_map<uint64_t, CommunicationMatrixCell> cells;
+    /**
+     * The communications entries[windowBegin, windowEnd) are counted in cells
+     */
+    size_t windowBegin = 0;
+    size_t windowEnd = 0;
+};
+
+
+#endif //MOTIV_COMMUNICATIONMATRIX_HPP
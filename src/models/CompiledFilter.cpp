@@ -0,0 +1,111 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CompiledFilter.hpp"
+
+#include <QRegularExpression>
+
+static QRegularExpression compilePattern(const std::string &pattern, FilterPatternSyntax syntax) {
+    auto qPattern = QString::fromStdString(pattern);
+    if (syntax == FilterPatternSyntax::Glob) {
+        qPattern = QRegularExpression::wildcardToRegularExpression(qPattern);
+    }
+    return QRegularExpression(qPattern, QRegularExpression::CaseInsensitiveOption);
+}
+
+static std::vector<bool> toBitset(const std::set<uint64_t> &refs) {
+    std::vector<bool> bitset;
+    if (refs.empty()) return bitset;
+
+    bitset.resize(*refs.rbegin() + 1);
+    for (const auto &ref: refs) {
+        bitset[ref] = true;
+    }
+    return bitset;
+}
+
+CompiledFilter::CompiledFilter(const Filter &filter, Trace *trace) :
+    ranks(toBitset(filter.getRanks())),
+    communicators(toBitset(filter.getCommunicators())),
+    minDuration(filter.getMinDuration()) {
+    // An invalid pattern is ignored rather than hiding everything
+    auto matchAll = filter.getRegionPattern().empty() ||
+                    !isValidPattern(filter.getRegionPattern(), filter.getRegionPatternSyntax());
+    auto pattern = compilePattern(filter.getRegionPattern(), filter.getRegionPatternSyntax());
+    pattern.optimize();
+
+    // Every region is evaluated once, when it is first encountered
+    std::vector<bool> evaluated;
+    auto allRegions = true;
+    for (const auto &[group, slots]: trace->getSlots()) {
+        for (const auto &slot: slots) {
+            auto ref = slot->region->ref().get();
+            if (ref >= evaluated.size()) {
+                evaluated.resize(ref + 1);
+                regions.resize(ref + 1);
+            }
+            if (evaluated[ref]) continue;
+
+            evaluated[ref] = true;
+            auto passes = (slot->getKind() & filter.getSlotKinds()) &&
+                          (matchAll || pattern.match(QString::fromStdString(slot->region->name().str())).hasMatch());
+            regions[ref] = passes;
+            allRegions = allRegions && passes;
+        }
+    }
+
+    trivial = allRegions && ranks.empty() && communicators.empty() && minDuration.count() == 0;
+}
+
+bool CompiledFilter::isTrivial() const {
+    return trivial;
+}
+
+bool CompiledFilter::accepts(const otf2::definition::location_group *rank) const {
+    return acceptsRank(rank->ref().get());
+}
+
+bool CompiledFilter::accepts(const Communication *communication) const {
+    auto startEvent = communication->getStartEvent();
+    auto endEvent = communication->getEndEvent();
+    return acceptsRank(startEvent->getLocation()->location_group().ref().get()) &&
+           acceptsRank(endEvent->getLocation()->location_group().ref().get()) &&
+           acceptsCommunicator(startEvent->getCommunicator());
+}
+
+bool CompiledFilter::accepts(const CollectiveCommunicationEvent *event) const {
+    return acceptsCommunicator(event->getCommunicator());
+}
+
+bool CompiledFilter::acceptsRank(uint64_t ref) const {
+    return ranks.empty() || (ref < ranks.size() && ranks[ref]);
+}
+
+bool CompiledFilter::acceptsCommunicator(const types::communicator *communicator) const {
+    if (communicators.empty()) return true;
+
+    // Inter communicators cannot be selected in the filter and always pass
+    auto comm = std::get_if<otf2::definition::comm>(communicator);
+    if (!comm) return true;
+
+    auto ref = comm->ref().get();
+    return ref < communicators.size() && communicators[ref];
+}
+
+bool CompiledFilter::isValidPattern(const std::string &pattern, FilterPatternSyntax syntax) {
+    return compilePattern(pattern, syntax).isValid();
+}
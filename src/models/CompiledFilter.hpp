@@ -0,0 +1,128 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_COMPILEDFILTER_HPP
+#define MOTIV_COMPILEDFILTER_HPP
+
+
+#include <vector>
+
+#include "Filter.hpp"
+#include "Trace.hpp"
+
+/**
+ * @brief A Filter evaluated against the definitions of a trace
+ *
+ * Slot kinds and region name patterns are evaluated once per region, ranks and communicators are looked up by their
+ * reference. Checking an element then only costs a few bit lookups, which allows applying the filter while the level
+ * of detail is computed instead of while drawing.
+ */
+class CompiledFilter {
+public:
+    /**
+     * @brief Compiles a filter for the regions, ranks and communicators of a trace
+     * @param filter The filter
+     * @param trace The trace whose elements are going to be filtered
+     */
+    CompiledFilter(const Filter &filter, Trace *trace);
+
+    /**
+     * @brief Returns whether the filter lets all elements pass
+     * @return True if no element is filtered out
+     */
+    [[nodiscard]] bool isTrivial() const;
+
+    /**
+     * @brief Returns whether the slots of a rank should be rendered
+     * @param rank The location group of the rank
+     * @return True if the rank passes the filter
+     */
+    [[nodiscard]] bool accepts(const otf2::definition::location_group *rank) const;
+
+    /**
+     * @brief Returns whether a slot should be rendered
+     *
+     * The rank of the slot is not checked, use accepts(const otf2::definition::location_group *) once per rank.
+     * @param slot The slot
+     * @return True if the slot passes the filter
+     */
+    [[nodiscard]] bool accepts(const Slot *slot) const {
+        auto region = slot->region->ref().get();
+        return region < regions.size() && regions[region] && slot->endTime - slot->startTime >= minDuration;
+    }
+
+    /**
+     * @brief Returns whether a communication should be rendered
+     * @param communication The communication
+     * @return True if both ranks and the communicator pass the filter
+     */
+    [[nodiscard]] bool accepts(const Communication *communication) const;
+
+    /**
+     * @brief Returns whether a collective communication should be rendered
+     * @param event The collective communication
+     * @return True if the communicator passes the filter
+     */
+    [[nodiscard]] bool accepts(const CollectiveCommunicationEvent *event) const;
+
+    /**
+     * @brief Returns whether a pattern can be compiled
+     * @param pattern The pattern
+     * @param syntax The syntax of the pattern
+     * @return True if the pattern is valid
+     */
+    static bool isValidPattern(const std::string &pattern, FilterPatternSyntax syntax);
+
+private:
+    /**
+     * Returns whether a rank passes the filter
+     */
+    [[nodiscard]] bool acceptsRank(uint64_t ref) const;
+
+    /**
+     * Returns whether a communicator passes the filter
+     */
+    [[nodiscard]] bool acceptsCommunicator(const types::communicator *communicator) const;
+
+    /**
+     * Passing regions, indexed by region reference. Slot kinds and the name pattern are folded in.
+     */
+    std::vector<bool> regions;
+
+    /**
+     * Passing ranks, indexed by location group reference. Empty if all ranks pass.
+     */
+    std::vector<bool> ranks;
+
+    /**
+     * Passing communicators, indexed by communicator reference. Empty if all communicators pass.
+     */
+    std::vector<bool> communicators;
+
+    /**
+     * Minimum duration of slots
+     */
+    types::TraceTime minDuration;
+
+    /**
+     * Whether no element is filtered out
+     */
+    bool trivial;
+};
+
+
+#endif //MOTIV_COMPILEDFILTER_HPP
@@ -0,0 +1,219 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CriticalPath.hpp"
+#include "MpiSlotIndex.hpp"
+#include "src/utils.hpp"
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+namespace {
+    /**
+     * The path arriving at `at` on a location continues at `toTime` on location `to`
+     */
+    struct Dependency {
+        types::TraceTime at;
+        uint64_t to;
+        types::TraceTime toTime;
+    };
+
+    struct Location {
+        otf2::definition::location_group *rank = nullptr;
+        otf2::definition::location *location = nullptr;
+        std::vector<Slot *> slots;
+        std::vector<Dependency> dependencies;
+        std::vector<CriticalPathSegment> segments;
+    };
+
+    template<typename T>
+    std::vector<CriticalPathShare<T>> sortedShares(const std::map<uint64_t, CriticalPathShare<T>> &shares) {
+        std::vector<CriticalPathShare<T>> result;
+        for (const auto &[ref, share]: shares) {
+            if (share.time > types::TraceTime(0)) result.push_back(share);
+        }
+        std::sort(result.begin(), result.end(), [](const auto &lhs, const auto &rhs) { return lhs.time > rhs.time; });
+        return result;
+    }
+}
+
+CriticalPath::CriticalPath(Trace *trace) {
+    std::unordered_map<uint64_t, Location> locations;
+    for (const auto &[group, groupSlots]: trace->getSlots()) {
+        for (const auto &slot: groupSlots) {
+            auto &location = locations[slot->location->ref().get()];
+            location.rank = group;
+            location.location = slot->location;
+            location.slots.push_back(slot);
+        }
+    }
+    if (locations.empty()) return;
+
+    MpiSlotIndex mpiSlots(trace);
+    auto depend = [&locations](const Slot *waiting, const otf2::definition::location *on, types::TraceTime time) {
+        locations[waiting->location->ref().get()].dependencies.push_back({waiting->endTime, on->ref().get(), time});
+    };
+
+    for (const auto &communication: trace->getCommunications()) {
+        auto send = communication->getSendEvent();
+        auto receive = communication->getReceiveEvent();
+        auto sendSlot = mpiSlots.enclosing(send->getLocation(), send->getStartTime());
+        auto receiveSlot = mpiSlots.enclosing(receive->getLocation(), receive->getEndTime());
+        if (sendSlot && receiveSlot && receiveSlot->startTime < sendSlot->startTime) {
+            depend(receiveSlot, send->getLocation(), send->getStartTime());
+        }
+    }
+
+    for (const auto &collective: trace->getCollectiveCommunications()) {
+        auto operation = collective->getOperation();
+        if (!isNxNCollective(operation) && !isOneToNCollective(operation)) continue;
+
+        std::vector<Slot *> members;
+        for (const auto &member: collective->getMembers()) {
+            auto slot = mpiSlots.enclosing(member->getLocation(), member->getStart());
+            if (slot) members.push_back(slot);
+        }
+
+        // All members wait for the last one entering or for the root
+        Slot *awaited = nullptr;
+        if (isNxNCollective(operation)) {
+            auto last = std::max_element(members.begin(), members.end(), [](const Slot *lhs, const Slot *rhs) {
+                return lhs->startTime < rhs->startTime;
+            });
+            if (last != members.end()) awaited = *last;
+        } else if (auto root = collectiveRootLocation(collective)) {
+            auto rootSlot = std::find_if(members.begin(), members.end(), [&root](const Slot *slot) {
+                return slot->location->ref().get() == *root;
+            });
+            if (rootSlot != members.end()) awaited = *rootSlot;
+        }
+        if (!awaited) continue;
+
+        for (const auto &slot: members) {
+            if (slot->startTime < awaited->startTime) {
+                depend(slot, awaited->location, awaited->startTime);
+            }
+        }
+    }
+
+    // The path ends on the location finishing last
+    uint64_t current = 0;
+    auto time = types::TraceTime::min();
+    for (auto &[ref, location]: locations) {
+        std::sort(location.dependencies.begin(), location.dependencies.end(),
+                  [](const Dependency &lhs, const Dependency &rhs) { return lhs.at < rhs.at; });
+        for (const auto &slot: location.slots) {
+            if (slot->endTime > time) {
+                time = slot->endTime;
+                current = ref;
+            }
+        }
+    }
+
+    while (true) {
+        auto &location = locations[current];
+        const auto &dependencies = location.dependencies;
+        auto it = std::upper_bound(dependencies.begin(), dependencies.end(), time,
+                                   [](types::TraceTime t, const Dependency &dependency) { return t < dependency.at; });
+        // Jumps have to move back in time, otherwise the walk could cycle
+        while (it != dependencies.begin() && std::prev(it)->toTime >= time) --it;
+
+        if (it == dependencies.begin()) {
+            auto start = location.slots.empty() ? types::TraceTime(0) : location.slots.front()->startTime;
+            segments.push_back({location.rank, location.location, std::min(start, time), time});
+            break;
+        }
+        auto dependency = *std::prev(it);
+        segments.push_back({location.rank, location.location, dependency.toTime, time});
+        current = dependency.to;
+        time = dependency.toTime;
+        if (!locations.contains(current)) break;
+    }
+    std::reverse(segments.begin(), segments.end());
+
+    // Slots get the time of the path they overlap, which is taken from the slot they were called by
+    std::map<uint64_t, CriticalPathShare<otf2::definition::region>> regionShares;
+    std::map<uint64_t, CriticalPathShare<otf2::definition::location_group>> rankShares;
+    for (const auto &segment: segments) {
+        locations[segment.location->ref().get()].segments.push_back(segment);
+        rankShares.try_emplace(segment.rank->ref().get(), CriticalPathShare<otf2::definition::location_group>{
+            segment.rank, types::TraceTime(0)
+        }).first->second.time += segment.to - segment.from;
+    }
+    for (const auto &[ref, location]: locations) {
+        if (location.segments.empty()) continue;
+
+        for (const auto &slot: location.slots) {
+            auto first = std::upper_bound(location.segments.begin(), location.segments.end(), slot->startTime,
+                                          [](types::TraceTime t, const CriticalPathSegment &segment) {
+                                              return t < segment.to;
+                                          });
+            types::TraceTime overlap(0);
+            for (auto it = first; it != location.segments.end() && it->from < slot->endTime; ++it) {
+                overlap += std::min(it->to, slot->endTime) - std::max(it->from, slot->startTime);
+            }
+            if (overlap <= types::TraceTime(0)) continue;
+
+            auto share = [&regionShares](otf2::definition::region *region) -> types::TraceTime & {
+                return regionShares.try_emplace(region->ref().get(), CriticalPathShare<otf2::definition::region>{
+                    region, types::TraceTime(0)
+                }).first->second.time;
+            };
+            share(slot->region) += overlap;
+            if (slot->parent) {
+                share(slot->parent->region) -= overlap;
+            }
+        }
+    }
+    regions = sortedShares(regionShares);
+    ranks = sortedShares(rankShares);
+}
+
+const std::vector<CriticalPathSegment> &CriticalPath::getSegments() const {
+    return segments;
+}
+
+std::pair<CriticalPath::Iterator, CriticalPath::Iterator>
+CriticalPath::inWindow(types::TraceTime from, types::TraceTime to) const {
+    auto first = std::upper_bound(segments.begin(), segments.end(), from,
+                                  [](types::TraceTime t, const CriticalPathSegment &segment) {
+                                      return t < segment.to;
+                                  });
+    auto last = std::lower_bound(first, segments.end(), to, [](const CriticalPathSegment &segment, types::TraceTime t) {
+        return segment.from < t;
+    });
+    return {first, last};
+}
+
+const std::vector<CriticalPathShare<otf2::definition::region>> &CriticalPath::getRegions() const {
+    return regions;
+}
+
+const std::vector<CriticalPathShare<otf2::definition::location_group>> &CriticalPath::getRanks() const {
+    return ranks;
+}
+
+types::TraceTime CriticalPath::length() const {
+    return segments.empty() ? types::TraceTime(0) : segments.back().to - segments.front().from;
+}
+
+size_t CriticalPath::memoryUsage() const {
+    return sizeof(CriticalPath) + segments.capacity() * sizeof(CriticalPathSegment) +
+           regions.capacity() * sizeof(CriticalPathShare<otf2::definition::region>) +
+           ranks.capacity() * sizeof(CriticalPathShare<otf2::definition::location_group>);
+}
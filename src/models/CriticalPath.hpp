@@ -0,0 +1,111 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_CRITICALPATH_HPP
+#define MOTIV_CRITICALPATH_HPP
+
+
+#include <vector>
+
+#include "Trace.hpp"
+
+/**
+ * @brief Part of the critical path running on a single location
+ */
+struct CriticalPathSegment {
+    otf2::definition::location_group *rank;
+    otf2::definition::location *location;
+    types::TraceTime from;
+    types::TraceTime to;
+};
+
+/**
+ * @brief Time a region or rank spends on the critical path
+ */
+template<typename T>
+struct CriticalPathShare {
+    T *element;
+    types::TraceTime time;
+};
+
+/**
+ * @brief The critical path through the trace, the chain of activities that determines the runtime
+ *
+ * The path is followed backwards from the location that finishes last. It stays on a location until it reaches an MPI
+ * slot that had to wait for another location: a receive entered before the matching send, a member of an N×N
+ * collective entered before the last member or a member of a broadcast or scatter entered before the root. There the
+ * path jumps to the send or the entering of the awaited location. Each jump moves back in time, so the path is found
+ * with one binary search per jump.
+ *
+ * The time on the path is attributed exclusively to the innermost slots it runs through.
+ */
+class CriticalPath {
+public:
+    typedef std::vector<CriticalPathSegment>::const_iterator Iterator;
+
+    /**
+     * @brief Computes the critical path of a trace
+     * @param trace The trace
+     */
+    explicit CriticalPath(Trace *trace);
+
+    /**
+     * @brief Returns the segments of the path ordered by time
+     * @return The segments, each one starts where the previous one ended
+     */
+    [[nodiscard]] const std::vector<CriticalPathSegment> &getSegments() const;
+
+    /**
+     * @brief Returns the segments overlapping a time window
+     * @param from Start of the window
+     * @param to End of the window
+     * @return Begin and end of the segments
+     */
+    [[nodiscard]] std::pair<Iterator, Iterator> inWindow(types::TraceTime from, types::TraceTime to) const;
+
+    /**
+     * @brief Returns the time each region spends on the path
+     * @return The regions with their time, longest first
+     */
+    [[nodiscard]] const std::vector<CriticalPathShare<otf2::definition::region>> &getRegions() const;
+
+    /**
+     * @brief Returns the time each rank spends on the path
+     * @return The ranks with their time, longest first
+     */
+    [[nodiscard]] const std::vector<CriticalPathShare<otf2::definition::location_group>> &getRanks() const;
+
+    /**
+     * @brief Returns the length of the path
+     * @return The time from the start of the first to the end of the last segment
+     */
+    [[nodiscard]] types::TraceTime length() const;
+
+    /**
+     * @brief Returns the bytes used by the segments and shares
+     * @return The used bytes
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    std::vector<CriticalPathSegment> segments;
+    std::vector<CriticalPathShare<otf2::definition::region>> regions;
+    std::vector<CriticalPathShare<otf2::definition::location_group>> ranks;
+};
+
+
+#endif //MOTIV_CRITICALPATH_HPP
@@ -18,6 +18,7 @@
 #include "Filetrace.hpp"
 #include "Range.hpp"
 #include "src/utils.hpp"
+#include "src/SelfTracer.hpp"
 
 FileTrace::FileTrace(std::vector<Slot *> &slotss,
                      std::vector<Communication *> &communications,
@@ -29,6 +30,7 @@ FileTrace::FileTrace(std::vector<Slot *> &slotss,
     runtime_ = runtime;
     startTime_ = otf2::chrono::duration(0);
 
+    SelfTracer::Scope scope("grouping");
     slots_ = groupBy<Slot *, otf2::definition::location_group *, LocationGroupCmp>(
         Range(slotsVec_),
         [](const Slot *s) {
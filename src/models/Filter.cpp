@@ -17,6 +17,8 @@
  */
 #include "Filter.hpp"
 
+#include <utility>
+
 SlotKind Filter::getSlotKinds() const {
     return slotKinds_;
 }
@@ -24,3 +26,40 @@ SlotKind Filter::getSlotKinds() const {
 void Filter::setSlotKinds(SlotKind slotKinds) {
     slotKinds_ = slotKinds;
 }
+
+const std::string &Filter::getRegionPattern() const {
+    return regionPattern_;
+}
+
+FilterPatternSyntax Filter::getRegionPatternSyntax() const {
+    return regionPatternSyntax_;
+}
+
+void Filter::setRegionPattern(const std::string &pattern, FilterPatternSyntax syntax) {
+    regionPattern_ = pattern;
+    regionPatternSyntax_ = syntax;
+}
+
+const std::set<uint64_t> &Filter::getRanks() const {
+    return ranks_;
+}
+
+void Filter::setRanks(std::set<uint64_t> ranks) {
+    ranks_ = std::move(ranks);
+}
+
+const std::set<uint64_t> &Filter::getCommunicators() const {
+    return communicators_;
+}
+
+void Filter::setCommunicators(std::set<uint64_t> communicators) {
+    communicators_ = std::move(communicators);
+}
+
+types::TraceTime Filter::getMinDuration() const {
+    return minDuration_;
+}
+
+void Filter::setMinDuration(types::TraceTime minDuration) {
+    minDuration_ = minDuration;
+}
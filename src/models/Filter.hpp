@@ -20,7 +20,21 @@
 
 #define FILTER_DEFAULT ((SlotKind) (SlotKind::MPI | SlotKind::OpenMP | SlotKind::Plain))
 
+#include <set>
+#include <string>
+
 #include "Slot.hpp"
+#include "src/types.hpp"
+
+/**
+ * @brief Syntax of the region name pattern of a Filter.
+ */
+enum class FilterPatternSyntax {
+    /** Shell like wildcards, `*` and `?` */
+    Glob,
+    /** Perl compatible regular expressions */
+    Regex
+};
 
 /**
  * @brief Class containing options to filter the view.
@@ -43,8 +57,74 @@ public: // methods
      */
     void setSlotKinds(SlotKind slotKinds);
 
+    /**
+     * @brief Returns the pattern region names have to match to be rendered.
+     *
+     * An empty pattern matches all regions.
+     * @return The pattern region names have to match.
+     */
+    [[nodiscard]] const std::string &getRegionPattern() const;
+
+    /**
+     * @brief Returns the syntax of the region name pattern.
+     * @return The syntax of the region name pattern.
+     */
+    [[nodiscard]] FilterPatternSyntax getRegionPatternSyntax() const;
+
+    /**
+     * @brief Sets the pattern region names have to match to be rendered.
+     * @param pattern The pattern, an empty pattern matches all regions
+     * @param syntax The syntax of the pattern
+     */
+    void setRegionPattern(const std::string &pattern, FilterPatternSyntax syntax = FilterPatternSyntax::Glob);
+
+    /**
+     * @brief Returns the references of the ranks that should be rendered.
+     *
+     * An empty set shows all ranks.
+     * @return The references of the location groups that should be rendered.
+     */
+    [[nodiscard]] const std::set<uint64_t> &getRanks() const;
+
+    /**
+     * @brief Sets the ranks that should be rendered.
+     * @param ranks The references of the location groups that should be rendered, an empty set shows all ranks
+     */
+    void setRanks(std::set<uint64_t> ranks);
+
+    /**
+     * @brief Returns the references of the communicators whose communications should be rendered.
+     *
+     * An empty set shows all communicators.
+     * @return The references of the communicators whose communications should be rendered.
+     */
+    [[nodiscard]] const std::set<uint64_t> &getCommunicators() const;
+
+    /**
+     * @brief Sets the communicators whose communications should be rendered.
+     * @param communicators The references of the communicators, an empty set shows all communicators
+     */
+    void setCommunicators(std::set<uint64_t> communicators);
+
+    /**
+     * @brief Returns the minimum duration of slots that should be rendered.
+     * @return The minimum duration of slots that should be rendered.
+     */
+    [[nodiscard]] types::TraceTime getMinDuration() const;
+
+    /**
+     * @brief Sets the minimum duration of slots that should be rendered.
+     * @param minDuration Slots shorter than this duration are hidden
+     */
+    void setMinDuration(types::TraceTime minDuration);
+
 private: // fields
     SlotKind slotKinds_ = FILTER_DEFAULT;
+    std::string regionPattern_;
+    FilterPatternSyntax regionPatternSyntax_ = FilterPatternSyntax::Glob;
+    std::set<uint64_t> ranks_;
+    std::set<uint64_t> communicators_;
+    types::TraceTime minDuration_ = types::TraceTime(0);
 };
 
 
@@ -0,0 +1,82 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_LOADOPTIONS_HPP
+#define MOTIV_LOADOPTIONS_HPP
+
+
+#include <QString>
+#include <QStringList>
+
+#include "RegionFilter.hpp"
+#include "src/types.hpp"
+
+/**
+ * @brief Options controlling which parts of a trace are kept while reading it
+ */
+struct LoadOptions {
+    /**
+     * Regions for which no slots are created
+     */
+    RegionFilter regionFilter;
+
+    /**
+     * Score-P filter file the region filter was read from, empty if none was given
+     */
+    QString regionFilterFile;
+
+    /**
+     * Wildcard patterns of regions excluded in addition to the filter file
+     */
+    QStringList excludedRegions;
+
+    /**
+     * Whether events are only accumulated into a TraceSummary instead of being kept as slots and communications
+     */
+    bool summaryOnly = false;
+
+    /**
+     * Only the locations of every n-th rank are read, used to sample a trace
+     */
+    uint64_t rankStride = 1;
+
+    /**
+     * Whether the events are additionally accumulated into a summary whose snapshots show the progress of loading
+     */
+    bool progressSnapshots = false;
+
+    /**
+     * Start of the time window whose elements are kept, elements ending earlier are dropped
+     */
+    types::TraceTime windowBegin = types::TraceTime(0);
+
+    /**
+     * End of the time window whose elements are kept, elements starting later are dropped
+     */
+    types::TraceTime windowEnd = types::TraceTime::max();
+
+    /**
+     * @brief Returns whether only a time window of the trace is kept
+     * @return True if a window is set
+     */
+    [[nodiscard]] bool hasWindow() const {
+        return windowBegin != types::TraceTime(0) || windowEnd != types::TraceTime::max();
+    }
+};
+
+
+#endif //MOTIV_LOADOPTIONS_HPP
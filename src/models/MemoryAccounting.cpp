@@ -0,0 +1,37 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MemoryAccounting.hpp"
+
+void MemoryAccounting::registerReporter(const void *owner, MemoryAccounting::Reporter reporter) {
+    std::lock_guard lock(mutex);
+    reporters[owner] = std::move(reporter);
+}
+
+void MemoryAccounting::unregisterReporter(const void *owner) {
+    std::lock_guard lock(mutex);
+    reporters.erase(owner);
+}
+
+MemoryReport MemoryAccounting::report() const {
+    std::lock_guard lock(mutex);
+    MemoryReport report;
+    for (const auto &[owner, reporter]: reporters) {
+        reporter(report);
+    }
+    return report;
+}
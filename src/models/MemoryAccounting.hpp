@@ -0,0 +1,80 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_MEMORYACCOUNTING_HPP
+#define MOTIV_MEMORYACCOUNTING_HPP
+
+
+#include <functional>
+#include <map>
+#include <mutex>
+
+#include "MemoryReport.hpp"
+
+/**
+ * @brief Singleton collecting memory reports from the components holding trace data
+ *
+ * Components register a function adding their usage to a report and unregister before they are destroyed.
+ */
+class MemoryAccounting {
+private:
+    MemoryAccounting() = default;
+
+public:
+    /**
+     * @brief Function adding the usage of a component to a report
+     */
+    using Reporter = std::function<void(MemoryReport &)>;
+
+    /**
+     * @return instance of MemoryAccounting
+     */
+    static MemoryAccounting &getInstance() {
+        static MemoryAccounting instance;
+        return instance;
+    }
+
+    // Do not implement copy and copy assignment constructor.
+    MemoryAccounting(MemoryAccounting const &) = delete;
+    void operator=(MemoryAccounting const &) = delete;
+
+    /**
+     * @brief Registers a component
+     * @param owner The component, used to unregister it
+     * @param reporter Function adding the usage of the component
+     */
+    void registerReporter(const void *owner, Reporter reporter);
+
+    /**
+     * @brief Unregisters a component
+     * @param owner The component
+     */
+    void unregisterReporter(const void *owner);
+
+    /**
+     * @brief Collects the usage of all registered components
+     * @return The combined report
+     */
+    [[nodiscard]] MemoryReport report() const;
+
+private:
+    mutable std::mutex mutex;
+    std::map<const void *, Reporter> reporters;
+};
+
+
+#endif //MOTIV_MEMORYACCOUNTING_HPP
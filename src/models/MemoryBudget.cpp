@@ -0,0 +1,102 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MemoryBudget.hpp"
+#include "AppSettings.hpp"
+
+MemoryBudget::MemoryBudget() : budget(AppSettings::getInstance().memoryBudget() * 1024 * 1024) {
+}
+
+bool MemoryBudget::add(const void *key, size_t bytes, MemoryBudget::Eviction evict) {
+    std::vector<Eviction> evictions;
+    {
+        std::lock_guard lock(mutex);
+        if (bytes > budget) {
+            return false;
+        }
+
+        auto it = index.find(key);
+        if (it != index.end()) {
+            usage -= it->second->bytes;
+            entries.erase(it->second);
+        }
+
+        entries.push_front({key, bytes, std::move(evict)});
+        index[key] = entries.begin();
+        usage += bytes;
+        evictions = takeOverBudget();
+    }
+
+    // Evictions run without holding the lock, they may query the budget or remove further entries
+    for (const auto &eviction: evictions) {
+        eviction();
+    }
+    return true;
+}
+
+void MemoryBudget::touch(const void *key) {
+    std::lock_guard lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+    }
+}
+
+void MemoryBudget::remove(const void *key) {
+    std::lock_guard lock(mutex);
+    auto it = index.find(key);
+    if (it != index.end()) {
+        usage -= it->second->bytes;
+        entries.erase(it->second);
+        index.erase(it);
+    }
+}
+
+void MemoryBudget::setBudget(size_t bytes) {
+    std::vector<Eviction> evictions;
+    {
+        std::lock_guard lock(mutex);
+        budget = bytes;
+        evictions = takeOverBudget();
+    }
+
+    for (const auto &eviction: evictions) {
+        eviction();
+    }
+}
+
+size_t MemoryBudget::getBudget() const {
+    std::lock_guard lock(mutex);
+    return budget;
+}
+
+size_t MemoryBudget::getUsage() const {
+    std::lock_guard lock(mutex);
+    return usage;
+}
+
+std::vector<MemoryBudget::Eviction> MemoryBudget::takeOverBudget() {
+    std::vector<Eviction> evictions;
+    while (usage > budget && !entries.empty()) {
+        auto &entry = entries.back();
+        usage -= entry.bytes;
+        evictions.push_back(std::move(entry.evict));
+        index.erase(entry.key);
+        entries.pop_back();
+    }
+    return evictions;
+}
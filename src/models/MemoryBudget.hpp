@@ -0,0 +1,125 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_MEMORYBUDGET_HPP
+#define MOTIV_MEMORYBUDGET_HPP
+
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Singleton keeping the entries of all caches within a common budget
+ *
+ * Caches add their entries with the bytes they use and a function dropping the entry. If the budget is exceeded, the
+ * least recently used entries of all caches are evicted. A cache whose entry was evicted has to recompute the data
+ * when it is needed again. The budget is read from the AppSettings.
+ */
+class MemoryBudget {
+private:
+    MemoryBudget();
+
+public:
+    /**
+     * @brief Function dropping an entry from its cache, it must not add entries itself
+     */
+    using Eviction = std::function<void()>;
+
+    /**
+     * @return instance of MemoryBudget
+     */
+    static MemoryBudget &getInstance() {
+        static MemoryBudget instance;
+        return instance;
+    }
+
+    // Do not implement copy and copy assignment constructor.
+    MemoryBudget(MemoryBudget const &) = delete;
+    void operator=(MemoryBudget const &) = delete;
+
+    /**
+     * @brief Adds an entry as the most recently used one
+     *
+     * Entries of any cache may be evicted to stay within the budget. The evictions run on the calling thread after
+     * this method returned the decision about the new entry.
+     *
+     * @param key The cached object, used to refer to the entry
+     * @param bytes Bytes used by the entry
+     * @param evict Function dropping the entry from its cache
+     * @return false if the entry alone exceeds the budget and must not be cached
+     */
+    bool add(const void *key, size_t bytes, Eviction evict);
+
+    /**
+     * @brief Marks an entry as the most recently used one
+     * @param key The cached object
+     */
+    void touch(const void *key);
+
+    /**
+     * @brief Removes an entry without evicting it, e.g. because its cache is destroyed
+     * @param key The cached object
+     */
+    void remove(const void *key);
+
+    /**
+     * @brief Sets the budget and evicts entries until it is met
+     * @param bytes The budget in bytes
+     */
+    void setBudget(size_t bytes);
+
+    /**
+     * @brief Returns the budget
+     * @return The budget in bytes
+     */
+    [[nodiscard]] size_t getBudget() const;
+
+    /**
+     * @brief Returns the bytes used by all entries
+     * @return The used bytes
+     */
+    [[nodiscard]] size_t getUsage() const;
+
+private:
+    struct Entry {
+        const void *key;
+        size_t bytes;
+        Eviction evict;
+    };
+
+    /**
+     * Removes least recently used entries until the budget is met, the caller must hold the mutex
+     */
+    std::vector<Eviction> takeOverBudget();
+
+private:
+    mutable std::mutex mutex;
+    /**
+     * Most recently used entries first
+     */
+    std::list<Entry> entries;
+    std::unordered_map<const void *, std::list<Entry>::iterator> index;
+    size_t budget;
+    size_t usage = 0;
+};
+
+
+#endif //MOTIV_MEMORYBUDGET_HPP
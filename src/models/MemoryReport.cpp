@@ -0,0 +1,171 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MemoryReport.hpp"
+#include "UITrace.hpp"
+#include "src/models/communication/BlockingReceivEevent.hpp"
+#include "src/models/communication/BlockingSendEvent.hpp"
+#include "src/models/communication/NonBlockingReceiveEvent.hpp"
+#include "src/models/communication/NonBlockingSendEvent.hpp"
+#include "src/models/communication/RequestCancelledEvent.hpp"
+
+#include <sstream>
+#include <unordered_set>
+
+static size_t eventSize(const CommunicationEvent *event) {
+    switch (event->getKind()) {
+        case BlockingSend:
+            return sizeof(BlockingSendEvent);
+        case BlockingReceive:
+            return sizeof(BlockingReceiveEvent);
+        case NonBlockingSend:
+            return sizeof(NonBlockingSendEvent);
+        case NonBlockingReceive:
+            return sizeof(NonBlockingReceiveEvent);
+        case Collective:
+            return sizeof(CollectiveCommunicationEvent);
+        case RequestCancelled:
+            return sizeof(RequestCancelledEvent);
+    }
+    return sizeof(CommunicationEvent);
+}
+
+void MemoryReport::add(MemoryReport::Category category, size_t objects, size_t bytes) {
+    usages[category].objects += objects;
+    usages[category].bytes += bytes;
+}
+
+void MemoryReport::add(const MemoryReport &other) {
+    for (int i = 0; i < CategoryCount; i++) {
+        add(static_cast<Category>(i), other.usages[i].objects, other.usages[i].bytes);
+    }
+}
+
+MemoryUsage MemoryReport::get(MemoryReport::Category category) const {
+    return usages[category];
+}
+
+MemoryUsage MemoryReport::total() const {
+    MemoryUsage total;
+    for (const auto &usage: usages) {
+        total.objects += usage.objects;
+        total.bytes += usage.bytes;
+    }
+    return total;
+}
+
+std::string MemoryReport::toTsv() const {
+    std::stringstream stream;
+    stream << "category\tobjects\tbytes\n";
+    for (int i = 0; i < CategoryCount; i++) {
+        stream << categoryName(static_cast<Category>(i)) << "\t" << usages[i].objects << "\t" << usages[i].bytes << "\n";
+    }
+    auto sum = total();
+    stream << "total\t" << sum.objects << "\t" << sum.bytes << "\n";
+    return stream.str();
+}
+
+std::string MemoryReport::categoryName(MemoryReport::Category category) {
+    switch (category) {
+        case Slots:
+            return "slots";
+        case CommunicationEvents:
+            return "communication events";
+        case CollectiveMembers:
+            return "collective members";
+        case Definitions:
+            return "definitions";
+        case LodCaches:
+            return "LOD caches";
+        case SceneItems:
+            return "scene items";
+        case Aggregates:
+            return "aggregates";
+        case CategoryCount:
+            break;
+    }
+    return "unknown";
+}
+
+MemoryReport MemoryReport::forTrace(Trace *trace) {
+    MemoryReport report;
+
+    // Definitions are copied for every event referencing them, distinct copies are counted once
+    std::unordered_set<const void *> locations;
+    std::unordered_set<const void *> regions;
+    std::unordered_set<const void *> communicators;
+
+    for (const auto &[group, slots]: trace->getSlots()) {
+        report.add(Slots, slots.size(), slots.size() * (sizeof(Slot) + sizeof(Slot *)));
+        for (const auto &slot: slots) {
+            locations.insert(slot->location);
+            regions.insert(slot->region);
+        }
+    }
+
+    auto communications = trace->getCommunications();
+    for (const auto &communication: communications) {
+        auto start = communication->getStartEvent();
+        auto end = communication->getEndEvent();
+        report.add(CommunicationEvents, 3, sizeof(Communication) + sizeof(Communication *) + eventSize(start) + eventSize(end));
+        locations.insert(start->getLocation());
+        locations.insert(end->getLocation());
+        communicators.insert(start->getCommunicator());
+        communicators.insert(end->getCommunicator());
+    }
+
+    auto collectives = trace->getCollectiveCommunications();
+    for (const auto &collective: collectives) {
+        auto &members = collective->getMembers();
+        report.add(CollectiveMembers, 1 + members.size(),
+                   sizeof(CollectiveCommunicationEvent) + sizeof(CollectiveCommunicationEvent *) +
+                   members.size() * (sizeof(CollectiveCommunicationEvent::Member) + sizeof(CollectiveCommunicationEvent::Member *)));
+        locations.insert(collective->getLocation());
+        communicators.insert(collective->getCommunicator());
+        for (const auto &member: members) {
+            locations.insert(member->getLocation());
+        }
+    }
+
+    report.add(Definitions, locations.size(), locations.size() * sizeof(otf2::definition::location));
+    report.add(Definitions, regions.size(), regions.size() * sizeof(otf2::definition::region));
+    report.add(Definitions, communicators.size(), communicators.size() * sizeof(types::communicator));
+    return report;
+}
+
+MemoryReport MemoryReport::forDerivedTrace(UITrace *trace) {
+    MemoryReport report;
+
+    size_t references = 0;
+    for (const auto &[group, slots]: trace->getSlots()) {
+        references += slots.size();
+    }
+    references += trace->getCommunications().size();
+    references += trace->getCollectiveCommunications().size();
+    references += trace->getCommunicationBundles().size();
+    report.add(LodCaches, 1, sizeof(UITrace) + references * sizeof(void *));
+
+    auto slots = trace->getAggregatedSlotCount();
+    auto collectives = trace->getAggregatedCollectiveCount();
+    auto bundles = trace->getCommunicationBundles().size();
+    report.add(Aggregates, slots, slots * sizeof(Slot));
+    report.add(Aggregates, 2 * collectives,
+               collectives * (sizeof(CollectiveCommunicationEvent) + sizeof(CollectiveCommunicationEvent::Member) +
+                              sizeof(CollectiveCommunicationEvent::Member *)));
+    report.add(Aggregates, bundles, bundles * sizeof(CommunicationBundle));
+    return report;
+}
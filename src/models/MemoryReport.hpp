@@ -0,0 +1,127 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_MEMORYREPORT_HPP
+#define MOTIV_MEMORYREPORT_HPP
+
+
+#include <array>
+#include <cstddef>
+#include <string>
+
+#include "Trace.hpp"
+
+class UITrace;
+
+/**
+ * @brief Number of objects and bytes used by a category
+ */
+struct MemoryUsage {
+    size_t objects = 0;
+    size_t bytes = 0;
+};
+
+/**
+ * @brief Memory used by MOTIV broken down into categories
+ *
+ * Bytes are estimated from the sizes of the objects and the pointers referencing them, allocator overhead and the
+ * shared data of OTF2 definitions are not included.
+ */
+class MemoryReport {
+public:
+    /**
+     * @brief Categories memory is accounted for
+     */
+    enum Category {
+        Slots,
+        CommunicationEvents,
+        CollectiveMembers,
+        Definitions,
+        LodCaches,
+        SceneItems,
+        Aggregates,
+        CategoryCount
+    };
+
+    /**
+     * @brief Adds objects and their bytes to a category
+     * @param category The category
+     * @param objects Number of objects
+     * @param bytes Bytes used by the objects
+     */
+    void add(Category category, size_t objects, size_t bytes);
+
+    /**
+     * @brief Adds all categories of another report
+     * @param other The other report
+     */
+    void add(const MemoryReport &other);
+
+    /**
+     * @brief Returns the usage of a category
+     * @param category The category
+     * @return The usage of the category
+     */
+    [[nodiscard]] MemoryUsage get(Category category) const;
+
+    /**
+     * @brief Returns the usage of all categories together
+     * @return The total usage
+     */
+    [[nodiscard]] MemoryUsage total() const;
+
+    /**
+     * @brief Formats the report as tab separated values with a header line
+     * @return The report as TSV
+     */
+    [[nodiscard]] std::string toTsv() const;
+
+    /**
+     * @brief Returns a human readable name of a category
+     * @param category The category
+     * @return Name of the category
+     */
+    static std::string categoryName(Category category);
+
+    /**
+     * @brief Accounts the elements of a trace read from a file
+     *
+     * Slots, communications with their events, collective communications with their members and the definitions
+     * referenced by them are accounted.
+     *
+     * @param trace The trace
+     * @return The report for the trace
+     */
+    static MemoryReport forTrace(Trace *trace);
+
+    /**
+     * @brief Accounts a trace derived by reducing the level of detail
+     *
+     * The containers referencing the elements are accounted as LOD cache, the slots, collective communications and
+     * bundles created while reducing the level of detail as aggregates.
+     *
+     * @param trace The derived trace
+     * @return The report for the trace
+     */
+    static MemoryReport forDerivedTrace(UITrace *trace);
+
+private:
+    std::array<MemoryUsage, CategoryCount> usages{};
+};
+
+
+#endif //MOTIV_MEMORYREPORT_HPP
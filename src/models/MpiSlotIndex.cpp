@@ -0,0 +1,47 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "MpiSlotIndex.hpp"
+
+#include <algorithm>
+
+MpiSlotIndex::MpiSlotIndex(Trace *trace) {
+    for (const auto &[group, groupSlots]: trace->getSlots()) {
+        for (const auto &slot: groupSlots) {
+            if (slot->getKind() == MPI) {
+                slots[slot->location->ref().get()].push_back(slot);
+            }
+        }
+    }
+    for (auto &[ref, locationSlots]: slots) {
+        std::sort(locationSlots.begin(), locationSlots.end(), [](const Slot *lhs, const Slot *rhs) {
+            return lhs->startTime < rhs->startTime;
+        });
+    }
+}
+
+Slot *MpiSlotIndex::enclosing(const otf2::definition::location *location, types::TraceTime time) const {
+    auto it = slots.find(location->ref().get());
+    if (it == slots.end()) return nullptr;
+
+    const auto &locationSlots = it->second;
+    auto next = std::upper_bound(locationSlots.begin(), locationSlots.end(), time,
+                                 [](types::TraceTime t, const Slot *slot) { return t < slot->startTime; });
+    if (next == locationSlots.begin()) return nullptr;
+    auto slot = *std::prev(next);
+    return slot->endTime >= time ? slot : nullptr;
+}
@@ -0,0 +1,56 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_MPISLOTINDEX_HPP
+#define MOTIV_MPISLOTINDEX_HPP
+
+
+#include <unordered_map>
+#include <vector>
+
+#include "Trace.hpp"
+
+/**
+ * @brief Finds the MPI slot of a location around a point in time
+ *
+ * Used to relate communication events and collective members to the MPI calls they were recorded in.
+ */
+class MpiSlotIndex {
+public:
+    /**
+     * @brief Indexes the MPI slots of a trace
+     * @param trace The trace
+     */
+    explicit MpiSlotIndex(Trace *trace);
+
+    /**
+     * @brief Returns the MPI slot of a location running at a point in time
+     * @param location The location
+     * @param time The point in time
+     * @return The slot or nullptr if no MPI slot is running on the location at that time
+     */
+    [[nodiscard]] Slot *enclosing(const otf2::definition::location *location, types::TraceTime time) const;
+
+private:
+    /**
+     * MPI slots per location, ordered by start
+     */
+    std::unordered_map<uint64_t, std::vector<Slot *>> slots;
+};
+
+
+#endif //MOTIV_MPISLOTINDEX_HPP
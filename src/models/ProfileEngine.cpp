@@ -0,0 +1,126 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ProfileEngine.hpp"
+
+#include <QtConcurrent/QtConcurrent>
+
+void RegionProfile::merge(const RegionProfile &other) {
+    region = other.region;
+    calls += other.calls;
+    inclusive += other.inclusive;
+    exclusive += other.exclusive;
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+}
+
+ProfileEngine::ProfileEngine(Trace *trace) : slots(trace->getSlots()) {
+    for (const auto &[group, groupSlots]: slots) {
+        Rank rank{group, {}};
+        for (auto it = groupSlots.begin(); it != groupSlots.end();) {
+            auto end = groupSlots.end() - it > PROFILE_BLOCK_SIZE ? it + PROFILE_BLOCK_SIZE : groupSlots.end();
+            rank.blocks.push_back({it, end, (*it)->startTime, types::TraceTime::min(), {}});
+            it = end;
+        }
+        ranks.push_back(std::move(rank));
+    }
+
+    QtConcurrent::blockingMap(ranks, [](Rank &rank) {
+        for (auto &block: rank.blocks) {
+            for (auto it = block.begin; it != block.end; ++it) {
+                block.maxEnd = std::max(block.maxEnd, (*it)->endTime);
+                add(block.profile, block.callPaths, *it, types::TraceTime::min(), types::TraceTime::max());
+            }
+        }
+    });
+}
+
+ProfileResult ProfileEngine::compute(types::TraceTime from, types::TraceTime to) const {
+    ProfileResult result;
+    for (const auto &rank: ranks) {
+        result.ranks.emplace_back(rank.group, Profile());
+    }
+    result.rankCallPaths.resize(ranks.size());
+
+    // The profiles of the result are in the same order as the ranks
+    QtConcurrent::blockingMap(result.ranks, [this, &result, from, to](std::pair<otf2::definition::location_group *, Profile> &item) {
+        auto index = &item - result.ranks.data();
+        const auto &rank = ranks[index];
+        auto &callPaths = result.rankCallPaths[index];
+        for (const auto &block: rank.blocks) {
+            if (block.firstStart > to) break;
+            if (block.maxEnd < from) continue;
+
+            if (block.firstStart >= from && block.maxEnd <= to) {
+                // All calls of the block lie within the window, the partial result is reused
+                for (const auto &[ref, regionProfile]: block.profile) {
+                    item.second[ref].merge(regionProfile);
+                }
+                for (const auto &[node, pathProfile]: block.callPaths) {
+                    callPaths[node].merge(pathProfile);
+                }
+                continue;
+            }
+
+            for (auto it = block.begin; it != block.end; ++it) {
+                const auto &slot = *it;
+                if (slot->startTime <= to && slot->endTime >= from) {
+                    add(item.second, callPaths, slot, from, to);
+                }
+            }
+        }
+    });
+
+    for (const auto &[group, profile]: result.ranks) {
+        for (const auto &[ref, regionProfile]: profile) {
+            result.total[ref].merge(regionProfile);
+        }
+    }
+    for (const auto &callPaths: result.rankCallPaths) {
+        for (const auto &[node, pathProfile]: callPaths) {
+            result.totalCallPaths[node].merge(pathProfile);
+        }
+    }
+    return result;
+}
+
+void ProfileEngine::add(Profile &profile, Profile &callPaths, const Slot *slot, types::TraceTime from,
+                        types::TraceTime to) {
+    auto duration = std::min(slot->endTime, to) - std::max(slot->startTime, from);
+    auto parent = slot->parent;
+    addCall(profile, slot->region->ref().get(), parent ? parent->region->ref().get() : 0, slot, duration);
+    addCall(callPaths, slot->callPath, parent ? parent->callPath : 0, slot, duration);
+}
+
+void ProfileEngine::addCall(Profile &profile, uint64_t key, uint64_t parentKey, const Slot *slot,
+                            types::TraceTime duration) {
+    auto &regionProfile = profile[key];
+    regionProfile.region = slot->region;
+    regionProfile.calls++;
+    regionProfile.inclusive += duration;
+    regionProfile.exclusive += duration;
+    regionProfile.min = std::min(regionProfile.min, duration);
+    regionProfile.max = std::max(regionProfile.max, duration);
+
+    // The time of a call is not exclusive to its caller. Calls are clipped like their callers, so the caller's
+    // exclusive time cannot become negative once both are added.
+    if (slot->parent) {
+        auto &parentProfile = profile[parentKey];
+        parentProfile.region = slot->parent->region;
+        parentProfile.exclusive -= duration;
+    }
+}
@@ -0,0 +1,144 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_PROFILEENGINE_HPP
+#define MOTIV_PROFILEENGINE_HPP
+
+
+#include <map>
+#include <vector>
+
+#include "Trace.hpp"
+
+/**
+ * Number of slots of a rank whose profile is precomputed as one partial result
+ */
+#define PROFILE_BLOCK_SIZE 4096
+
+/**
+ * @brief Call counts and times of a region
+ */
+struct RegionProfile {
+    otf2::definition::region *region = nullptr;
+    uint64_t calls = 0;
+    /**
+     * Time spent in the region including its callees
+     */
+    types::TraceTime inclusive{0};
+    /**
+     * Time spent in the region excluding its callees
+     */
+    types::TraceTime exclusive{0};
+    /**
+     * Shortest call
+     */
+    types::TraceTime min = types::TraceTime::max();
+    /**
+     * Longest call
+     */
+    types::TraceTime max{0};
+
+    /**
+     * @brief Adds the calls and times of another profile of the same region
+     * @param other The other profile
+     */
+    void merge(const RegionProfile &other);
+};
+
+/**
+ * @brief Profiles of all regions by region reference
+ */
+typedef std::map<uint64_t, RegionProfile> Profile;
+
+/**
+ * @brief Profile of a time window, per rank and for all ranks
+ */
+struct ProfileResult {
+    std::vector<std::pair<otf2::definition::location_group *, Profile>> ranks;
+    Profile total;
+    /**
+     * Profiles of the call paths by node of the CallingContextTree, per rank in the order of ranks. Empty if the
+     * profile was computed from a summary.
+     */
+    std::vector<Profile> rankCallPaths;
+    /**
+     * Profiles of the call paths of all ranks
+     */
+    Profile totalCallPaths;
+};
+
+/**
+ * @brief Computes flat and call-path profiles of the slots of a trace
+ *
+ * Calls overlapping a window are counted, their times are clipped to the window. Exclusive times subtract the time of
+ * the direct callees, which relies on the parents recorded for the slots. Call paths are identified by the nodes of the
+ * CallingContextTree stored in the slots.
+ *
+ * The slots of every rank are split into blocks of PROFILE_BLOCK_SIZE whose profiles are computed once. A window only
+ * merges the blocks lying entirely within it and scans the slots of the blocks at its borders. Ranks are processed in
+ * parallel.
+ */
+class ProfileEngine {
+public:
+    /**
+     * @brief Creates the engine and computes the partial results of all blocks
+     * @param trace The trace, it must outlive the engine
+     */
+    explicit ProfileEngine(Trace *trace);
+
+    /**
+     * @brief Computes the profile of a time window
+     * @param from Start of the window
+     * @param to End of the window
+     * @return The profile per rank and for all ranks
+     */
+    [[nodiscard]] ProfileResult compute(types::TraceTime from, types::TraceTime to) const;
+
+private:
+    struct Block {
+        Range<Slot *>::It begin;
+        Range<Slot *>::It end;
+        types::TraceTime firstStart;
+        types::TraceTime maxEnd;
+        Profile profile;
+        Profile callPaths;
+    };
+
+    struct Rank {
+        otf2::definition::location_group *group;
+        std::vector<Block> blocks;
+    };
+
+    /**
+     * Adds a call clipped to a window to a flat and a call-path profile
+     */
+    static void add(Profile &profile, Profile &callPaths, const Slot *slot, types::TraceTime from,
+                    types::TraceTime to);
+
+    /**
+     * Adds a call to the entry of a profile and subtracts it from the exclusive time of its caller's entry
+     */
+    static void addCall(Profile &profile, uint64_t key, uint64_t parentKey, const Slot *slot,
+                        types::TraceTime duration);
+
+private:
+    std::map<otf2::definition::location_group *, Range<Slot *>, LocationGroupCmp> slots;
+    std::vector<Rank> ranks;
+};
+
+
+#endif //MOTIV_PROFILEENGINE_HPP
@@ -61,8 +61,9 @@ public:
     Range(const Range &rhs) {
         if (rhs.vec_) {
             vec_ = new std::vector<T>(*rhs.vec_);
-            begin_ = std::find(vec_->begin(), vec_->end(), *rhs.begin_);
-            end_ = std::find(vec_->begin(), vec_->end(), *rhs.end_);
+            // The iterators are moved to the copied vector by their offset, end_ must not be dereferenced
+            begin_ = vec_->begin() + (rhs.begin_ - rhs.vec_->begin());
+            end_ = vec_->begin() + (rhs.end_ - rhs.vec_->begin());
         } else {
             begin_ = rhs.begin_;
             end_ = rhs.end_;
@@ -96,9 +97,11 @@ public:
         if (rhs.vec_) {
             delete vec_;
             vec_ = new std::vector<T>(*rhs.vec_);
-            begin_ = std::find(vec_->begin(), vec_->end(), *rhs.begin_);
-            end_ = std::find(vec_->begin(), vec_->end(), *rhs.end_);
+            begin_ = vec_->begin() + (rhs.begin_ - rhs.vec_->begin());
+            end_ = vec_->begin() + (rhs.end_ - rhs.vec_->begin());
         } else {
+            delete vec_;
+            vec_ = nullptr;
             begin_ = rhs.begin_;
             end_ = rhs.end_;
         }
@@ -126,6 +129,12 @@ public:
      */
     [[nodiscard]] bool empty() const { return begin_ == end_; };
 
+    /**
+     * Number of elements in the range
+     * @return the number of elements
+     */
+    [[nodiscard]] size_t size() const { return end_ - begin_; };
+
     virtual ~Range() {
         delete vec_;
     };
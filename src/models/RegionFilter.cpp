@@ -0,0 +1,113 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RegionFilter.hpp"
+
+#include <QFile>
+#include <QTextStream>
+#include <stdexcept>
+
+static QRegularExpression wildcard(const QString &pattern) {
+    return QRegularExpression(QRegularExpression::wildcardToRegularExpression(pattern));
+}
+
+RegionFilter RegionFilter::fromFile(const QString &path) {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        throw std::invalid_argument("Cannot read the filter file " + path.toStdString());
+    }
+    return fromRules(QTextStream(&file).readAll());
+}
+
+RegionFilter RegionFilter::fromRules(const QString &rules) {
+    RegionFilter filter;
+    std::vector<Rule> *block = nullptr;
+    QString blockEnd;
+    bool exclude = false;
+    bool ruleStarted = false;
+    bool mangled = false;
+
+    for (auto line: rules.split('\n')) {
+        line.truncate(line.indexOf('#') < 0 ? line.size() : line.indexOf('#'));
+        for (const auto &token: line.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts)) {
+            if (!block) {
+                if (token == "SCOREP_REGION_NAMES_BEGIN") {
+                    block = &filter.regionRules;
+                    blockEnd = "SCOREP_REGION_NAMES_END";
+                } else if (token == "SCOREP_FILE_NAMES_BEGIN") {
+                    block = &filter.fileRules;
+                    blockEnd = "SCOREP_FILE_NAMES_END";
+                } else {
+                    throw std::invalid_argument("Unexpected '" + token.toStdString() + "' outside of a filter block");
+                }
+                ruleStarted = false;
+            } else if (token == blockEnd) {
+                block = nullptr;
+            } else if (token == "EXCLUDE" || token == "INCLUDE") {
+                exclude = token == "EXCLUDE";
+                ruleStarted = true;
+                mangled = false;
+            } else if (token == "MANGLED" || token == "DEMANGLED") {
+                mangled = token == "MANGLED";
+            } else if (!ruleStarted) {
+                throw std::invalid_argument("Pattern '" + token.toStdString() + "' is not part of a rule");
+            } else {
+                block->push_back({exclude, mangled && block == &filter.regionRules, wildcard(token)});
+            }
+        }
+    }
+
+    if (block) {
+        throw std::invalid_argument("Missing " + blockEnd.toStdString());
+    }
+    return filter;
+}
+
+void RegionFilter::exclude(const QStringList &patterns) {
+    for (const auto &pattern: patterns) {
+        regionRules.push_back({true, false, wildcard(pattern.trimmed())});
+    }
+}
+
+bool RegionFilter::isEmpty() const {
+    return regionRules.empty() && fileRules.empty();
+}
+
+bool RegionFilter::isExcluded(const otf2::definition::region &region) const {
+    auto name = QString::fromStdString(region.name().str());
+    auto mangledName = region.canonical_name().is_valid() ? QString::fromStdString(region.canonical_name().str()) : name;
+    if (excludedBy(regionRules, name, mangledName)) {
+        return true;
+    }
+
+    // Regions without a source file, like MPI functions, are only filtered by name
+    if (fileRules.empty() || !region.source_file().is_valid()) {
+        return false;
+    }
+    auto file = QString::fromStdString(region.source_file().str());
+    return excludedBy(fileRules, file, file);
+}
+
+bool RegionFilter::excludedBy(const std::vector<Rule> &rules, const QString &name, const QString &mangledName) {
+    auto excluded = false;
+    for (const auto &rule: rules) {
+        if (rule.pattern.match(rule.mangled ? mangledName : name).hasMatch()) {
+            excluded = rule.exclude;
+        }
+    }
+    return excluded;
+}
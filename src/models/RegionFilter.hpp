@@ -0,0 +1,101 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_REGIONFILTER_HPP
+#define MOTIV_REGIONFILTER_HPP
+
+
+#include <QRegularExpression>
+#include <QString>
+#include <QStringList>
+#include <otf2xx/otf2.hpp>
+#include <vector>
+
+/**
+ * @brief Rules deciding which regions are read from a trace
+ *
+ * The rules follow the format of Score-P filter files: a `SCOREP_REGION_NAMES_BEGIN` ... `SCOREP_REGION_NAMES_END`
+ * block lists `EXCLUDE` and `INCLUDE` rules with wildcard patterns matched against region names, optionally followed by
+ * `MANGLED` to match the mangled name. A `SCOREP_FILE_NAMES_BEGIN` ... `SCOREP_FILE_NAMES_END` block matches the source
+ * files of regions. Within a block the last matching rule wins, a region is excluded if either block excludes it.
+ * Everything after a `#` is a comment.
+ *
+ * Enter and leave events of excluded regions are skipped while reading, so no slots are created for them.
+ */
+class RegionFilter {
+public:
+    /**
+     * @brief Creates a filter including all regions
+     */
+    RegionFilter() = default;
+
+    /**
+     * @brief Parses the rules of a Score-P filter file
+     * @param path Path of the filter file
+     * @return The filter
+     * @throws std::invalid_argument if the file cannot be read or is malformed
+     */
+    static RegionFilter fromFile(const QString &path);
+
+    /**
+     * @brief Parses rules in the format of a Score-P filter file
+     * @param rules The rules
+     * @return The filter
+     * @throws std::invalid_argument if the rules are malformed
+     */
+    static RegionFilter fromRules(const QString &rules);
+
+    /**
+     * @brief Appends rules excluding regions whose name matches one of the patterns
+     * @param patterns Wildcard patterns of region names
+     */
+    void exclude(const QStringList &patterns);
+
+    /**
+     * @brief Returns whether the filter has any rules
+     * @return True if all regions are included
+     */
+    [[nodiscard]] bool isEmpty() const;
+
+    /**
+     * @brief Returns whether a region is excluded
+     * @param region The region
+     * @return True if the events of the region should be skipped
+     */
+    [[nodiscard]] bool isExcluded(const otf2::definition::region &region) const;
+
+private:
+    /**
+     * A single pattern of an `EXCLUDE` or `INCLUDE` rule
+     */
+    struct Rule {
+        bool exclude;
+        bool mangled;
+        QRegularExpression pattern;
+    };
+
+    /**
+     * Evaluates a block of rules, the last matching rule wins
+     */
+    static bool excludedBy(const std::vector<Rule> &rules, const QString &name, const QString &mangledName);
+
+    std::vector<Rule> regionRules;
+    std::vector<Rule> fileRules;
+};
+
+
+#endif //MOTIV_REGIONFILTER_HPP
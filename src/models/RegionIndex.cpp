@@ -0,0 +1,109 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "RegionIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_map>
+
+static std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return std::tolower(c); });
+    return text;
+}
+
+static bool startsBefore(const Slot *lhs, const Slot *rhs) {
+    return lhs->startTime < rhs->startTime || (lhs->startTime == rhs->startTime && lhs < rhs);
+}
+
+RegionIndex::RegionIndex(Trace *trace) {
+    std::unordered_map<uint64_t, size_t> indices;
+    for (const auto &[group, slots]: trace->getSlots()) {
+        for (const auto &slot: slots) {
+            auto [it, inserted] = indices.try_emplace(slot->region->ref().get(), regions.size());
+            if (inserted) {
+                regions.push_back({slot->region, toLower(slot->region->name().str())});
+            }
+            regions[it->second].occurrences.push_back(slot);
+        }
+    }
+
+    std::sort(regions.begin(), regions.end(), [](const Region &lhs, const Region &rhs) {
+        return lhs.lowerName < rhs.lowerName;
+    });
+    for (auto &region: regions) {
+        std::sort(region.occurrences.begin(), region.occurrences.end(), startsBefore);
+    }
+}
+
+std::vector<RegionMatch> RegionIndex::search(const std::string &query) const {
+    std::vector<RegionMatch> matches;
+    if (query.empty()) return matches;
+
+    auto lowerQuery = toLower(query);
+    auto prefixBegin = std::lower_bound(regions.begin(), regions.end(), lowerQuery,
+                                        [](const Region &region, const std::string &q) { return region.lowerName < q; });
+    auto prefixEnd = prefixBegin;
+    while (prefixEnd != regions.end() && prefixEnd->lowerName.starts_with(lowerQuery)) {
+        ++prefixEnd;
+    }
+
+    auto add = [&matches, this](std::vector<Region>::const_iterator it) {
+        matches.push_back({static_cast<size_t>(it - regions.begin()), it->region, it->occurrences.size()});
+    };
+    for (auto it = prefixBegin; it != prefixEnd; ++it) {
+        add(it);
+    }
+    for (auto it = regions.begin(); it != regions.end(); ++it) {
+        if (it >= prefixBegin && it < prefixEnd) continue;
+        if (it->lowerName.find(lowerQuery) != std::string::npos) add(it);
+    }
+    return matches;
+}
+
+Slot *RegionIndex::next(size_t index, types::TraceTime after) const {
+    const auto &occurrences = regions[index].occurrences;
+    auto it = std::upper_bound(occurrences.begin(), occurrences.end(), after,
+                               [](types::TraceTime time, const Slot *slot) { return time < slot->startTime; });
+    return it != occurrences.end() ? *it : nullptr;
+}
+
+Slot *RegionIndex::previous(size_t index, types::TraceTime before) const {
+    const auto &occurrences = regions[index].occurrences;
+    auto it = std::lower_bound(occurrences.begin(), occurrences.end(), before,
+                               [](const Slot *slot, types::TraceTime time) { return slot->startTime < time; });
+    return it != occurrences.begin() ? *std::prev(it) : nullptr;
+}
+
+size_t RegionIndex::position(size_t index, const Slot *slot) const {
+    const auto &occurrences = regions[index].occurrences;
+    auto it = std::lower_bound(occurrences.begin(), occurrences.end(), slot, startsBefore);
+    return static_cast<size_t>(it - occurrences.begin());
+}
+
+Slot *RegionIndex::at(size_t index, size_t position) const {
+    const auto &occurrences = regions[index].occurrences;
+    return position < occurrences.size() ? occurrences[position] : nullptr;
+}
+
+size_t RegionIndex::memoryUsage() const {
+    auto bytes = sizeof(RegionIndex) + regions.capacity() * sizeof(Region);
+    for (const auto &region: regions) {
+        bytes += region.lowerName.capacity() + region.occurrences.capacity() * sizeof(Slot *);
+    }
+    return bytes;
+}
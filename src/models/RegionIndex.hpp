@@ -0,0 +1,118 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_REGIONINDEX_HPP
+#define MOTIV_REGIONINDEX_HPP
+
+
+#include <string>
+#include <vector>
+
+#include "Trace.hpp"
+
+/**
+ * @brief A region matching a search with its number of calls
+ */
+struct RegionMatch {
+    /**
+     * Index of the region in the RegionIndex
+     */
+    size_t index;
+    otf2::definition::region *region;
+    size_t count;
+};
+
+/**
+ * @brief Index of region names and the calls of each region
+ *
+ * Region names are kept sorted in lower case, so names starting with a query are found by binary search. Names
+ * containing the query elsewhere are found by a scan over the distinct names, which are far fewer than the calls.
+ * The calls of each region are ordered by start, so the next or previous call from any point in time is found by
+ * binary search.
+ */
+class RegionIndex {
+public:
+    /**
+     * @brief Indexes the regions and calls of a trace
+     * @param trace The trace
+     */
+    explicit RegionIndex(Trace *trace);
+
+    /**
+     * @brief Finds the regions whose name contains the query, ignoring case
+     * @param query The searched text
+     * @return Regions starting with the query first, then the other matches, each ordered by name
+     */
+    [[nodiscard]] std::vector<RegionMatch> search(const std::string &query) const;
+
+    /**
+     * @brief Returns the first call of a region starting after a point in time
+     * @param index Index of the region as returned by search()
+     * @param after The point in time
+     * @return The call or nullptr if there is none
+     */
+    [[nodiscard]] Slot *next(size_t index, types::TraceTime after) const;
+
+    /**
+     * @brief Returns the last call of a region starting before a point in time
+     * @param index Index of the region as returned by search()
+     * @param before The point in time
+     * @return The call or nullptr if there is none
+     */
+    [[nodiscard]] Slot *previous(size_t index, types::TraceTime before) const;
+
+    /**
+     * @brief Returns the position of a call among the calls of its region
+     * @param index Index of the region as returned by search()
+     * @param slot A call of the region
+     * @return The zero based position ordered by start
+     */
+    [[nodiscard]] size_t position(size_t index, const Slot *slot) const;
+
+    /**
+     * @brief Returns a call of a region by its position
+     * @param index Index of the region as returned by search()
+     * @param position The zero based position ordered by start
+     * @return The call or nullptr if the position is out of range
+     */
+    [[nodiscard]] Slot *at(size_t index, size_t position) const;
+
+    /**
+     * @brief Returns the bytes used by the index
+     * @return The used bytes
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    struct Region {
+        otf2::definition::region *region;
+        std::string lowerName;
+        /**
+         * Calls ordered by start
+         */
+        std::vector<Slot *> occurrences;
+    };
+
+private:
+    /**
+     * Ordered by lowerName
+     */
+    std::vector<Region> regions;
+};
+
+
+#endif //MOTIV_REGIONINDEX_HPP
@@ -69,6 +69,21 @@ public:
      */
     otf2::definition::region *region;
 
+    /**
+     * @brief Call depth of the slot on its location, slots not called from another slot have depth 0
+     */
+    uint32_t depth = 0;
+
+    /**
+     * @brief Node of the call path of the slot in the CallingContextTree of the trace, 0 if it is not known
+     */
+    uint32_t callPath = 0;
+
+    /**
+     * @brief Slot this slot was called from, nullptr if it was not called from another slot
+     */
+    Slot *parent = nullptr;
+
     /**
      *
      *  @brief Returns the kind of the current Slot object.
@@ -55,6 +55,10 @@ Range<CollectiveCommunicationEvent *> SubTrace::getCollectiveCommunications() {
     return collectiveCommunications_;
 }
 
+Range<CommunicationBundle *> SubTrace::getCommunicationBundles() {
+    return communicationBundles_;
+}
+
 otf2::chrono::duration SubTrace::getStartTime() const {
     return startTime_;
 }
@@ -74,6 +78,9 @@ namespace accessors {
     const TimeAccessor<Communication *> communicationStart = [](
         const Communication *e) { return e->getStartEvent()->getStartTime(); };
     const TimeAccessor<Communication *> communicationEnd = [](const Communication *e) { return e->getEndEvent()->getEndTime(); };
+
+    const TimeAccessor<CommunicationBundle *> communicationBundleStart = &CommunicationBundle::getStartTime;
+    const TimeAccessor<CommunicationBundle *> communicationBundleEnd = &CommunicationBundle::getEndTime;
 };
 
 template<typename T>
@@ -106,6 +113,8 @@ Trace *SubTrace::subtrace(otf2::chrono::duration from, otf2::chrono::duration to
                                                                                 accessors::communicationEventEnd);
 
     auto trace = new SubTrace(newSlots, newCommunications, newCollectiveCommunications, to - from, from);
+    trace->communicationBundles_ = subRange(getCommunicationBundles(), from, to, accessors::communicationBundleStart,
+                                            accessors::communicationBundleEnd);
 
     return trace;
 }
@@ -53,6 +53,11 @@ public:
      */
     [[nodiscard]] Range<CollectiveCommunicationEvent*> getCollectiveCommunications() override;
 
+    /**
+     * @copydoc Trace::getCommunicationBundles()
+     */
+    [[nodiscard]] Range<CommunicationBundle*> getCommunicationBundles() override;
+
 
     /**
      * @copydoc Trace::getStartTime()
@@ -85,6 +90,11 @@ protected:
      */
     Range<CollectiveCommunicationEvent*> collectiveCommunications_;
 
+    /**
+     * Backing field for communication bundles of this subtrace
+     */
+    Range<CommunicationBundle*> communicationBundles_;
+
     /**
      * Backing field for the runtime of this subtrace
      */
@@ -24,6 +24,7 @@
 #include "Slot.hpp"
 #include "src/models/communication/Communication.hpp"
 #include "src/models/communication/CollectiveCommunicationEvent.hpp"
+#include "src/models/communication/CommunicationBundle.hpp"
 #include "Range.hpp"
 #include "TimedElement.hpp"
 
@@ -78,6 +79,17 @@ public:
      */
     [[nodiscard]] virtual Range<CollectiveCommunicationEvent*> getCollectiveCommunications() = 0;
 
+    /**
+     * @brief Returns bundles of communications of the current trace.
+     *
+     * This pure virtual function returns bundles of communications too close to each other to be shown individually.
+     * Communications contained in a bundle are not returned by getCommunications(). The function has to be
+     * implemented in the derived classes.
+     *
+     * @return bundles of communications of the current trace.
+     */
+    [[nodiscard]] virtual Range<CommunicationBundle*> getCommunicationBundles() = 0;
+
     /**
      * @brief Returns the runtime of the current trace.
      *
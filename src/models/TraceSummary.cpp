@@ -0,0 +1,236 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TraceSummary.hpp"
+
+#include <algorithm>
+
+/**
+ * Kinds of the exclusive time kept per bin, in the order their slots are placed within a bin
+ */
+static const std::array<SlotKind, 3> SUMMARY_KINDS = {MPI, OpenMP, Plain};
+
+TraceSummary::~TraceSummary() {
+    for (const auto &[ref, region]: regions) {
+        delete region.definition;
+    }
+    for (const auto &[ref, location]: locations) {
+        delete location.definition;
+    }
+    for (const auto &[ref, rank]: ranks) {
+        delete rank.definition;
+    }
+}
+
+void TraceSummary::enter(const otf2::definition::location &location, const otf2::definition::region &region,
+                         types::TraceTime time) {
+    auto [it, inserted] = regions.try_emplace(region.ref().get(), Region{nullptr, 0});
+    if (inserted) {
+        it->second.definition = new otf2::definition::region(region);
+        // The kind is derived from the region name like for any other slot
+        Slot probe(types::TraceTime(0), types::TraceTime(0), nullptr, it->second.definition);
+        it->second.kind = std::find(SUMMARY_KINDS.begin(), SUMMARY_KINDS.end(), probe.getKind()) - SUMMARY_KINDS.begin();
+    }
+
+    auto &summary = locationFor(location);
+    if (!summary.stack.empty()) {
+        addExclusive(summary, summary.stack.back().region, summary.lastEvent, time);
+    }
+    summary.stack.push_back({&it->second, time, types::TraceTime(0)});
+    summary.lastEvent = time;
+}
+
+void TraceSummary::leave(const otf2::definition::location &location, types::TraceTime time) {
+    auto &summary = locationFor(location);
+    if (summary.stack.empty()) return;
+
+    addExclusive(summary, summary.stack.back().region, summary.lastEvent, time);
+    summary.lastEvent = time;
+
+    auto frame = summary.stack.back();
+    summary.stack.pop_back();
+    auto inclusive = time - frame.start;
+    if (!summary.stack.empty()) {
+        summary.stack.back().childTime += inclusive;
+    }
+
+    cover(time);
+    auto &block = ranks[summary.rank].blocks[binOf(frame.start) / (SUMMARY_BINS / SUMMARY_PROFILE_BLOCKS)];
+    auto &regionProfile = block[frame.region->definition->ref().get()];
+    regionProfile.region = frame.region->definition;
+    regionProfile.calls++;
+    regionProfile.inclusive += inclusive;
+    regionProfile.exclusive += inclusive - frame.childTime;
+    regionProfile.min = std::min(regionProfile.min, inclusive);
+    regionProfile.max = std::max(regionProfile.max, inclusive);
+}
+
+TraceSummary::Location &TraceSummary::locationFor(const otf2::definition::location &location) {
+    auto it = locations.find(location.ref().get());
+    if (it != locations.end()) {
+        return it->second;
+    }
+
+    auto rank = location.location_group().ref().get();
+    auto [rankIt, inserted] = ranks.try_emplace(rank, Rank{nullptr, {}});
+    if (inserted) {
+        rankIt->second.definition = new otf2::definition::location_group(location.location_group());
+        rankIt->second.blocks.resize(SUMMARY_PROFILE_BLOCKS);
+    }
+
+    Location summary{new otf2::definition::location(location), rank, {}, types::TraceTime(0), {}};
+    summary.bins.resize(SUMMARY_BINS);
+    return locations.emplace(location.ref().get(), std::move(summary)).first->second;
+}
+
+void TraceSummary::addExclusive(Location &location, const Region *region, types::TraceTime from,
+                                types::TraceTime to) {
+    if (to <= from) return;
+
+    cover(to);
+    auto kind = region->kind;
+    for (auto bin = binOf(from); bin <= binOf(to - types::TraceTime(1)); bin++) {
+        auto binBegin = binWidth_ * bin;
+        auto overlap = std::min(to, binBegin + binWidth_) - std::max(from, binBegin);
+        auto &summary = location.bins[bin];
+        summary.time[kind] += overlap;
+        if (overlap > summary.dominantTime[kind]) {
+            summary.dominant[kind] = region;
+            summary.dominantTime[kind] = overlap;
+        }
+    }
+}
+
+void TraceSummary::cover(types::TraceTime time) {
+    while (time >= binWidth_ * SUMMARY_BINS) {
+        // Neighbouring bins and blocks are merged, the second half is cleared for the time to come
+        for (auto &[ref, location]: locations) {
+            for (size_t i = 0; i < SUMMARY_BINS / 2; i++) {
+                auto &merged = location.bins[i];
+                merged = location.bins[2 * i];
+                const auto &second = location.bins[2 * i + 1];
+                for (size_t kind = 0; kind < SUMMARY_KINDS.size(); kind++) {
+                    merged.time[kind] += second.time[kind];
+                    if (second.dominantTime[kind] > merged.dominantTime[kind]) {
+                        merged.dominant[kind] = second.dominant[kind];
+                        merged.dominantTime[kind] = second.dominantTime[kind];
+                    }
+                }
+            }
+            std::fill(location.bins.begin() + SUMMARY_BINS / 2, location.bins.end(), Bin());
+        }
+        for (auto &[ref, rank]: ranks) {
+            for (size_t i = 0; i < SUMMARY_PROFILE_BLOCKS / 2; i++) {
+                auto merged = std::move(rank.blocks[2 * i]);
+                for (const auto &[regionRef, regionProfile]: rank.blocks[2 * i + 1]) {
+                    merged[regionRef].merge(regionProfile);
+                }
+                rank.blocks[i] = std::move(merged);
+            }
+            for (size_t i = SUMMARY_PROFILE_BLOCKS / 2; i < SUMMARY_PROFILE_BLOCKS; i++) {
+                rank.blocks[i].clear();
+            }
+        }
+        binWidth_ *= 2;
+    }
+}
+
+size_t TraceSummary::binOf(types::TraceTime time) const {
+    return std::min(static_cast<size_t>(time / binWidth_), static_cast<size_t>(SUMMARY_BINS - 1));
+}
+
+std::vector<Slot *> TraceSummary::createSlots() const {
+    std::vector<Slot *> slots;
+    for (const auto &[ref, location]: locations) {
+        for (size_t bin = 0; bin < SUMMARY_BINS; bin++) {
+            auto start = binWidth_ * bin;
+            for (size_t kind = 0; kind < SUMMARY_KINDS.size(); kind++) {
+                const auto &summary = location.bins[bin];
+                if (!summary.dominant[kind]) continue;
+
+                auto end = start + summary.time[kind];
+                slots.push_back(new Slot(start, end, location.definition, summary.dominant[kind]->definition));
+                start = end;
+            }
+        }
+    }
+    return slots;
+}
+
+ProfileResult TraceSummary::profile(types::TraceTime from, types::TraceTime to) const {
+    ProfileResult result;
+    auto blockWidth = binWidth_ * (SUMMARY_BINS / SUMMARY_PROFILE_BLOCKS);
+    for (const auto &[ref, rank]: ranks) {
+        Profile profile;
+        for (size_t i = 0; i < SUMMARY_PROFILE_BLOCKS; i++) {
+            auto blockBegin = blockWidth * i;
+            if (blockBegin > to) break;
+            if (blockBegin + blockWidth <= from) continue;
+
+            for (const auto &[regionRef, regionProfile]: rank.blocks[i]) {
+                profile[regionRef].merge(regionProfile);
+                result.total[regionRef].merge(regionProfile);
+            }
+        }
+        result.ranks.emplace_back(rank.definition, std::move(profile));
+    }
+    return result;
+}
+
+TraceSummary::Snapshot TraceSummary::snapshot(size_t maxRows) const {
+    Snapshot snapshot;
+    snapshot.binWidth = binWidth_;
+    auto rowCount = std::min(maxRows, locations.size());
+    snapshot.rows.resize(rowCount, std::vector<std::array<types::TraceTime, 3>>(SUMMARY_BINS));
+    snapshot.rowLocations.resize(rowCount);
+
+    size_t index = 0;
+    for (const auto &[ref, location]: locations) {
+        auto row = index++ * rowCount / locations.size();
+        snapshot.rowLocations[row]++;
+        for (size_t bin = 0; bin < SUMMARY_BINS; bin++) {
+            for (size_t kind = 0; kind < SUMMARY_KINDS.size(); kind++) {
+                snapshot.rows[row][bin][kind] += location.bins[bin].time[kind];
+            }
+        }
+    }
+    return snapshot;
+}
+
+types::TraceTime TraceSummary::binWidth() const {
+    return binWidth_;
+}
+
+size_t TraceSummary::locationCount() const {
+    return locations.size();
+}
+
+size_t TraceSummary::memoryUsage() const {
+    size_t bytes = regions.size() * (sizeof(Region) + sizeof(otf2::definition::region));
+    for (const auto &[ref, location]: locations) {
+        bytes += sizeof(Location) + sizeof(otf2::definition::location) + location.bins.capacity() * sizeof(Bin) +
+                 location.stack.capacity() * sizeof(Frame);
+    }
+    for (const auto &[ref, rank]: ranks) {
+        bytes += sizeof(Rank) + sizeof(otf2::definition::location_group);
+        for (const auto &block: rank.blocks) {
+            // Nodes of the map hold the key, the profile and three pointers
+            bytes += sizeof(Profile) + block.size() * (sizeof(Profile::value_type) + 3 * sizeof(void *));
+        }
+    }
+    return bytes;
+}
@@ -0,0 +1,200 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_TRACESUMMARY_HPP
+#define MOTIV_TRACESUMMARY_HPP
+
+
+#include <array>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "ProfileEngine.hpp"
+#include "Slot.hpp"
+
+/**
+ * Defines the number of time bins kept per location
+ */
+#define SUMMARY_BINS 1024
+
+/**
+ * Defines the number of blocks per rank whose profiles are kept, each block covers the same number of bins
+ */
+#define SUMMARY_PROFILE_BLOCKS 64
+
+/**
+ * @brief Accumulates enter and leave events into fixed size time bins and profiles without keeping the calls
+ *
+ * Every location has SUMMARY_BINS bins of equal width holding the exclusive time spent in MPI, OpenMP and other
+ * regions, and for each of these kinds the region with the longest uninterrupted exclusive interval. The width is
+ * doubled and neighbouring bins are merged whenever an event lies beyond the last bin, so the trace length need not
+ * be known in advance. Calls are added to the profile of the block of their rank they start in.
+ *
+ * The memory used is bounded by the number of locations times SUMMARY_BINS and does not depend on the number of events.
+ */
+class TraceSummary {
+public:
+    /**
+     * @brief Copy of the bins with locations combined into a limited number of rows
+     */
+    struct Snapshot {
+        /**
+         * Width of the bins
+         */
+        types::TraceTime binWidth{1};
+
+        /**
+         * Exclusive MPI, OpenMP and other time per row and bin, summed over the locations of the row
+         */
+        std::vector<std::vector<std::array<types::TraceTime, 3>>> rows;
+
+        /**
+         * Number of locations combined in each row
+         */
+        std::vector<size_t> rowLocations;
+    };
+
+    TraceSummary() = default;
+
+    ~TraceSummary();
+
+    // Slots created by the summary reference its definitions
+    TraceSummary(const TraceSummary &) = delete;
+    TraceSummary &operator=(const TraceSummary &) = delete;
+
+    /**
+     * @brief Adds the enter event of a region
+     * @param location The location of the event
+     * @param region The entered region
+     * @param time Time of the event relative to the program start
+     */
+    void enter(const otf2::definition::location &location, const otf2::definition::region &region,
+               types::TraceTime time);
+
+    /**
+     * @brief Adds the leave event of the region entered last on a location
+     * @param location The location of the event
+     * @param time Time of the event relative to the program start
+     */
+    void leave(const otf2::definition::location &location, types::TraceTime time);
+
+    /**
+     * @brief Creates slots approximating the trace at the resolution of the bins
+     *
+     * For every bin and kind with exclusive time a slot of that length is created, named after the dominant region
+     * of the kind. The slots of a bin are placed one after another from its start. The caller owns the slots, the
+     * summary owns their locations and regions and must outlive them.
+     * @return The slots
+     */
+    [[nodiscard]] std::vector<Slot *> createSlots() const;
+
+    /**
+     * @brief Computes the profile of a time window
+     *
+     * The profile contains the calls starting in the blocks overlapping the window, calls are not clipped to it.
+     * @param from Start of the window
+     * @param to End of the window
+     * @return The profile per rank and for all ranks
+     */
+    [[nodiscard]] ProfileResult profile(types::TraceTime from, types::TraceTime to) const;
+
+    /**
+     * @brief Copies the bins, combining neighbouring locations so that there are at most @c maxRows rows
+     * @param maxRows Maximum number of rows
+     * @return The snapshot
+     */
+    [[nodiscard]] Snapshot snapshot(size_t maxRows) const;
+
+    /**
+     * @brief Returns the current width of the bins
+     * @return Duration covered by a single bin
+     */
+    [[nodiscard]] types::TraceTime binWidth() const;
+
+    /**
+     * @brief Returns the number of locations
+     * @return The number of locations with events
+     */
+    [[nodiscard]] size_t locationCount() const;
+
+    /**
+     * @brief Returns an estimate of the heap memory used by the summary
+     * @return The number of bytes
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    struct Region {
+        otf2::definition::region *definition;
+        size_t kind;
+    };
+
+    struct Frame {
+        const Region *region;
+        types::TraceTime start;
+        types::TraceTime childTime;
+    };
+
+    struct Bin {
+        std::array<types::TraceTime, 3> time{};
+        std::array<const Region *, 3> dominant{};
+        std::array<types::TraceTime, 3> dominantTime{};
+    };
+
+    struct Location {
+        otf2::definition::location *definition;
+        uint64_t rank;
+        std::vector<Frame> stack;
+        types::TraceTime lastEvent{0};
+        std::vector<Bin> bins;
+    };
+
+    struct Rank {
+        otf2::definition::location_group *definition;
+        std::vector<Profile> blocks;
+    };
+
+    /**
+     * Returns the summary of a location, creating it on its first event
+     */
+    Location &locationFor(const otf2::definition::location &location);
+
+    /**
+     * Adds exclusive time of a region to the bins of a location
+     */
+    void addExclusive(Location &location, const Region *region, types::TraceTime from, types::TraceTime to);
+
+    /**
+     * Coarsens the bins until they cover a point in time
+     */
+    void cover(types::TraceTime time);
+
+    /**
+     * Returns the bin a point in time falls into
+     */
+    [[nodiscard]] size_t binOf(types::TraceTime time) const;
+
+    // Node based containers keep the pointers to their elements stable
+    std::unordered_map<uint64_t, Region> regions;
+    std::map<uint64_t, Location> locations;
+    std::map<uint64_t, Rank> ranks;
+    types::TraceTime binWidth_{1};
+};
+
+
+#endif //MOTIV_TRACESUMMARY_HPP
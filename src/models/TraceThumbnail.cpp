@@ -0,0 +1,121 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TraceThumbnail.hpp"
+
+#include <otf2/otf2.h>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+
+/**
+ * Index of a kind in the samples of a row
+ */
+static size_t kindIndex(SlotKind kind) {
+    switch (kind) {
+        case ::MPI:
+            return 0;
+        case ::OpenMP:
+            return 1;
+        default:
+            return 2;
+    }
+}
+
+/**
+ * Reads a single thumbnail, returns false if it is no region thumbnail or cannot be read
+ */
+static bool readThumbnail(OTF2_ThumbReader *thumbReader, const std::map<uint64_t, SlotKind> &regionKinds,
+                          TraceThumbnail::Row &row) {
+    char *name = nullptr;
+    char *description = nullptr;
+    OTF2_ThumbnailType type;
+    uint32_t sampleCount = 0;
+    uint32_t metricCount = 0;
+    uint64_t *refs = nullptr;
+    if (OTF2_ThumbReader_GetHeader(thumbReader, &name, &description, &type, &sampleCount, &metricCount, &refs) !=
+        OTF2_SUCCESS) {
+        return false;
+    }
+    // The header strings and references are allocated by OTF2 and owned by the caller
+    std::unique_ptr<char, decltype(&free)> nameOwner(name, &free);
+    std::unique_ptr<char, decltype(&free)> descriptionOwner(description, &free);
+    std::unique_ptr<uint64_t, decltype(&free)> refsOwner(refs, &free);
+    if (type != OTF2_THUMBNAIL_TYPE_REGION || sampleCount == 0) {
+        return false;
+    }
+
+    std::vector<size_t> kinds(metricCount);
+    for (uint32_t i = 0; i < metricCount; i++) {
+        auto it = regionKinds.find(refs[i]);
+        kinds[i] = kindIndex(it != regionKinds.end() ? it->second : Plain);
+    }
+
+    row.name = name ? name : "";
+    row.samples.resize(sampleCount);
+    row.baselines.resize(sampleCount);
+    std::vector<uint64_t> values(metricCount);
+    for (uint32_t sample = 0; sample < sampleCount; sample++) {
+        if (OTF2_ThumbReader_ReadSample(thumbReader, &row.baselines[sample], metricCount, values.data()) !=
+            OTF2_SUCCESS) {
+            return false;
+        }
+        for (uint32_t i = 0; i < metricCount; i++) {
+            row.samples[sample][kinds[i]] += values[i];
+        }
+    }
+    return true;
+}
+
+TraceThumbnail *TraceThumbnail::fromArchive(const std::string &anchorPath,
+                                            const std::map<uint64_t, SlotKind> &regionKinds) {
+    std::unique_ptr<OTF2_Reader, decltype(&OTF2_Reader_Close)> reader(OTF2_Reader_Open(anchorPath.c_str()),
+                                                                      &OTF2_Reader_Close);
+    if (!reader || OTF2_Reader_SetSerialCollectiveCallbacks(reader.get()) != OTF2_SUCCESS) {
+        return nullptr;
+    }
+
+    uint32_t count = 0;
+    if (OTF2_Reader_GetNumberOfThumbnails(reader.get(), &count) != OTF2_SUCCESS || count == 0) {
+        return nullptr;
+    }
+
+    auto thumbnail = std::make_unique<TraceThumbnail>();
+    for (uint32_t i = 0; i < count; i++) {
+        auto thumbReader = OTF2_Reader_GetThumbReader(reader.get(), i);
+        if (!thumbReader) continue;
+
+        Row row;
+        if (readThumbnail(thumbReader, regionKinds, row)) {
+            thumbnail->rows_.push_back(std::move(row));
+        }
+        OTF2_Reader_CloseThumbReader(reader.get(), thumbReader);
+    }
+    return thumbnail->rows_.empty() ? nullptr : thumbnail.release();
+}
+
+const std::vector<TraceThumbnail::Row> &TraceThumbnail::rows() const {
+    return rows_;
+}
+
+size_t TraceThumbnail::sampleCount() const {
+    size_t count = 0;
+    for (const auto &row: rows_) {
+        count = std::max(count, row.samples.size());
+    }
+    return count;
+}
@@ -0,0 +1,88 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_TRACETHUMBNAIL_HPP
+#define MOTIV_TRACETHUMBNAIL_HPP
+
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Slot.hpp"
+
+/**
+ * @brief Region thumbnails stored in an OTF2 archive
+ *
+ * OTF2 archives may contain thumbnails, which are written alongside the events and summarize the activity of regions in
+ * a fixed number of samples evenly spread over the runtime of the trace. Each sample holds a value per referenced
+ * region and a baseline the values are relative to. Only thumbnails of type region are read, the values are summed
+ * per kind of region in the order MPI, OpenMP, other.
+ *
+ * Reading thumbnails touches neither the definitions of locations nor any events.
+ */
+class TraceThumbnail {
+public:
+    /**
+     * @brief A single region thumbnail
+     */
+    struct Row {
+        /**
+         * Name of the thumbnail as stored in the archive
+         */
+        std::string name;
+
+        /**
+         * Summed values of MPI, OpenMP and other regions per sample
+         */
+        std::vector<std::array<uint64_t, 3>> samples;
+
+        /**
+         * Baselines of the samples
+         */
+        std::vector<uint64_t> baselines;
+    };
+
+    /**
+     * @brief Reads the region thumbnails of an archive
+     * @param anchorPath Path of the anchor file of the archive
+     * @param regionKinds Kinds of the regions by region reference, regions not listed are counted as other regions
+     * @return The thumbnails, ownership is transferred to the caller, or nullptr if the archive has no region thumbnails
+     * or they cannot be read
+     */
+    static TraceThumbnail *fromArchive(const std::string &anchorPath, const std::map<uint64_t, SlotKind> &regionKinds);
+
+    /**
+     * @brief Returns the region thumbnails
+     * @return The thumbnails, at least one
+     */
+    [[nodiscard]] const std::vector<Row> &rows() const;
+
+    /**
+     * @brief Returns the number of samples of the thumbnail with the most samples
+     * @return The number of samples
+     */
+    [[nodiscard]] size_t sampleCount() const;
+
+private:
+    std::vector<Row> rows_;
+};
+
+
+#endif //MOTIV_TRACETHUMBNAIL_HPP
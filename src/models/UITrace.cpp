@@ -19,15 +19,22 @@
 #include "src/utils.hpp"
 
 #include <QDebug>
+#include <algorithm>
+#include <iterator>
+#include <tuple>
+#include <unordered_map>
 
 UITrace::UITrace(std::map<otf2::definition::location_group *, std::vector<Slot *>, LocationGroupCmp> slotsVec,
                  const Range<Communication *> &communications,
+                 std::vector<CommunicationBundle *> communicationBundles,
                  const Range<CollectiveCommunicationEvent *> &collectiveCommunications,
                  const otf2::chrono::duration &runtime, const otf2::chrono::duration &startTime,
-                 const otf2::chrono::duration &timePerPx) :
+                 const otf2::chrono::duration &timePerPx, const ViewSettings &settings) :
     SubTrace(),
-    timePerPx_(timePerPx) {
+    timePerPx_(timePerPx),
+    settings_(settings) {
     communications_ = communications;
+    communicationBundles_ = Range(communicationBundles);
     collectiveCommunications_ = collectiveCommunications;
     runtime_ = runtime;
     startTime_ = startTime;
@@ -36,66 +43,155 @@ UITrace::UITrace(std::map<otf2::definition::location_group *, std::vector<Slot *
         slots_.insert({item.first, Range(item.second)});
     }
 }
-UITrace *UITrace::forResolution(Trace *trace, int width) {
-    return forResolution(trace, trace->getRuntime() / width);
+
+otf2::chrono::duration UITrace::getTimePerPx() const {
+    return timePerPx_;
+}
+
+size_t UITrace::getAggregatedSlotCount() const {
+    return aggregatedSlots_.size();
+}
+
+size_t UITrace::getAggregatedCollectiveCount() const {
+    return aggregatedCollectives_.size();
+}
+
+bool UITrace::owns(const TimedElement *element) const {
+    if (auto slot = dynamic_cast<const Slot *>(element)) {
+        return std::find(aggregatedSlots_.begin(), aggregatedSlots_.end(), slot) != aggregatedSlots_.end();
+    }
+    if (auto collective = dynamic_cast<const CollectiveCommunicationEvent *>(element)) {
+        return std::find(aggregatedCollectives_.begin(), aggregatedCollectives_.end(), collective) !=
+               aggregatedCollectives_.end();
+    }
+    if (auto bundle = dynamic_cast<const CommunicationBundle *>(element)) {
+        return std::find(communicationBundles_.begin(), communicationBundles_.end(), bundle) !=
+               communicationBundles_.end();
+    }
+    return false;
+}
+
+UITrace::~UITrace() {
+    for (const auto &bundle: communicationBundles_) {
+        delete bundle;
+    }
+    for (const auto &slot: aggregatedSlots_) {
+        delete slot;
+    }
+    for (const auto &collective: aggregatedCollectives_) {
+        for (const auto &member: collective->getMembers()) {
+            delete member;
+        }
+        delete collective;
+    }
+}
+
+UITrace *UITrace::forResolution(Trace *trace, int width, const ViewSettings &settings, const CompiledFilter *filter) {
+    return forResolution(trace, trace->getRuntime() / width, settings, filter);
 }
 
-UITrace *UITrace::forResolution(Trace *trace, otf2::chrono::duration timePerPixel) {
+UITrace *UITrace::forResolution(Trace *trace, otf2::chrono::duration timePerPixel, const ViewSettings &settings,
+                                const CompiledFilter *filter) {
+    // A filter letting everything pass does not need to be checked
+    if (filter && filter->isTrivial()) {
+        filter = nullptr;
+    }
 
     // Optimize slots
-    auto minDuration = timePerPixel * MIN_SLOT_SIZE_PX;
+    auto minDuration = timePerPixel * settings.getMinSlotSizePx();
     std::map<otf2::definition::location_group *, std::vector<Slot *>, LocationGroupCmp> newSlots;
+    std::vector<Slot *> aggregatedSlots;
+    auto aggregate = [&aggregatedSlots](Slot *intervalStarter, std::map<SlotKind, std::vector<Slot *>> &stats) {
+        aggregatedSlots.push_back(aggregateSlots(intervalStarter, stats));
+        return aggregatedSlots.back();
+    };
+    std::vector<Slot *> passingSlots;
     for (const auto &item: trace->getSlots()) {
         auto locationGroup = item.first;
         auto slots = item.second;
-        auto newSlotsForRank = optimize<Slot, SlotKind>(
-            minDuration,
-            slots,
-            &Slot::getKind,
-            &UITrace::aggregateSlots);
+        if (filter) {
+            if (!filter->accepts(locationGroup)) continue;
+
+            // Filtered slots are dropped before aggregation so they neither cost time nor show up in aggregates
+            passingSlots.clear();
+            std::copy_if(slots.begin(), slots.end(), std::back_inserter(passingSlots),
+                         [filter](const Slot *slot) { return filter->accepts(slot); });
+            slots = Range<Slot *>(passingSlots.begin(), passingSlots.end());
+        }
+        if (!settings.isCallStackShown()) {
+            newSlots.insert({locationGroup, optimize<Slot, SlotKind>(minDuration, slots, &Slot::getKind, aggregate)});
+            continue;
+        }
 
+        // Slots in stacked lanes are only aggregated within their lane
+        std::vector<std::vector<Slot *>> lanes;
+        for (const auto &slot: slots) {
+            if (lanes.size() <= slot->depth) {
+                lanes.resize(slot->depth + 1);
+            }
+            lanes[slot->depth].push_back(slot);
+        }
+
+        std::vector<Slot *> newSlotsForRank;
+        for (auto &lane: lanes) {
+            Range<Slot *> laneRange(lane.begin(), lane.end());
+            auto newLane = optimize<Slot, SlotKind>(minDuration, laneRange, &Slot::getKind, aggregate);
+            newSlotsForRank.insert(newSlotsForRank.end(), newLane.begin(), newLane.end());
+        }
+        std::stable_sort(newSlotsForRank.begin(), newSlotsForRank.end(), [](const Slot *lhs, const Slot *rhs) {
+            return lhs->startTime < rhs->startTime;
+        });
         newSlots.insert({locationGroup, newSlotsForRank});
     }
 
 
     // Optimize communications.
-    // Optimization is done per rank of the starting event. This is beneficial if few 1:n communications occur.
-    // 1:n communications are only visible with a higher zoom level.
-    minDuration = timePerPixel * MIN_COMMUNICATION_SIZE_PX;
-    auto communicationsByRank = groupBy<Communication *, otf2::reference<otf2::definition::location_group>>(
-        trace->getCommunications(),
-        [](const Communication *c) { return c->getStartEvent()->getLocation()->location_group().ref(); },
-        [](const Communication *l, const Communication *r) {
-            auto rankL = l->getStartEvent()->getLocation()->location_group().ref();
-            auto rankR = r->getStartEvent()->getLocation()->location_group().ref();
-
-            if (rankL == rankR) {
-                return l->getStartTime() < r->getStartTime();
-            }
-
-            return rankL < rankR;
-        });
-
-    std::vector<Communication *> newCommunications;
-    for (const auto &item: communicationsByRank) {
-        auto communications = item.second;
-        auto newCommunicationsForRank = optimize<Communication>(
-            minDuration,
-            communications,
-            [](Communication *starter, std::vector<Communication *> &) { return starter; });
-        newCommunications.insert(newCommunications.end(), newCommunicationsForRank.begin(),
-                                 newCommunicationsForRank.end());
+    // Communications between the same ranks starting within the same bucket are bundled. With a higher zoom level the
+    // buckets get shorter and the communications are shown individually.
+    minDuration = timePerPixel * settings.getMinCommunicationSizePx();
+    auto communications = trace->getCommunications();
+    auto bundles = trace->getCommunicationBundles();
+    std::vector<Communication *> passingCommunications;
+    std::vector<CommunicationBundle *> passingBundles;
+    if (filter) {
+        std::copy_if(communications.begin(), communications.end(), std::back_inserter(passingCommunications),
+                     [filter](const Communication *communication) { return filter->accepts(communication); });
+        std::copy_if(bundles.begin(), bundles.end(), std::back_inserter(passingBundles),
+                     [filter](const CommunicationBundle *bundle) {
+                         return filter->accepts(bundle->getRepresentative());
+                     });
+        communications = Range<Communication *>(passingCommunications.begin(), passingCommunications.end());
+        bundles = Range<CommunicationBundle *>(passingBundles.begin(), passingBundles.end());
     }
+    auto [newCommunications, newBundles] = bundleCommunications(minDuration, communications, bundles);
 
 
     // Optimize collective communications
-    minDuration = timePerPixel * MIN_COLLECTIVE_EVENT_SIZE_PX;
-    auto newCollectiveCommunications = optimize<CollectiveCommunicationEvent>(minDuration,
-                                                                              trace->getCollectiveCommunications(),
-                                                                              &UITrace::aggregateCollectiveCommunications);
+    minDuration = timePerPixel * settings.getMinCollectiveEventSizePx();
+    std::vector<CollectiveCommunicationEvent *> aggregatedCollectives;
+    auto collectiveCommunications = trace->getCollectiveCommunications();
+    std::vector<CollectiveCommunicationEvent *> passingCollectives;
+    if (filter) {
+        std::copy_if(collectiveCommunications.begin(), collectiveCommunications.end(),
+                     std::back_inserter(passingCollectives),
+                     [filter](const CollectiveCommunicationEvent *event) { return filter->accepts(event); });
+        collectiveCommunications = Range<CollectiveCommunicationEvent *>(passingCollectives.begin(),
+                                                                         passingCollectives.end());
+    }
+    auto newCollectiveCommunications = optimize<CollectiveCommunicationEvent>(
+        minDuration,
+        collectiveCommunications,
+        [&aggregatedCollectives](CollectiveCommunicationEvent *intervalStarter,
+                                 std::vector<CollectiveCommunicationEvent *> &stats) {
+            aggregatedCollectives.push_back(aggregateCollectiveCommunications(intervalStarter, stats));
+            return aggregatedCollectives.back();
+        });
 
-    return new UITrace(newSlots, Range(newCommunications), Range(newCollectiveCommunications),
-                       trace->getRuntime(), trace->getStartTime(), timePerPixel);
+    auto uiTrace = new UITrace(newSlots, Range(newCommunications), newBundles, Range(newCollectiveCommunications),
+                               trace->getRuntime(), trace->getStartTime(), timePerPixel, settings);
+    uiTrace->aggregatedSlots_ = std::move(aggregatedSlots);
+    uiTrace->aggregatedCollectives_ = std::move(aggregatedCollectives);
+    return uiTrace;
 }
 
 template<class T>
@@ -157,6 +253,76 @@ std::vector<T *> UITrace::optimize(types::TraceTime minDuration,
     return newElements;
 }
 
+/**
+ * Key of the bundle a communication belongs to: the rank of its start event, the rank of its end event and the bucket
+ * its start time falls into
+ */
+typedef std::tuple<uint64_t, uint64_t, long> BundleKey;
+
+std::pair<std::vector<Communication *>, std::vector<CommunicationBundle *>>
+UITrace::bundleCommunications(types::TraceTime bucketDuration,
+                              Range<Communication *> communications,
+                              Range<CommunicationBundle *> bundles) {
+    std::vector<Communication *> newCommunications;
+    std::vector<CommunicationBundle *> newBundles;
+
+    if (bucketDuration.count() <= 0) {
+        // Every communication can be distinguished, existing bundles are copied as the new trace owns its bundles
+        newCommunications.assign(communications.begin(), communications.end());
+        for (const auto &bundle: bundles) {
+            newBundles.push_back(new CommunicationBundle(*bundle));
+        }
+        return {newCommunications, newBundles};
+    }
+
+    auto keyOf = [bucketDuration](const TimedElement *element, const Communication *representative) {
+        return BundleKey(representative->getStartEvent()->getLocation()->location_group().ref().get(),
+                         representative->getEndEvent()->getLocation()->location_group().ref().get(),
+                         element->getStartTime() / bucketDuration);
+    };
+
+    // Sorting by the key places all elements of a bundle next to each other
+    std::vector<std::tuple<BundleKey, Communication *, CommunicationBundle *>> elements;
+    for (const auto &communication: communications) {
+        elements.emplace_back(keyOf(communication, communication), communication, nullptr);
+    }
+    for (const auto &bundle: bundles) {
+        elements.emplace_back(keyOf(bundle, bundle->getRepresentative()), nullptr, bundle);
+    }
+    std::sort(elements.begin(), elements.end(), [](const auto &lhs, const auto &rhs) {
+        return std::get<0>(lhs) < std::get<0>(rhs);
+    });
+
+    auto it = elements.begin();
+    while (it != elements.end()) {
+        auto key = std::get<0>(*it);
+        auto bucketEnd = std::find_if(it, elements.end(), [&key](const auto &element) {
+            return std::get<0>(element) != key;
+        });
+
+        auto communication = std::get<1>(*it);
+        if (communication && bucketEnd - it == 1) {
+            // The communication is alone in its bucket and can be shown individually
+            newCommunications.push_back(communication);
+        } else {
+            auto bundle = communication ? new CommunicationBundle(communication)
+                                        : new CommunicationBundle(*std::get<2>(*it));
+            for (auto element = it + 1; element != bucketEnd; element++) {
+                if (std::get<1>(*element)) {
+                    bundle->add(std::get<1>(*element));
+                } else {
+                    bundle->add(std::get<2>(*element));
+                }
+            }
+            newBundles.push_back(bundle);
+        }
+
+        it = bucketEnd;
+    }
+
+    return {newCommunications, newBundles};
+}
+
 template<class T>
 requires std::is_base_of_v<TimedElement, T>
 static T *longest(std::vector<T *> ls) {
@@ -189,7 +355,10 @@ Slot *UITrace::aggregateSlots(const Slot *intervalStarter, std::map<SlotKind, st
     auto longestSlot = longest(*elements);
     auto intervalEnder = last(*elements);
 
-    return new Slot(intervalStarter->startTime, intervalEnder->endTime, longestSlot->location, longestSlot->region);
+    auto slot = new Slot(intervalStarter->startTime, intervalEnder->endTime, longestSlot->location, longestSlot->region);
+    slot->depth = longestSlot->depth;
+    slot->parent = longestSlot->parent;
+    return slot;
 }
 
 CollectiveCommunicationEvent *UITrace::aggregateCollectiveCommunications(
@@ -212,5 +381,47 @@ CollectiveCommunicationEvent *UITrace::aggregateCollectiveCommunications(
 }
 
 Trace *UITrace::subtrace(otf2::chrono::duration from, otf2::chrono::duration to) {
-    return forResolution(SubTrace::subtrace(from, to), timePerPx_);
+    auto subtrace = SubTrace::subtrace(from, to);
+    auto trace = forResolution(subtrace, timePerPx_, settings_);
+    delete subtrace;
+    trace->copyAggregatesOf(*this);
+    return trace;
+}
+
+void UITrace::copyAggregatesOf(const UITrace &source) {
+    // Aggregates of the source taken over unchanged still point into it and are replaced by copies
+    std::unordered_map<const Slot *, Slot *> slotCopies;
+    for (const auto &slot: source.aggregatedSlots_) {
+        slotCopies.emplace(slot, nullptr);
+    }
+    for (auto &[group, slots]: slots_) {
+        for (auto &slot: slots) {
+            auto it = slotCopies.find(slot);
+            if (it == slotCopies.end()) continue;
+
+            if (!it->second) {
+                it->second = new Slot(*slot);
+                aggregatedSlots_.push_back(it->second);
+            }
+            slot = it->second;
+        }
+    }
+
+    std::unordered_map<const CollectiveCommunicationEvent *, CollectiveCommunicationEvent *> collectiveCopies;
+    for (const auto &collective: source.aggregatedCollectives_) {
+        collectiveCopies.emplace(collective, nullptr);
+    }
+    for (auto &collective: collectiveCommunications_) {
+        auto it = collectiveCopies.find(collective);
+        if (it == collectiveCopies.end()) continue;
+
+        std::vector<CollectiveCommunicationEvent::Member *> members;
+        for (const auto &member: collective->getMembers()) {
+            members.push_back(new CollectiveCommunicationEvent::Member(*member));
+        }
+        it->second = new CollectiveCommunicationEvent(members, collective->getLocation(), collective->getCommunicator(),
+                                                      collective->getOperation(), collective->getRoot());
+        aggregatedCollectives_.push_back(it->second);
+        collective = it->second;
+    }
 }
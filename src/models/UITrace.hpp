@@ -23,27 +23,23 @@
 
 #include "SubTrace.hpp"
 #include "Range.hpp"
-
-/**
- * Defines the minimum size in pixels for a slot
- */
-#define MIN_SLOT_SIZE_PX 5
-
-/**
- * Defines the minimum size in pixels for a communication
- */
-#define MIN_COMMUNICATION_SIZE_PX 15
-
-/**
- * Defines the minimum size in pixels for a collective communication event
- */
-#define MIN_COLLECTIVE_EVENT_SIZE_PX 10
+#include "ViewSettings.hpp"
+#include "CompiledFilter.hpp"
 
 /**
  * @brief Trace facilitating a subtrace optimized for rendering
  *
- * Slots that would be rendered smaller than `MIN_SLOT_SIZE_PX` pixels are grouped together to a single slot.
- * Instead of all slots that fit inside `MIN_SLOT_SIZE_PX` the longest slot with the most important kind is shown.
+ * Slots that would be rendered smaller than ViewSettings::getMinSlotSizePx() pixels are grouped together to a single
+ * slot. Instead of all slots that fit inside this size the longest slot with the most important kind is shown.
+ * Collective communications are thinned out analogously. Communications between the same ranks starting within
+ * ViewSettings::getMinCommunicationSizePx() pixels are combined into a CommunicationBundle. Only communications that
+ * are alone in their bucket are kept individually.
+ *
+ * Elements not passing the filter are dropped before they are grouped, so aggregated slots only represent elements that
+ * would be visible.
+ *
+ * A UITrace owns the bundles, slots and collective communications it creates. Traces derived from it by subtrace()
+ * copy the aggregates they take over unchanged, so they do not depend on the UITrace they were derived from.
  */
 class UITrace : public SubTrace {
 private:
@@ -52,18 +48,48 @@ private:
      *
      * @param slotsVec vectors of grouped slots
      * @param communications range of communications
+     * @param communicationBundles bundles of communications, ownership is transferred to the new instance
      * @param collectiveCommunications range of collective communications
      * @param runtime runtime of the trace
      * @param startTime starttime of the trace
      * @param timePerPx duration that fits into one pixel
+     * @param settings settings defining the minimum sizes of elements
      */
     UITrace(std::map<otf2::definition::location_group *, std::vector<Slot *>, LocationGroupCmp> slotsVec,
             const Range<Communication *> &communications,
+            std::vector<CommunicationBundle *> communicationBundles,
             const Range<CollectiveCommunicationEvent *> &collectiveCommunications,
             const otf2::chrono::duration &runtime, const otf2::chrono::duration &startTime,
-            const otf2::chrono::duration &timePerPx);
+            const otf2::chrono::duration &timePerPx, const ViewSettings &settings);
 
 public:
+    ~UITrace() override;
+
+    /**
+     * Returns the duration a single pixel represents in this trace
+     * @return The duration of a single pixel
+     */
+    [[nodiscard]] otf2::chrono::duration getTimePerPx() const;
+
+    /**
+     * Returns the number of slots created by aggregating short slots
+     * @return The number of aggregated slots
+     */
+    [[nodiscard]] size_t getAggregatedSlotCount() const;
+
+    /**
+     * Returns whether an element was created by this trace and is deleted together with it
+     * @param element The element
+     * @return True if the element is an aggregate or bundle of this trace
+     */
+    [[nodiscard]] bool owns(const TimedElement *element) const;
+
+    /**
+     * Returns the number of collective communications created by aggregating short ones
+     * @return The number of aggregated collective communications
+     */
+    [[nodiscard]] size_t getAggregatedCollectiveCount() const;
+
     /**
      * Wraps a trace into a UITrace optimized for rendering performance.
      *
@@ -71,9 +97,12 @@ public:
      *
      * @param trace original trace to be optimized
      * @param timePerPixel duration that fits into one pixel
+     * @param settings settings defining the minimum sizes in pixels of elements
+     * @param filter filter elements have to pass, nullptr keeps all elements
      * @return the UITrace wrapping the original trace
      */
-    static UITrace *forResolution(Trace *trace, otf2::chrono::duration timePerPixel);
+    static UITrace *forResolution(Trace *trace, otf2::chrono::duration timePerPixel, const ViewSettings &settings,
+                                  const CompiledFilter *filter = nullptr);
 
 
     /**
@@ -83,9 +112,12 @@ public:
      *
      * @param trace original trace to be optimized
      * @param width the width in px for which the trace should be optimized
+     * @param settings settings defining the minimum sizes in pixels of elements
+     * @param filter filter elements have to pass, nullptr keeps all elements
      * @return the UITrace wrapping the original trace
      */
-    static UITrace *forResolution(Trace *trace, int width);
+    static UITrace *forResolution(Trace *trace, int width, const ViewSettings &settings,
+                                  const CompiledFilter *filter = nullptr);
 
     /**
      * @copydoc Trace::subtrace()
@@ -97,6 +129,27 @@ private:
      * Backing field. Stores the time that can be represented per pixel.
      */
     otf2::chrono::duration timePerPx_;
+
+    /**
+     * Backing field. Stores the settings the trace was optimized with.
+     */
+    ViewSettings settings_;
+
+    /**
+     * Slots created by aggregation, owned by this trace
+     */
+    std::vector<Slot *> aggregatedSlots_;
+
+    /**
+     * Collective communications created by aggregation, owned by this trace together with their members
+     */
+    std::vector<CollectiveCommunicationEvent *> aggregatedCollectives_;
+
+    /**
+     * Replaces the aggregates of @c source in this trace by copies owned by this trace
+     */
+    void copyAggregatesOf(const UITrace &source);
+
     /**
      * Aggregates collective communications in an interval into a new summarized collective communication event.
      *
@@ -109,6 +162,22 @@ private:
     aggregateCollectiveCommunications(const CollectiveCommunicationEvent *intervalStarter,
                                       std::vector<CollectiveCommunicationEvent *> &stats);
 
+    /**
+     * Combines communications that cannot be distinguished at the current resolution into bundles.
+     *
+     * Communications are grouped by the rank of their start event, the rank of their end event and the bucket of
+     * length @c bucketDuration their start time falls into. Existing bundles are merged into the bundles of their
+     * bucket as well.
+     * @param bucketDuration Duration of one bucket
+     * @param communications All communications to be rendered
+     * @param bundles Already existing bundles to be rendered
+     * @return The communications that are shown individually and newly created bundles
+     */
+    static std::pair<std::vector<Communication *>, std::vector<CommunicationBundle *>>
+    bundleCommunications(types::TraceTime bucketDuration,
+                         Range<Communication *> communications,
+                         Range<CommunicationBundle *> bundles);
+
     /**
      * Aggregates slots in an interval respecting stats
      *
@@ -32,3 +32,51 @@ Filter ViewSettings::getFilter() const {
 void ViewSettings::setFilter(Filter filter) {
     filter_ = filter;
 }
+
+int ViewSettings::getMinSlotSizePx() const {
+    return minSlotSizePx_;
+}
+
+void ViewSettings::setMinSlotSizePx(int minSlotSizePx) {
+    minSlotSizePx_ = minSlotSizePx;
+}
+
+int ViewSettings::getMinCommunicationSizePx() const {
+    return minCommunicationSizePx_;
+}
+
+void ViewSettings::setMinCommunicationSizePx(int minCommunicationSizePx) {
+    minCommunicationSizePx_ = minCommunicationSizePx;
+}
+
+int ViewSettings::getMinCollectiveEventSizePx() const {
+    return minCollectiveEventSizePx_;
+}
+
+void ViewSettings::setMinCollectiveEventSizePx(int minCollectiveEventSizePx) {
+    minCollectiveEventSizePx_ = minCollectiveEventSizePx;
+}
+
+bool ViewSettings::isCallStackShown() const {
+    return callStackShown_;
+}
+
+void ViewSettings::setCallStackShown(bool callStackShown) {
+    callStackShown_ = callStackShown;
+}
+
+bool ViewSettings::isWaitStatesShown() const {
+    return waitStatesShown_;
+}
+
+void ViewSettings::setWaitStatesShown(bool waitStatesShown) {
+    waitStatesShown_ = waitStatesShown;
+}
+
+bool ViewSettings::isCriticalPathShown() const {
+    return criticalPathShown_;
+}
+
+void ViewSettings::setCriticalPathShown(bool criticalPathShown) {
+    criticalPathShown_ = criticalPathShown;
+}
@@ -23,11 +23,27 @@
 
 #define SETTINGS_DEFAULT_ZOOM_QUOTIENT 25
 
+/**
+ * Defines the default minimum size in pixels for a slot
+ */
+#define SETTINGS_DEFAULT_MIN_SLOT_SIZE_PX 5
+
+/**
+ * Defines the default minimum size in pixels for a communication
+ */
+#define SETTINGS_DEFAULT_MIN_COMMUNICATION_SIZE_PX 15
+
+/**
+ * Defines the default minimum size in pixels for a collective communication event
+ */
+#define SETTINGS_DEFAULT_MIN_COLLECTIVE_EVENT_SIZE_PX 10
+
 /**
  * @brief The ViewSettings class encapsulates settings for the main view.
  *
- * It includes a filter to control which events are displayed and a zoom factor to control
- * the level of detail in the visualization.
+ * It includes a filter to control which events are displayed, a zoom factor to control
+ * the level of detail in the visualization and the minimum sizes in device pixels below which elements are
+ * aggregated for rendering (see UITrace).
  */
 class ViewSettings {
 public:
@@ -63,11 +79,115 @@ public:
      */
     void setZoomFactor(int zoomFactor);
 
+    /**
+     * @brief Returns the minimum size in device pixels for a slot.
+     *
+     * Slots that would be rendered smaller are aggregated.
+     * @return The minimum size in device pixels for a slot.
+     */
+    [[nodiscard]] int getMinSlotSizePx() const;
+
+    /**
+     * @brief Sets the minimum size in device pixels for a slot.
+     * @param minSlotSizePx The new minimum size in device pixels for a slot.
+     */
+    void setMinSlotSizePx(int minSlotSizePx);
+
+    /**
+     * @brief Returns the minimum size in device pixels for a communication.
+     *
+     * Communications that would be rendered closer to each other are aggregated.
+     * @return The minimum size in device pixels for a communication.
+     */
+    [[nodiscard]] int getMinCommunicationSizePx() const;
+
+    /**
+     * @brief Sets the minimum size in device pixels for a communication.
+     * @param minCommunicationSizePx The new minimum size in device pixels for a communication.
+     */
+    void setMinCommunicationSizePx(int minCommunicationSizePx);
+
+    /**
+     * @brief Returns the minimum size in device pixels for a collective communication event.
+     *
+     * Collective communication events that would be rendered smaller are aggregated.
+     * @return The minimum size in device pixels for a collective communication event.
+     */
+    [[nodiscard]] int getMinCollectiveEventSizePx() const;
+
+    /**
+     * @brief Sets the minimum size in device pixels for a collective communication event.
+     * @param minCollectiveEventSizePx The new minimum size in device pixels for a collective communication event.
+     */
+    void setMinCollectiveEventSizePx(int minCollectiveEventSizePx);
+
+    /**
+     * @brief Returns whether slots are drawn in stacked lanes by their call depth
+     *
+     * Slots are only aggregated with slots of the same call depth then.
+     * @return true if call stacks are shown
+     */
+    [[nodiscard]] bool isCallStackShown() const;
+
+    /**
+     * @brief Sets whether slots are drawn in stacked lanes by their call depth
+     * @param callStackShown Whether call stacks are shown
+     */
+    void setCallStackShown(bool callStackShown);
+
+    /**
+     * @brief Returns whether waiting time found by the WaitStateAnalysis is highlighted
+     * @return true if wait states are shown
+     */
+    [[nodiscard]] bool isWaitStatesShown() const;
+
+    /**
+     * @brief Sets whether waiting time found by the WaitStateAnalysis is highlighted
+     * @param waitStatesShown Whether wait states are shown
+     */
+    void setWaitStatesShown(bool waitStatesShown);
+
+    /**
+     * @brief Returns whether the CriticalPath is highlighted
+     * @return true if the critical path is shown
+     */
+    [[nodiscard]] bool isCriticalPathShown() const;
+
+    /**
+     * @brief Sets whether the CriticalPath is highlighted
+     * @param criticalPathShown Whether the critical path is shown
+     */
+    void setCriticalPathShown(bool criticalPathShown);
+
 private:
     /**
      * Backing field for the current zoom factor.
      */
     int zoomFactor_ = SETTINGS_DEFAULT_ZOOM_QUOTIENT;
+    /**
+     * Backing field for the minimum size of a slot.
+     */
+    int minSlotSizePx_ = SETTINGS_DEFAULT_MIN_SLOT_SIZE_PX;
+    /**
+     * Backing field for the minimum size of a communication.
+     */
+    int minCommunicationSizePx_ = SETTINGS_DEFAULT_MIN_COMMUNICATION_SIZE_PX;
+    /**
+     * Backing field for the minimum size of a collective communication event.
+     */
+    int minCollectiveEventSizePx_ = SETTINGS_DEFAULT_MIN_COLLECTIVE_EVENT_SIZE_PX;
+    /**
+     * Backing field for whether call stacks are shown.
+     */
+    bool callStackShown_ = false;
+    /**
+     * Backing field for whether wait states are shown.
+     */
+    bool waitStatesShown_ = false;
+    /**
+     * Backing field for whether the critical path is shown.
+     */
+    bool criticalPathShown_ = false;
     /**
      * Backing field for the current filter.
      * */
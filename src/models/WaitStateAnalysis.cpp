@@ -0,0 +1,230 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "WaitStateAnalysis.hpp"
+#include "MpiSlotIndex.hpp"
+#include "src/utils.hpp"
+
+#include <QtConcurrent/QtConcurrent>
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <tuple>
+#include <unordered_map>
+
+namespace {
+    /**
+     * Communications or collectives [begin, end) classified by one task
+     */
+    struct Chunk {
+        size_t begin;
+        size_t end;
+        std::unordered_map<Slot *, WaitState> waitStates;
+    };
+
+    /**
+     * Records that the slot waits from its start until `until`, the longest wait of a slot is kept
+     */
+    void record(Chunk &chunk, Slot *slot, WaitStateKind kind, types::TraceTime until) {
+        auto time = std::min(until, slot->endTime) - slot->startTime;
+        if (time <= types::TraceTime(0)) return;
+
+        auto [it, inserted] = chunk.waitStates.try_emplace(slot, WaitState{slot, kind, time});
+        if (!inserted && it->second.time < time) {
+            it->second = {slot, kind, time};
+        }
+    }
+
+    void merge(std::unordered_map<Slot *, WaitState> &waitStates, const Chunk &chunk) {
+        for (const auto &[slot, waitState]: chunk.waitStates) {
+            auto [it, inserted] = waitStates.try_emplace(slot, waitState);
+            if (!inserted && it->second.time < waitState.time) {
+                it->second = waitState;
+            }
+        }
+    }
+}
+
+WaitStateAnalysis::WaitStateAnalysis(Trace *trace) {
+    MpiSlotIndex mpiSlots(trace);
+    std::map<uint64_t, size_t> rankIndices;
+    for (const auto &[group, groupSlots]: trace->getSlots()) {
+        rankIndices[group->ref().get()] = ranks.size();
+        ranks.push_back({group});
+        groups.push_back(group);
+    }
+
+    auto communicationRange = trace->getCommunications();
+    std::vector<Communication *> communications(communicationRange.begin(), communicationRange.end());
+    auto collectiveRange = trace->getCollectiveCommunications();
+    std::vector<CollectiveCommunicationEvent *> collectives(collectiveRange.begin(), collectiveRange.end());
+
+    std::vector<Chunk> communicationChunks;
+    for (size_t i = 0; i < communications.size(); i += WAIT_STATE_CHUNK_SIZE) {
+        communicationChunks.push_back({i, std::min(i + WAIT_STATE_CHUNK_SIZE, communications.size())});
+    }
+    std::vector<Chunk> collectiveChunks;
+    for (size_t i = 0; i < collectives.size(); i += WAIT_STATE_CHUNK_SIZE) {
+        collectiveChunks.push_back({i, std::min(i + WAIT_STATE_CHUNK_SIZE, collectives.size())});
+    }
+
+    QtConcurrent::blockingMap(communicationChunks, [&](Chunk &chunk) {
+        for (auto i = chunk.begin; i < chunk.end; i++) {
+            auto communication = communications[i];
+            auto send = communication->getSendEvent();
+            auto receive = communication->getReceiveEvent();
+
+            // A non-blocking send waits when it is posted, a non-blocking receive when it is completed
+            auto sendSlot = mpiSlots.enclosing(send->getLocation(), send->getStartTime());
+            auto receiveSlot = mpiSlots.enclosing(receive->getLocation(), receive->getEndTime());
+            if (!sendSlot || !receiveSlot) continue;
+
+            if (receiveSlot->startTime < sendSlot->startTime) {
+                record(chunk, receiveSlot, LateSender, sendSlot->startTime);
+            } else if (send->getKind() == BlockingSend && sendSlot->startTime < receiveSlot->startTime) {
+                record(chunk, sendSlot, LateReceiver, receiveSlot->startTime);
+            }
+        }
+    });
+
+    QtConcurrent::blockingMap(collectiveChunks, [&](Chunk &chunk) {
+        for (auto i = chunk.begin; i < chunk.end; i++) {
+            auto collective = collectives[i];
+            auto operation = collective->getOperation();
+            if (!isNxNCollective(operation) && !isOneToNCollective(operation)) continue;
+
+            std::vector<std::pair<const CollectiveCommunicationEvent::Member *, Slot *>> members;
+            for (const auto &member: collective->getMembers()) {
+                auto slot = mpiSlots.enclosing(member->getLocation(), member->getStart());
+                if (slot) members.emplace_back(member, slot);
+            }
+            if (members.empty()) continue;
+
+            if (isNxNCollective(operation)) {
+                auto lastEnter = types::TraceTime::min();
+                for (const auto &[member, slot]: members) {
+                    lastEnter = std::max(lastEnter, slot->startTime);
+                }
+                for (const auto &[member, slot]: members) {
+                    record(chunk, slot, WaitAtNxN, lastEnter);
+                }
+                continue;
+            }
+
+            auto root = collectiveRootLocation(collective);
+            if (!root) continue;
+            auto rootMember = std::find_if(members.begin(), members.end(), [&root](const auto &item) {
+                return item.first->getLocation()->ref().get() == *root;
+            });
+            if (rootMember == members.end()) continue;
+            for (const auto &[member, slot]: members) {
+                if (slot != rootMember->second) {
+                    record(chunk, slot, LateBroadcastRoot, rootMember->second->startTime);
+                }
+            }
+        }
+    });
+
+    std::unordered_map<Slot *, WaitState> waitStates;
+    for (const auto &chunk: communicationChunks) merge(waitStates, chunk);
+    for (const auto &chunk: collectiveChunks) merge(waitStates, chunk);
+
+    std::map<std::tuple<size_t, uint64_t, WaitStateKind>, WaitStateSummary> summaries;
+    for (const auto &[slot, waitState]: waitStates) {
+        auto index = rankIndices.at(slot->location->location_group().ref().get());
+        auto &rank = ranks[index];
+        rank.waitStates.push_back(waitState);
+        rank.maxWait = std::max(rank.maxWait, waitState.time);
+
+        auto [it, inserted] = summaries.try_emplace({index, slot->region->ref().get(), waitState.kind},
+                                                    WaitStateSummary{rank.group, slot->region, waitState.kind, 0,
+                                                                     types::TraceTime(0)});
+        it->second.count++;
+        it->second.time += waitState.time;
+    }
+    QtConcurrent::blockingMap(ranks, [](Rank &rank) {
+        std::sort(rank.waitStates.begin(), rank.waitStates.end(), [](const WaitState &lhs, const WaitState &rhs) {
+            return lhs.slot->startTime < rhs.slot->startTime;
+        });
+    });
+    for (const auto &[key, item]: summaries) {
+        summary.push_back(item);
+    }
+}
+
+const std::vector<otf2::definition::location_group *> &WaitStateAnalysis::getRanks() const {
+    return groups;
+}
+
+std::pair<WaitStateAnalysis::Iterator, WaitStateAnalysis::Iterator>
+WaitStateAnalysis::inWindow(size_t rank, types::TraceTime from, types::TraceTime to) const {
+    const auto &waitStates = ranks[rank].waitStates;
+    // No wait state starting before from - maxWait reaches into the window
+    auto first = std::lower_bound(waitStates.begin(), waitStates.end(), from - ranks[rank].maxWait,
+                                  [](const WaitState &waitState, types::TraceTime time) {
+                                      return waitState.slot->startTime < time;
+                                  });
+    auto last = std::lower_bound(first, waitStates.end(), to, [](const WaitState &waitState, types::TraceTime time) {
+        return waitState.slot->startTime < time;
+    });
+    return {first, last};
+}
+
+const std::vector<WaitStateSummary> &WaitStateAnalysis::getSummary() const {
+    return summary;
+}
+
+types::TraceTime WaitStateAnalysis::total(WaitStateKind kind) const {
+    types::TraceTime time(0);
+    for (const auto &item: summary) {
+        if (item.kind == kind) time += item.time;
+    }
+    return time;
+}
+
+size_t WaitStateAnalysis::waitStateCount() const {
+    size_t count = 0;
+    for (const auto &rank: ranks) {
+        count += rank.waitStates.size();
+    }
+    return count;
+}
+
+size_t WaitStateAnalysis::memoryUsage() const {
+    auto bytes = sizeof(WaitStateAnalysis) + ranks.capacity() * sizeof(Rank) +
+                 groups.capacity() * sizeof(otf2::definition::location_group *) +
+                 summary.capacity() * sizeof(WaitStateSummary);
+    for (const auto &rank: ranks) {
+        bytes += rank.waitStates.capacity() * sizeof(WaitState);
+    }
+    return bytes;
+}
+
+std::string WaitStateAnalysis::kindName(WaitStateKind kind) {
+    switch (kind) {
+        case LateSender:
+            return "Late sender";
+        case LateReceiver:
+            return "Late receiver";
+        case WaitAtNxN:
+            return "Wait at N×N";
+        case LateBroadcastRoot:
+            return "Late broadcast root";
+        default:
+            throw std::invalid_argument("Invalid wait state kind");
+    }
+}
@@ -0,0 +1,160 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_WAITSTATEANALYSIS_HPP
+#define MOTIV_WAITSTATEANALYSIS_HPP
+
+
+#include <string>
+#include <vector>
+
+#include "Trace.hpp"
+
+/**
+ * Number of communications or collective operations classified by one task of the analysis
+ */
+#define WAIT_STATE_CHUNK_SIZE 65536
+
+/**
+ * @brief Kinds of waiting time in MPI calls
+ */
+enum WaitStateKind {
+    /**
+     * A receive waits because the matching send was started later
+     */
+    LateSender,
+    /**
+     * A send waits because the matching receive was started later
+     */
+    LateReceiver,
+    /**
+     * A member of an all-to-all collective or barrier waits for the last member to enter it
+     */
+    WaitAtNxN,
+    /**
+     * A member of a broadcast or scatter waits for the root to enter it
+     */
+    LateBroadcastRoot,
+    WaitStateKindCount
+};
+
+/**
+ * @brief Waiting time at the beginning of an MPI slot
+ */
+struct WaitState {
+    Slot *slot;
+    WaitStateKind kind;
+    /**
+     * Waiting time, starting at the start of the slot
+     */
+    types::TraceTime time;
+};
+
+/**
+ * @brief Waiting time of a kind summed over all slots of a region on a rank
+ */
+struct WaitStateSummary {
+    otf2::definition::location_group *rank;
+    otf2::definition::region *region;
+    WaitStateKind kind;
+    uint64_t count;
+    types::TraceTime time;
+};
+
+/**
+ * @brief Classifies waiting time in MPI slots based on matched communications and collective operations
+ *
+ * For every communication the MPI slots around the send and the receive are looked up. A receive slot that starts
+ * before its send slot waits for a late sender. A send slot that starts before its receive slot and is still running
+ * when the receive starts waits for a late receiver. Members of collectives wait until the last member (all-to-all and
+ * barriers) or the root (broadcasts and scatters) enters the operation. If several waits fall into the same slot, e.g.
+ * in MPI_Waitall, the longest one is kept.
+ *
+ * Communications and collectives are classified in chunks in parallel.
+ */
+class WaitStateAnalysis {
+public:
+    typedef std::vector<WaitState>::const_iterator Iterator;
+
+    /**
+     * @brief Runs the analysis
+     * @param trace The trace to analyse
+     */
+    explicit WaitStateAnalysis(Trace *trace);
+
+    /**
+     * @brief Returns the analysed ranks in the order of the trace
+     * @return The ranks
+     */
+    [[nodiscard]] const std::vector<otf2::definition::location_group *> &getRanks() const;
+
+    /**
+     * @brief Returns the wait states of a rank overlapping a time window, ordered by start
+     * @param rank Index of the rank
+     * @param from Start of the window
+     * @param to End of the window
+     * @return Begin and end of the wait states, some of the first ones may end before the window
+     */
+    [[nodiscard]] std::pair<Iterator, Iterator> inWindow(size_t rank, types::TraceTime from, types::TraceTime to) const;
+
+    /**
+     * @brief Returns the waiting time per rank, region and kind
+     * @return The summaries ordered by rank
+     */
+    [[nodiscard]] const std::vector<WaitStateSummary> &getSummary() const;
+
+    /**
+     * @brief Returns the total waiting time of a kind
+     * @param kind The kind of wait state
+     * @return Waiting time summed over all ranks
+     */
+    [[nodiscard]] types::TraceTime total(WaitStateKind kind) const;
+
+    /**
+     * @brief Returns the number of found wait states
+     * @return The number of wait states of all ranks
+     */
+    [[nodiscard]] size_t waitStateCount() const;
+
+    /**
+     * @brief Returns the bytes used by the wait states and summaries
+     * @return The used bytes
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+    /**
+     * @brief Returns a readable name of a kind of wait state
+     * @param kind The kind of wait state
+     * @return The name
+     */
+    static std::string kindName(WaitStateKind kind);
+
+private:
+    struct Rank {
+        otf2::definition::location_group *group;
+        std::vector<WaitState> waitStates;
+        types::TraceTime maxWait{0};
+    };
+
+private:
+    std::vector<Rank> ranks;
+    std::vector<otf2::definition::location_group *> groups;
+    std::vector<WaitStateSummary> summary;
+};
+
+
+#endif //MOTIV_WAITSTATEANALYSIS_HPP
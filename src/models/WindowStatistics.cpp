@@ -0,0 +1,232 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "WindowStatistics.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+static uint8_t kindChannel(const Slot *slot) {
+    switch (slot->getKind()) {
+        case MPI:
+            return WindowStatistics::MpiChannel;
+        case OpenMP:
+            return WindowStatistics::OpenMpChannel;
+        default:
+            return WindowStatistics::PlainChannel;
+    }
+}
+
+WindowStatistics::WindowStatistics(Trace *trace, size_t topRegionCount) {
+    auto slots = trace->getSlots();
+
+    // Exclusive time per region determines the top regions, callees are subtracted from their callers
+    std::map<uint64_t, std::pair<types::TraceTime, otf2::definition::region *>> exclusive;
+    for (const auto &[group, groupSlots]: slots) {
+        for (const auto &slot: groupSlots) {
+            auto duration = slot->endTime - slot->startTime;
+            auto &own = exclusive[slot->region->ref().get()];
+            own.first += duration;
+            own.second = slot->region;
+            if (slot->parent) {
+                exclusive[slot->parent->region->ref().get()].first -= duration;
+            }
+        }
+    }
+    std::vector<std::pair<types::TraceTime, otf2::definition::region *>> regions;
+    for (const auto &[ref, item]: exclusive) {
+        regions.push_back(item);
+    }
+    topRegionCount = std::min({topRegionCount, regions.size(), static_cast<size_t>(NO_CHANNEL - KindChannelCount)});
+    std::partial_sort(regions.begin(), regions.begin() + static_cast<long>(topRegionCount), regions.end(),
+                      [](const auto &lhs, const auto &rhs) { return lhs.first > rhs.first; });
+    std::map<uint64_t, uint8_t> regionChannels;
+    for (size_t i = 0; i < topRegionCount; i++) {
+        topRegions.push_back(regions[i].second);
+        regionChannels[regions[i].second->ref().get()] = static_cast<uint8_t>(KindChannelCount + i);
+    }
+
+    auto channels = channelCount();
+    for (const auto &[group, groupSlots]: slots) {
+        ranks.push_back(group);
+
+        // Slots of the locations of the rank, callers before their callees
+        std::map<uint64_t, std::vector<Slot *>> locations;
+        for (const auto &slot: groupSlots) {
+            locations[slot->location->ref().get()].push_back(slot);
+        }
+
+        auto &rankSeries = series.emplace_back();
+        for (auto &[ref, locationSlots]: locations) {
+            std::stable_sort(locationSlots.begin(), locationSlots.end(), [](const Slot *lhs, const Slot *rhs) {
+                return lhs->startTime < rhs->startTime || (lhs->startTime == rhs->startTime && lhs->depth < rhs->depth);
+            });
+
+            auto &location = rankSeries.emplace_back();
+            // Adds a breakpoint at which `innermost` becomes the innermost slot, nullptr if no slot is active
+            auto breakpoint = [&](types::TraceTime::rep time, const Slot *innermost) {
+                auto kind = innermost ? kindChannel(innermost) : NO_CHANNEL;
+                auto region = NO_CHANNEL;
+                if (innermost) {
+                    auto it = regionChannels.find(innermost->region->ref().get());
+                    region = it != regionChannels.end() ? it->second : NO_CHANNEL;
+                }
+
+                if (!location.times.empty() && location.times.back() == time) {
+                    location.kindChannels.back() = kind;
+                    location.regionChannels.back() = region;
+                    return;
+                }
+
+                auto rows = location.times.size();
+                if (rows == 0) {
+                    location.cumulative.resize(channels, 0);
+                } else {
+                    auto elapsed = time - location.times.back();
+                    // The previous row is copied by index, growing the vector invalidates iterators into it
+                    auto previous = location.cumulative.size() - channels;
+                    location.cumulative.resize(location.cumulative.size() + channels);
+                    std::copy_n(location.cumulative.begin() + static_cast<long>(previous), channels,
+                                location.cumulative.begin() + static_cast<long>(previous + channels));
+                    auto row = location.cumulative.end() - static_cast<long>(channels);
+                    if (location.kindChannels.back() != NO_CHANNEL) row[location.kindChannels.back()] += elapsed;
+                    if (location.regionChannels.back() != NO_CHANNEL) row[location.regionChannels.back()] += elapsed;
+                }
+                location.times.push_back(time);
+                location.kindChannels.push_back(kind);
+                location.regionChannels.push_back(region);
+            };
+
+            std::vector<const Slot *> stack;
+            auto popUntil = [&](types::TraceTime::rep time) {
+                while (!stack.empty() && stack.back()->endTime.count() <= time) {
+                    auto end = stack.back()->endTime.count();
+                    stack.pop_back();
+                    breakpoint(end, stack.empty() ? nullptr : stack.back());
+                }
+            };
+            for (const auto &slot: locationSlots) {
+                popUntil(slot->startTime.count());
+                stack.push_back(slot);
+                breakpoint(slot->startTime.count(), slot);
+            }
+            popUntil(std::numeric_limits<types::TraceTime::rep>::max());
+        }
+    }
+}
+
+size_t WindowStatistics::channelCount() const {
+    return KindChannelCount + topRegions.size();
+}
+
+std::string WindowStatistics::channelName(size_t channel) const {
+    switch (channel) {
+        case MpiChannel:
+            return "MPI";
+        case OpenMpChannel:
+            return "OpenMP";
+        case PlainChannel:
+            return "Other";
+        default:
+            return topRegions[channel - KindChannelCount]->name().str();
+    }
+}
+
+const std::vector<otf2::definition::location_group *> &WindowStatistics::getRanks() const {
+    return ranks;
+}
+
+size_t WindowStatistics::locationCount(size_t rank) const {
+    return series[rank].size();
+}
+
+size_t WindowStatistics::locationCount() const {
+    size_t count = 0;
+    for (const auto &rankSeries: series) {
+        count += rankSeries.size();
+    }
+    return count;
+}
+
+std::vector<types::TraceTime> WindowStatistics::forRank(size_t rank, types::TraceTime from, types::TraceTime to) const {
+    std::vector<types::TraceTime> until(channelCount(), types::TraceTime(0));
+    std::vector<types::TraceTime> before(channelCount(), types::TraceTime(0));
+    for (const auto &location: series[rank]) {
+        addUntil(location, to.count(), until);
+        addUntil(location, from.count(), before);
+    }
+
+    for (size_t i = 0; i < until.size(); i++) {
+        until[i] -= before[i];
+    }
+    return until;
+}
+
+std::vector<types::TraceTime> WindowStatistics::total(types::TraceTime from, types::TraceTime to) const {
+    std::vector<types::TraceTime> sum(channelCount(), types::TraceTime(0));
+    for (size_t rank = 0; rank < ranks.size(); rank++) {
+        auto times = forRank(rank, from, to);
+        for (size_t i = 0; i < sum.size(); i++) {
+            sum[i] += times[i];
+        }
+    }
+    return sum;
+}
+
+size_t WindowStatistics::breakpointCount() const {
+    size_t count = 0;
+    for (const auto &rankSeries: series) {
+        for (const auto &location: rankSeries) {
+            count += location.times.size();
+        }
+    }
+    return count;
+}
+
+size_t WindowStatistics::memoryUsage() const {
+    size_t bytes = sizeof(WindowStatistics) + ranks.capacity() * sizeof(otf2::definition::location_group *) +
+                   topRegions.capacity() * sizeof(otf2::definition::region *);
+    for (const auto &rankSeries: series) {
+        bytes += rankSeries.capacity() * sizeof(Series);
+        for (const auto &location: rankSeries) {
+            bytes += location.times.capacity() * sizeof(types::TraceTime::rep) + location.kindChannels.capacity() +
+                     location.regionChannels.capacity() +
+                     location.cumulative.capacity() * sizeof(types::TraceTime::rep);
+        }
+    }
+    return bytes;
+}
+
+void WindowStatistics::addUntil(const WindowStatistics::Series &location, types::TraceTime::rep time,
+                                std::vector<types::TraceTime> &out) const {
+    // Last breakpoint not after the time
+    auto it = std::upper_bound(location.times.begin(), location.times.end(), time);
+    if (it == location.times.begin()) return;
+    auto index = static_cast<size_t>(it - location.times.begin() - 1);
+
+    auto channels = channelCount();
+    auto row = location.cumulative.begin() + static_cast<long>(index * channels);
+    for (size_t i = 0; i < channels; i++) {
+        out[i] += types::TraceTime(row[static_cast<long>(i)]);
+    }
+
+    // The channels active at the breakpoint accumulate time until the queried point
+    auto elapsed = types::TraceTime(time - location.times[index]);
+    if (location.kindChannels[index] != NO_CHANNEL) out[location.kindChannels[index]] += elapsed;
+    if (location.regionChannels[index] != NO_CHANNEL) out[location.regionChannels[index]] += elapsed;
+}
@@ -0,0 +1,153 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_WINDOWSTATISTICS_HPP
+#define MOTIV_WINDOWSTATISTICS_HPP
+
+
+#include <string>
+#include <vector>
+
+#include "Trace.hpp"
+
+/**
+ * Number of regions with the most exclusive time that get their own channel
+ */
+#define WINDOW_STATISTICS_TOP_REGIONS 5
+
+/**
+ * @brief Time spent per slot kind and top region in arbitrary time windows
+ *
+ * At every instant the innermost slot of a location is attributed the time. For every location the points in time the
+ * innermost slot changes are stored together with the cumulative time of every channel up to that point. The time of a
+ * channel in a window is the difference of two values found by binary search, so queries do not depend on the number
+ * of slots in the window.
+ *
+ * The first channels are MPI, OpenMP and other slots, followed by the regions with the most exclusive time.
+ */
+class WindowStatistics {
+public:
+    /**
+     * @brief Channels of the slot kinds, the top regions follow
+     */
+    enum KindChannel {
+        MpiChannel,
+        OpenMpChannel,
+        PlainChannel,
+        KindChannelCount
+    };
+
+    /**
+     * @brief Builds the cumulative time arrays of all locations
+     * @param trace The trace
+     * @param topRegions Number of regions with the most exclusive time that get their own channel
+     */
+    explicit WindowStatistics(Trace *trace, size_t topRegions = WINDOW_STATISTICS_TOP_REGIONS);
+
+    /**
+     * @brief Returns the number of channels
+     * @return The number of channels
+     */
+    [[nodiscard]] size_t channelCount() const;
+
+    /**
+     * @brief Returns the name of a channel
+     * @param channel The channel
+     * @return Name of the slot kind or region
+     */
+    [[nodiscard]] std::string channelName(size_t channel) const;
+
+    /**
+     * @brief Returns the ranks in the order used by forRank()
+     * @return The ranks
+     */
+    [[nodiscard]] const std::vector<otf2::definition::location_group *> &getRanks() const;
+
+    /**
+     * @brief Returns the number of locations of a rank
+     * @param rank Index of the rank
+     * @return The number of locations
+     */
+    [[nodiscard]] size_t locationCount(size_t rank) const;
+
+    /**
+     * @brief Returns the number of locations of all ranks
+     * @return The number of locations
+     */
+    [[nodiscard]] size_t locationCount() const;
+
+    /**
+     * @brief Returns the time spent per channel by the locations of a rank in a window
+     * @param rank Index of the rank
+     * @param from Start of the window
+     * @param to End of the window
+     * @return The time per channel, summed over the locations of the rank
+     */
+    [[nodiscard]] std::vector<types::TraceTime> forRank(size_t rank, types::TraceTime from, types::TraceTime to) const;
+
+    /**
+     * @brief Returns the time spent per channel by all locations in a window
+     * @param from Start of the window
+     * @param to End of the window
+     * @return The time per channel, summed over all locations
+     */
+    [[nodiscard]] std::vector<types::TraceTime> total(types::TraceTime from, types::TraceTime to) const;
+
+    /**
+     * @brief Returns the number of stored breakpoints
+     * @return The number of breakpoints of all locations
+     */
+    [[nodiscard]] size_t breakpointCount() const;
+
+    /**
+     * @brief Returns the bytes used by the cumulative time arrays
+     * @return The used bytes
+     */
+    [[nodiscard]] size_t memoryUsage() const;
+
+private:
+    /**
+     * Breakpoints of a single location
+     */
+    struct Series {
+        std::vector<types::TraceTime::rep> times;
+        /**
+         * Kind channel active from the breakpoint on, NO_CHANNEL if no slot is active
+         */
+        std::vector<uint8_t> kindChannels;
+        /**
+         * Region channel active from the breakpoint on, NO_CHANNEL if the innermost slot is not a top region
+         */
+        std::vector<uint8_t> regionChannels;
+        /**
+         * Cumulative time of every channel at every breakpoint, row by row
+         */
+        std::vector<types::TraceTime::rep> cumulative;
+    };
+
+    static constexpr uint8_t NO_CHANNEL = 0xFF;
+
+    void addUntil(const Series &series, types::TraceTime::rep time, std::vector<types::TraceTime> &out) const;
+
+private:
+    std::vector<otf2::definition::location_group *> ranks;
+    std::vector<std::vector<Series>> series;
+    std::vector<otf2::definition::region *> topRegions;
+};
+
+
+#endif //MOTIV_WINDOWSTATISTICS_HPP
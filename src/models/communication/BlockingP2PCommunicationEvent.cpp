@@ -21,8 +21,10 @@
 
 BlockingP2PCommunicationEvent::BlockingP2PCommunicationEvent(const otf2::chrono::duration &timepoint,
                                                              otf2::definition::location* location,
-                                                             types::communicator* communicator) : timepoint(
-    timepoint), location(location), communicator(communicator) {}
+                                                             types::communicator* communicator,
+                                                             uint64_t messageLength, uint32_t messageTag)
+    : timepoint(timepoint), location(location), communicator(communicator), messageLength(messageLength),
+      messageTag(messageTag) {}
 
 otf2::chrono::duration BlockingP2PCommunicationEvent::getStartTime() const {
     return timepoint;
@@ -40,5 +42,13 @@ types::communicator * BlockingP2PCommunicationEvent::getCommunicator() const {
     return communicator;
 }
 
+uint64_t BlockingP2PCommunicationEvent::getMessageLength() const {
+    return messageLength;
+}
+
+uint32_t BlockingP2PCommunicationEvent::getMessageTag() const {
+    return messageTag;
+}
+
 
 
@@ -48,14 +48,18 @@ protected:
      * @param timepoint Timepoint of the event
      * @param location Location of the event
      * @param communicator Communicator the event took place in
+     * @param messageLength Length of the transferred message in bytes
+     * @param messageTag Tag of the transferred message
      */
     BlockingP2PCommunicationEvent(const otf2::chrono::duration &timepoint, otf2::definition::location* location,
-                                  types::communicator* communicator);
+                                  types::communicator* communicator, uint64_t messageLength, uint32_t messageTag);
 
 protected:
     otf2::chrono::duration timepoint; /**< The time when the event occured */
     otf2::definition::location* location; /**< The location of the event */
     types::communicator* communicator; /**< The communicator of the operation */
+    uint64_t messageLength; /**< The length of the transferred message in bytes */
+    uint32_t messageTag; /**< The tag of the transferred message */
 public:
     /**
      * @copydoc CommunicationEvent::getLocation()
@@ -73,6 +77,14 @@ public:
      * @copydoc CommunicationEvent::getCommunicator()
      */
     [[nodiscard]] types::communicator * getCommunicator() const override;
+    /**
+     * @copydoc CommunicationEvent::getMessageLength()
+     */
+    [[nodiscard]] uint64_t getMessageLength() const override;
+    /**
+     * @copydoc CommunicationEvent::getMessageTag()
+     */
+    [[nodiscard]] uint32_t getMessageTag() const override;
 };
 
 #endif //MOTIV_BLOCKINGP2PCOMMUNICATIONEVENT_HPP
@@ -23,5 +23,7 @@ CommunicationKind BlockingReceiveEvent::getKind() const {
 
 BlockingReceiveEvent::BlockingReceiveEvent(const otf2::chrono::duration &timepoint,
                                            otf2::definition::location *location,
-                                           types::communicator *communicator) : BlockingP2PCommunicationEvent(
-    timepoint, location, communicator) {}
+                                           types::communicator *communicator,
+                                           uint64_t messageLength,
+                                           uint32_t messageTag) : BlockingP2PCommunicationEvent(
+    timepoint, location, communicator, messageLength, messageTag) {}
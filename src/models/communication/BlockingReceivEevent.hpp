@@ -32,9 +32,11 @@ public:
      * @param timepoint Timepoint of the event
      * @param location Location of the event
      * @param communicator Communicator the event took place in
+     * @param messageLength Length of the transferred message in bytes
+     * @param messageTag Tag of the transferred message
      */
     BlockingReceiveEvent(const otf2::chrono::duration &timepoint, otf2::definition::location *location,
-                         types::communicator *communicator);
+                         types::communicator *communicator, uint64_t messageLength, uint32_t messageTag);
 
     CommunicationKind getKind() const override;
 };
@@ -31,6 +31,28 @@ const CommunicationEvent * Communication::getEndEvent() const {
     return end;
 }
 
+static bool isSend(const CommunicationEvent *event) {
+    return event->getKind() == BlockingSend || event->getKind() == NonBlockingSend;
+}
+
+const CommunicationEvent * Communication::getSendEvent() const {
+    return isSend(end) && !isSend(start) ? end : start;
+}
+
+const CommunicationEvent * Communication::getReceiveEvent() const {
+    return isSend(end) && !isSend(start) ? start : end;
+}
+
+uint64_t Communication::getMessageLength() const {
+    auto length = start->getMessageLength();
+    return length ? length : end->getMessageLength();
+}
+
+uint32_t Communication::getMessageTag() const {
+    auto tag = start->getMessageTag();
+    return tag ? tag : end->getMessageTag();
+}
+
 types::TraceTime Communication::getStartTime() const {
     return start->getStartTime();
 }
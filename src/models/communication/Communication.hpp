@@ -53,6 +53,34 @@ public:
      */
     [[nodiscard]] const CommunicationEvent * getEndEvent() const;
 
+    /**
+     * Gets the sending event, which is not necessarily the event recorded first.
+     * @return The send event
+     */
+    [[nodiscard]] const CommunicationEvent * getSendEvent() const;
+
+    /**
+     * Gets the receiving event, which is not necessarily the event recorded last.
+     * @return The receive event
+     */
+    [[nodiscard]] const CommunicationEvent * getReceiveEvent() const;
+
+    /**
+     * Gets the length of the transferred message in bytes.
+     *
+     * The length recorded by the sender is used. If it is unknown, the length recorded by the receiver is used.
+     * @return Length of the transferred message in bytes
+     */
+    [[nodiscard]] uint64_t getMessageLength() const;
+
+    /**
+     * Gets the tag of the transferred message.
+     *
+     * The tag recorded by the sender is used. If it is unknown, the tag recorded by the receiver is used.
+     * @return Tag of the transferred message
+     */
+    [[nodiscard]] uint32_t getMessageTag() const;
+
     types::TraceTime getStartTime() const override;
 
     types::TraceTime getEndTime() const override;
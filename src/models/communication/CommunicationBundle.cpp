@@ -0,0 +1,79 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CommunicationBundle.hpp"
+
+#include <algorithm>
+
+static double center(const CommunicationEvent *event) {
+    auto start = static_cast<double>(event->getStartTime().count());
+    auto end = static_cast<double>(event->getEndTime().count());
+    return start + (end - start) / 2;
+}
+
+CommunicationBundle::CommunicationBundle(const Communication *communication) :
+    representative(communication),
+    start(communication->getStartTime()),
+    end(communication->getEndTime()) {
+    add(communication);
+}
+
+void CommunicationBundle::add(const Communication *communication) {
+    start = std::min(start, communication->getStartTime());
+    end = std::max(end, communication->getEndTime());
+    count++;
+    bytes += communication->getMessageLength();
+    sendTimeSum += center(communication->getStartEvent());
+    receiveTimeSum += center(communication->getEndEvent());
+}
+
+void CommunicationBundle::add(const CommunicationBundle *bundle) {
+    start = std::min(start, bundle->start);
+    end = std::max(end, bundle->end);
+    count += bundle->count;
+    bytes += bundle->bytes;
+    sendTimeSum += bundle->sendTimeSum;
+    receiveTimeSum += bundle->receiveTimeSum;
+}
+
+const Communication *CommunicationBundle::getRepresentative() const {
+    return representative;
+}
+
+uint64_t CommunicationBundle::getCount() const {
+    return count;
+}
+
+uint64_t CommunicationBundle::getBytes() const {
+    return bytes;
+}
+
+double CommunicationBundle::getMeanSendTime() const {
+    return sendTimeSum / static_cast<double>(count);
+}
+
+double CommunicationBundle::getMeanReceiveTime() const {
+    return receiveTimeSum / static_cast<double>(count);
+}
+
+types::TraceTime CommunicationBundle::getStartTime() const {
+    return start;
+}
+
+types::TraceTime CommunicationBundle::getEndTime() const {
+    return end;
+}
@@ -0,0 +1,108 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_COMMUNICATIONBUNDLE_HPP
+#define MOTIV_COMMUNICATIONBUNDLE_HPP
+
+#include "src/types.hpp"
+#include "src/models/TimedElement.hpp"
+#include "Communication.hpp"
+
+/**
+ * @brief Class representing several point to point communications that cannot be distinguished at the current
+ * resolution.
+ *
+ * All bundled communications start on the same rank, end on the same rank and start within a few pixels of each
+ * other. Instead of the communications themselves, a bundle only stores their number, their total volume and the mean
+ * times they were sent and received. A representative communication identifies the involved ranks.
+ */
+class CommunicationBundle : public TimedElement {
+public:
+    /**
+     * Creates a new bundle containing a single communication.
+     * @param communication The first communication of the bundle
+     */
+    explicit CommunicationBundle(const Communication *communication);
+
+    /**
+     * Adds a communication to the bundle.
+     * @param communication The communication to add
+     */
+    void add(const Communication *communication);
+
+    /**
+     * Adds all communications of another bundle to this bundle.
+     * @param bundle The bundle to merge into this bundle
+     */
+    void add(const CommunicationBundle *bundle);
+
+    /**
+     * Gets a communication of the bundle which represents the ranks involved in all communications.
+     * @return The first communication added to the bundle
+     */
+    [[nodiscard]] const Communication *getRepresentative() const;
+
+    /**
+     * Gets the number of bundled communications.
+     * @return The number of bundled communications
+     */
+    [[nodiscard]] uint64_t getCount() const;
+
+    /**
+     * Gets the total length of all bundled messages.
+     * @return The total length of all bundled messages in bytes
+     */
+    [[nodiscard]] uint64_t getBytes() const;
+
+    /**
+     * Gets the mean time the bundled messages were sent.
+     *
+     * The time of a single message is the center of its start event.
+     * @return The mean time the bundled messages were sent
+     */
+    [[nodiscard]] double getMeanSendTime() const;
+
+    /**
+     * Gets the mean time the bundled messages were received.
+     *
+     * The time of a single message is the center of its end event.
+     * @return The mean time the bundled messages were received
+     */
+    [[nodiscard]] double getMeanReceiveTime() const;
+
+    /**
+     * @copydoc TimedElement::getStartTime()
+     */
+    [[nodiscard]] types::TraceTime getStartTime() const override;
+
+    /**
+     * @copydoc TimedElement::getEndTime()
+     */
+    [[nodiscard]] types::TraceTime getEndTime() const override;
+
+private:
+    const Communication *representative;
+    types::TraceTime start;
+    types::TraceTime end;
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+    double sendTimeSum = 0;
+    double receiveTimeSum = 0;
+};
+
+
+#endif //MOTIV_COMMUNICATIONBUNDLE_HPP
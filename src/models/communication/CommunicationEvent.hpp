@@ -56,6 +56,18 @@ public:
      */
     [[nodiscard]] virtual types::communicator * getCommunicator() const = 0;
 
+    /**
+     * Gets the length of the message transferred by the recorded event in bytes.
+     * @return Length of the message in bytes or 0 if the event does not transfer a message
+     */
+    [[nodiscard]] virtual uint64_t getMessageLength() const { return 0; }
+
+    /**
+     * Gets the tag of the message transferred by the recorded event.
+     * @return Tag of the message or 0 if the event does not transfer a message
+     */
+    [[nodiscard]] virtual uint32_t getMessageTag() const { return 0; }
+
     /**
      * Gets the kind of communication event. Implemented by each derived class.
      * @return Kind of event.
@@ -23,8 +23,11 @@
 NonBlockingP2PCommunicationEvent::NonBlockingP2PCommunicationEvent(const otf2::chrono::duration &start,
                                                                    const otf2::chrono::duration &end,
                                                                    otf2::definition::location *location,
-                                                                   types::communicator *communicator)
-        : start(start), end(end), location(location), communicator(communicator) {}
+                                                                   types::communicator *communicator,
+                                                                   uint64_t messageLength,
+                                                                   uint32_t messageTag)
+        : start(start), end(end), location(location), communicator(communicator), messageLength(messageLength),
+          messageTag(messageTag) {}
 
 otf2::definition::location * NonBlockingP2PCommunicationEvent::getLocation() const {
     return location;
@@ -41,3 +44,11 @@ otf2::chrono::duration NonBlockingP2PCommunicationEvent::getEndTime() const {
 types::communicator * NonBlockingP2PCommunicationEvent::getCommunicator() const {
     return communicator;
 }
+
+uint64_t NonBlockingP2PCommunicationEvent::getMessageLength() const {
+    return messageLength;
+}
+
+uint32_t NonBlockingP2PCommunicationEvent::getMessageTag() const {
+    return messageTag;
+}
@@ -39,14 +39,19 @@ protected:
      * @param end End time of the event
      * @param location Location of the event
      * @param communicator Communicator the event took place in
+     * @param messageLength Length of the transferred message in bytes
+     * @param messageTag Tag of the transferred message
      */
     NonBlockingP2PCommunicationEvent(const otf2::chrono::duration &start, const otf2::chrono::duration &end,
-                                     otf2::definition::location* location, types::communicator* communicator);
+                                     otf2::definition::location* location, types::communicator* communicator,
+                                     uint64_t messageLength, uint32_t messageTag);
 
     otf2::chrono::duration start; /**< The time when the event started */
     otf2::chrono::duration end; /**< The time when the event ended */
     otf2::definition::location* location; /**< The location of the event */
     types::communicator* communicator; /**< The communicator of the operation */
+    uint64_t messageLength; /**< The length of the transferred message in bytes */
+    uint32_t messageTag; /**< The tag of the transferred message */
 public:
 
     /**
@@ -65,6 +70,14 @@ public:
      * @copydoc CommunicationEvent::getCommunicator()
      */
     [[nodiscard]] types::communicator * getCommunicator() const override;
+    /**
+     * @copydoc CommunicationEvent::getMessageLength()
+     */
+    [[nodiscard]] uint64_t getMessageLength() const override;
+    /**
+     * @copydoc CommunicationEvent::getMessageTag()
+     */
+    [[nodiscard]] uint32_t getMessageTag() const override;
 };
 
 #endif //MOTIV_NONBLOCKINGP2PCOMMUNICATIONEVENT_HPP
@@ -20,8 +20,10 @@
 NonBlockingReceiveEvent::NonBlockingReceiveEvent(const otf2::chrono::duration &start,
                                                  const otf2::chrono::duration &anEnd,
                                                  otf2::definition::location *location,
-                                                 types::communicator *communicator)
-    : NonBlockingP2PCommunicationEvent(start, anEnd, location, communicator) {}
+                                                 types::communicator *communicator,
+                                                 uint64_t messageLength,
+                                                 uint32_t messageTag)
+    : NonBlockingP2PCommunicationEvent(start, anEnd, location, communicator, messageLength, messageTag) {}
 
 CommunicationKind NonBlockingReceiveEvent::getKind() const {
     return NonBlockingReceive;
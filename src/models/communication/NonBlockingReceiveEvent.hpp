@@ -34,9 +34,12 @@ public:
      * @param end End time of the event
      * @param location Location of the event
      * @param communicator Communicator the event took place in
+     * @param messageLength Length of the transferred message in bytes
+     * @param messageTag Tag of the transferred message
      */
     NonBlockingReceiveEvent(const otf2::chrono::duration &start, const otf2::chrono::duration &end,
-                            otf2::definition::location *location, types::communicator *communicator);
+                            otf2::definition::location *location, types::communicator *communicator,
+                            uint64_t messageLength, uint32_t messageTag);
 
     /**
      * @copydoc CommunicationEvent::getKind()
@@ -48,10 +51,12 @@ public:
             BUILDER_FIELD(otf2::chrono::duration, end)
             BUILDER_FIELD(otf2::definition::location*, location)
             BUILDER_FIELD(types::communicator*, communicator)
+            BUILDER_FIELD(uint64_t, messageLength)
+            BUILDER_FIELD(uint32_t, messageTag)
             BUILDER_OPTIONAL_FIELD(uint32_t, sender), // The sender field is needed to match the sending call. The
                                                       // location instance of the sender is only known in the
                                                       // send event.
-            start, end, location, communicator)
+            start, end, location, communicator, messageLength, messageTag)
 };
 
 
@@ -19,8 +19,10 @@
 
 NonBlockingSendEvent::NonBlockingSendEvent(const otf2::chrono::duration &start, const otf2::chrono::duration &end,
                                            otf2::definition::location *location,
-                                           types::communicator *communicator) : NonBlockingP2PCommunicationEvent(
-    start, end, location, communicator) {}
+                                           types::communicator *communicator,
+                                           uint64_t messageLength,
+                                           uint32_t messageTag) : NonBlockingP2PCommunicationEvent(
+    start, end, location, communicator, messageLength, messageTag) {}
 
 CommunicationKind NonBlockingSendEvent::getKind() const {
     return NonBlockingSend;
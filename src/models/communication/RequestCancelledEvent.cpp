@@ -20,7 +20,8 @@
 RequestCancelledEvent::RequestCancelledEvent(const otf2::chrono::duration &start, const otf2::chrono::duration &end,
                                              otf2::definition::location *location,
                                              types::communicator *communicator)
-    : NonBlockingP2PCommunicationEvent(start, end, location, communicator) {}
+    // A cancelled request does not transfer a message
+    : NonBlockingP2PCommunicationEvent(start, end, location, communicator, 0) {}
 
 CommunicationKind RequestCancelledEvent::getKind() const {
     return RequestCancelled;
@@ -0,0 +1,266 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TraceGenerator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+#include <otf2xx/otf2.hpp>
+#include <otf2xx/writer/archive.hpp>
+
+namespace {
+    /**
+     * Salts distinguishing the independent decisions derived from the seed and the step
+     */
+    enum Salt : uint64_t {
+        SALT_MESSAGE = 0x6d657373616765,
+        SALT_DISTANCE = 0x64697374616e6365,
+        SALT_LENGTH = 0x6c656e677468,
+        SALT_COLLECTIVE = 0x636f6c6c656374,
+    };
+
+    /**
+     * Mixes two values into a pseudo random number (SplitMix64 finalizer)
+     */
+    uint64_t mix(uint64_t seed, uint64_t value) {
+        uint64_t z = seed + 0x9e3779b97f4a7c15 * (value + 1);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+        return z ^ (z >> 31);
+    }
+
+    /**
+     * Maps a pseudo random number to [0, 1)
+     */
+    double unit(uint64_t value) {
+        return static_cast<double>(value >> 11) * 0x1.0p-53;
+    }
+
+    otf2::chrono::time_point timePoint(std::chrono::nanoseconds time) {
+        return otf2::chrono::time_point(std::chrono::duration_cast<otf2::chrono::duration>(time));
+    }
+}
+
+TraceGenerator::TraceGenerator(TraceGeneratorOptions options) : options(options) {
+    this->options.ranks = std::max(this->options.ranks, 1u);
+    this->options.threadsPerRank = std::max(this->options.threadsPerRank, 1u);
+    this->options.callDepth = std::max(this->options.callDepth, 1u);
+    this->options.regionCount = std::max(this->options.regionCount, 1u);
+    this->options.messageRate = std::clamp(this->options.messageRate, 0., this->options.callRate);
+    this->options.collectiveRate = std::clamp(this->options.collectiveRate, 0., this->options.callRate);
+}
+
+uint64_t TraceGenerator::write(const std::string &directory, const std::string &name) {
+    using std::chrono::nanoseconds;
+
+    otf2::writer::archive archive(directory, name);
+    uint64_t events = 0;
+
+    // Every step needs room for the nested calls and the communication phase
+    auto stepLength = std::max(nanoseconds(std::llround(1e9 / options.callRate)),
+                               nanoseconds(100 * (options.callDepth + 1)));
+    auto steps = static_cast<uint64_t>(options.duration / stepLength);
+    auto duration = stepLength * steps;
+
+    archive << otf2::definition::clock_properties(otf2::chrono::ticks(1000000000), otf2::chrono::ticks(0),
+                                                  otf2::chrono::ticks(duration.count()));
+
+    // Definitions
+    uint32_t nextString = 0;
+    auto string = [&](const std::string &value) {
+        otf2::definition::string definition(nextString++, value);
+        archive << definition;
+        return definition;
+    };
+
+    auto empty = string("");
+    auto file = string("generated.c");
+    auto programName = string("motiv-tracegen");
+
+    otf2::definition::system_tree_node machine(0, string("machine"), string("machine"));
+    archive << machine;
+
+    uint32_t nextRegion = 0;
+    auto region = [&](const std::string &regionName, otf2::definition::region::paradigm_type paradigm) {
+        auto nameString = string(regionName);
+        otf2::definition::region definition(nextRegion++, nameString, nameString, empty,
+                                            otf2::definition::region::role_type::function, paradigm,
+                                            otf2::definition::region::flags_type::none, file, 0, 0);
+        archive << definition;
+        return definition;
+    };
+
+    std::vector<otf2::definition::region> userRegions;
+    for (uint32_t i = 0; i < options.regionCount; i++) {
+        userRegions.push_back(region("region_" + std::to_string(i), otf2::definition::region::paradigm_type::user));
+    }
+    auto parallelRegion = region("!$omp parallel @generated.c", otf2::definition::region::paradigm_type::openmp);
+    auto sendRegion = region("MPI_Send", otf2::definition::region::paradigm_type::mpi);
+    auto receiveRegion = region("MPI_Recv", otf2::definition::region::paradigm_type::mpi);
+    auto allreduceRegion = region("MPI_Allreduce", otf2::definition::region::paradigm_type::mpi);
+
+    // The first thread of rank r has the location id r, as messages are matched by the location id of their peer
+    std::vector<otf2::definition::location_group> groups;
+    std::vector<otf2::definition::location> locations;
+    for (uint32_t rank = 0; rank < options.ranks; rank++) {
+        groups.emplace_back(rank, string("Rank " + std::to_string(rank)),
+                            otf2::definition::location_group::location_group_type::process, machine);
+        archive << groups.back();
+    }
+    for (uint32_t rank = 0; rank < options.ranks; rank++) {
+        for (uint32_t thread = 0; thread < options.threadsPerRank; thread++) {
+            auto id = thread == 0 ? rank : options.ranks + rank * (options.threadsPerRank - 1) + thread - 1;
+            locations.emplace_back(id, string("Thread " + std::to_string(thread)), groups[rank],
+                                   otf2::definition::location::location_type::cpu_thread);
+            archive << locations.back();
+        }
+    }
+
+    otf2::definition::comm_locations_group worldLocations(0, string("MPI_COMM_WORLD locations"),
+                                                          otf2::common::paradigm_type::mpi,
+                                                          otf2::common::group_flag_type::none);
+    otf2::definition::comm_group worldGroup(1, string("MPI_COMM_WORLD group"), otf2::common::paradigm_type::mpi,
+                                            otf2::common::group_flag_type::none);
+    for (uint32_t rank = 0; rank < options.ranks; rank++) {
+        worldLocations.add_member(locations[rank * options.threadsPerRank]);
+        worldGroup.add_member(rank);
+    }
+    archive << worldLocations << worldGroup;
+
+    otf2::definition::comm world(0, string("MPI_COMM_WORLD"), worldGroup);
+    archive << world;
+
+    // Events are written location by location
+    for (uint32_t rank = 0; rank < options.ranks; rank++) {
+        for (uint32_t thread = 0; thread < options.threadsPerRank; thread++) {
+            const auto &location = locations[rank * options.threadsPerRank + thread];
+            auto &writer = archive(location);
+            std::mt19937_64 random(mix(options.seed, location.ref().get()));
+            auto isMaster = thread == 0;
+
+            if (isMaster) {
+                writer << otf2::event::program_begin(timePoint(nanoseconds(0)), programName, {});
+                events++;
+            }
+
+            std::vector<std::pair<const otf2::definition::region *, nanoseconds>> callStack;
+            for (uint64_t step = 0; step < steps; step++) {
+                auto stepStart = stepLength * step;
+                auto at = [&](int permille) { return timePoint(stepStart + stepLength * permille / 1000); };
+
+                // Call tree within the first 60 % of the step, each level shrinks by 10 % on both sides
+                auto maxDuration = stepLength * 6 / 10;
+                auto callDuration = std::clamp(drawDuration(random, maxDuration / 2), nanoseconds(1), maxDuration);
+                auto begin = stepStart + stepLength / 100;
+                auto end = begin + callDuration;
+                for (uint32_t level = 0; level < options.callDepth && end > begin; level++) {
+                    const auto *callee = !isMaster && level == 0 ? &parallelRegion
+                                                                : &userRegions[random() % userRegions.size()];
+                    writer << otf2::event::enter(timePoint(begin), *callee);
+                    callStack.emplace_back(callee, end);
+                    events++;
+
+                    auto margin = (end - begin) / 10;
+                    begin += margin;
+                    end -= margin;
+                }
+                while (!callStack.empty()) {
+                    writer << otf2::event::leave(timePoint(callStack.back().second), *callStack.back().first);
+                    callStack.pop_back();
+                    events++;
+                }
+
+                if (!isMaster) continue;
+
+                if (options.ranks > 1 && hasMessage(step)) {
+                    auto distance = messageDistance(step);
+                    auto receiver = (rank + distance) % options.ranks;
+                    auto sender = (rank + options.ranks - distance) % options.ranks;
+                    auto tag = static_cast<uint32_t>(step % 32768);
+
+                    writer << otf2::event::enter(at(700), sendRegion)
+                           << otf2::event::mpi_send(at(720), receiver, world, tag, messageLength(step, rank))
+                           << otf2::event::leave(at(740), sendRegion)
+                           << otf2::event::enter(at(760), receiveRegion)
+                           << otf2::event::mpi_receive(at(780), sender, world, tag, messageLength(step, sender))
+                           << otf2::event::leave(at(800), receiveRegion);
+                    events += 6;
+                }
+
+                if (hasCollective(step)) {
+                    writer << otf2::event::enter(at(840), allreduceRegion)
+                           << otf2::event::mpi_collective_begin(at(850))
+                           << otf2::event::mpi_collective_end(at(930), otf2::collective_type::allreduce, world,
+                                                              OTF2_UNDEFINED_UINT32, 8, 8)
+                           << otf2::event::leave(at(950), allreduceRegion);
+                    events += 4;
+                }
+            }
+
+            if (isMaster) {
+                writer << otf2::event::program_end(timePoint(duration), 0);
+                events++;
+            }
+        }
+    }
+
+    return events;
+}
+
+std::chrono::nanoseconds TraceGenerator::drawDuration(std::mt19937_64 &random, std::chrono::nanoseconds mean) const {
+    auto m = static_cast<double>(mean.count());
+    double value;
+    switch (options.durationDistribution) {
+        case Uniform:
+            value = std::uniform_real_distribution<double>(0, 2 * m)(random);
+            break;
+        case Exponential:
+            value = std::exponential_distribution<double>(1 / m)(random);
+            break;
+        case LogNormal: {
+            // The location is chosen so that the distribution has the requested mean
+            double sigma = 1;
+            value = std::lognormal_distribution<double>(std::log(m) - sigma * sigma / 2, sigma)(random);
+            break;
+        }
+        case Fixed:
+        default:
+            value = m;
+            break;
+    }
+
+    return std::chrono::nanoseconds(std::llround(value));
+}
+
+uint64_t TraceGenerator::messageLength(uint64_t step, uint32_t sender) const {
+    // Sender and receiver derive the length independently, hence it only depends on the step and the sender
+    auto u = unit(mix(options.seed ^ SALT_LENGTH, step * options.ranks + sender));
+    return static_cast<uint64_t>(-static_cast<double>(options.messageSize) * std::log1p(-u));
+}
+
+bool TraceGenerator::hasMessage(uint64_t step) const {
+    return unit(mix(options.seed ^ SALT_MESSAGE, step)) < options.messageRate / options.callRate;
+}
+
+uint32_t TraceGenerator::messageDistance(uint64_t step) const {
+    return 1 + static_cast<uint32_t>(mix(options.seed ^ SALT_DISTANCE, step) % (options.ranks - 1));
+}
+
+bool TraceGenerator::hasCollective(uint64_t step) const {
+    return unit(mix(options.seed ^ SALT_COLLECTIVE, step)) < options.collectiveRate / options.callRate;
+}
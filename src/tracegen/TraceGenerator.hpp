@@ -0,0 +1,126 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_TRACEGENERATOR_HPP
+#define MOTIV_TRACEGENERATOR_HPP
+
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <string>
+
+/**
+ * @brief Distributions the durations of generated calls can be drawn from
+ */
+enum DurationDistribution {
+    Fixed,
+    Uniform,
+    Exponential,
+    LogNormal,
+};
+
+/**
+ * @brief Parameters of a generated trace
+ *
+ * The size of the trace is roughly proportional to
+ * @c ranks * @c threadsPerRank * @c duration * @c callRate * @c callDepth.
+ */
+struct TraceGeneratorOptions {
+    /**
+     * Number of MPI ranks
+     */
+    uint32_t ranks = 4;
+    /**
+     * Number of threads of each rank, all but the first execute OpenMP regions
+     */
+    uint32_t threadsPerRank = 1;
+    /**
+     * Depth of the nested calls of every call tree
+     */
+    uint32_t callDepth = 4;
+    /**
+     * Number of distinct user regions
+     */
+    uint32_t regionCount = 16;
+    /**
+     * Length of the trace
+     */
+    std::chrono::nanoseconds duration = std::chrono::seconds(1);
+    /**
+     * Call trees per second and thread
+     */
+    double callRate = 1000;
+    /**
+     * P2P messages sent per second and rank, at most @c callRate
+     */
+    double messageRate = 100;
+    /**
+     * Collective operations per second, at most @c callRate
+     */
+    double collectiveRate = 10;
+    /**
+     * Mean length of P2P messages in bytes
+     */
+    uint64_t messageSize = 1024;
+    /**
+     * Distribution of the durations of call trees
+     */
+    DurationDistribution durationDistribution = Exponential;
+    /**
+     * Seed of all random decisions, equal options always produce equal traces
+     */
+    uint64_t seed = 0;
+};
+
+/**
+ * @brief Writes synthetic OTF2 traces of controlled size
+ *
+ * The trace is divided into steps of length 1 / @c callRate. In every step each thread executes a call tree of
+ * @c callDepth nested regions. Afterwards the first thread of each rank may exchange a message with another rank and
+ * may take part in a collective operation. Decisions all ranks have to agree on are derived from the seed and the step,
+ * hence events are written location by location and memory usage does not depend on the size of the trace.
+ */
+class TraceGenerator {
+public:
+    /**
+     * Creates a new instance
+     * @param options Parameters of the generated trace
+     */
+    explicit TraceGenerator(TraceGeneratorOptions options);
+
+    /**
+     * Writes the trace to a new archive
+     * @param directory Directory the archive is created in
+     * @param name Name of the archive, the anchor file is @c name.otf2
+     * @return The number of written events
+     */
+    uint64_t write(const std::string &directory, const std::string &name);
+
+private:
+    [[nodiscard]] std::chrono::nanoseconds drawDuration(std::mt19937_64 &random, std::chrono::nanoseconds mean) const;
+    [[nodiscard]] uint64_t messageLength(uint64_t step, uint32_t sender) const;
+    [[nodiscard]] bool hasMessage(uint64_t step) const;
+    [[nodiscard]] uint32_t messageDistance(uint64_t step) const;
+    [[nodiscard]] bool hasCollective(uint64_t step) const;
+
+private:
+    TraceGeneratorOptions options;
+};
+
+
+#endif //MOTIV_TRACEGENERATOR_HPP
@@ -0,0 +1,119 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QDir>
+#include <QTextStream>
+
+#include "src/tracegen/TraceGenerator.hpp"
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("motiv-tracegen");
+    QCoreApplication::setApplicationVersion(MOTIV_VERSION_STRING);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates synthetic OTF2 traces of controlled size for testing MOTIV");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addPositionalArgument("directory", "directory the archive is created in");
+
+    QCommandLineOption nameOption("name", "name of the archive", "name", "traces");
+    QCommandLineOption ranksOption("ranks", "number of MPI ranks", "n", "4");
+    QCommandLineOption threadsOption("threads", "number of threads per rank", "n", "1");
+    QCommandLineOption depthOption("depth", "depth of nested calls", "n", "4");
+    QCommandLineOption regionsOption("regions", "number of distinct user regions", "n", "16");
+    QCommandLineOption durationOption("duration", "length of the trace in milliseconds", "ms", "1000");
+    QCommandLineOption callRateOption("call-rate", "call trees per second and thread", "rate", "1000");
+    QCommandLineOption messageRateOption("message-rate", "P2P messages per second and rank", "rate", "100");
+    QCommandLineOption collectiveRateOption("collective-rate", "collective operations per second", "rate", "10");
+    QCommandLineOption messageSizeOption("message-size", "mean length of P2P messages in bytes", "bytes", "1024");
+    QCommandLineOption distributionOption("distribution",
+                                          "distribution of call durations: fixed, uniform, exponential or lognormal",
+                                          "name", "exponential");
+    QCommandLineOption seedOption("seed", "seed of all random decisions", "n", "0");
+    parser.addOptions({nameOption, ranksOption, threadsOption, depthOption, regionsOption, durationOption,
+                       callRateOption, messageRateOption, collectiveRateOption, messageSizeOption, distributionOption,
+                       seedOption});
+    parser.process(app);
+
+    if (parser.positionalArguments().size() != 1) {
+        parser.showHelp(EXIT_FAILURE);
+    }
+
+    QTextStream err(stderr);
+    bool valid = true;
+    auto toUInt = [&](const QCommandLineOption &option) {
+        bool ok;
+        auto value = parser.value(option).toUInt(&ok);
+        if (!ok || value == 0) {
+            err << "Invalid value for --" << option.names().first() << ": " << parser.value(option) << Qt::endl;
+            valid = false;
+        }
+        return value;
+    };
+    auto toDouble = [&](const QCommandLineOption &option, bool allowZero) {
+        bool ok;
+        auto value = parser.value(option).toDouble(&ok);
+        if (!ok || value < 0 || (!allowZero && value == 0)) {
+            err << "Invalid value for --" << option.names().first() << ": " << parser.value(option) << Qt::endl;
+            valid = false;
+        }
+        return value;
+    };
+
+    TraceGeneratorOptions options;
+    options.ranks = toUInt(ranksOption);
+    options.threadsPerRank = toUInt(threadsOption);
+    options.callDepth = toUInt(depthOption);
+    options.regionCount = toUInt(regionsOption);
+    options.duration = std::chrono::nanoseconds(std::llround(toDouble(durationOption, false) * 1e6));
+    options.callRate = toDouble(callRateOption, false);
+    options.messageRate = toDouble(messageRateOption, true);
+    options.collectiveRate = toDouble(collectiveRateOption, true);
+    options.messageSize = parser.value(messageSizeOption).toULongLong();
+    options.seed = parser.value(seedOption).toULongLong();
+
+    auto distribution = parser.value(distributionOption).toLower();
+    if (distribution == "fixed") {
+        options.durationDistribution = Fixed;
+    } else if (distribution == "uniform") {
+        options.durationDistribution = Uniform;
+    } else if (distribution == "exponential") {
+        options.durationDistribution = Exponential;
+    } else if (distribution == "lognormal") {
+        options.durationDistribution = LogNormal;
+    } else {
+        err << "Unknown distribution: " << distribution << Qt::endl;
+        valid = false;
+    }
+
+    if (!valid) {
+        return EXIT_FAILURE;
+    }
+
+    auto directory = parser.positionalArguments().first();
+    auto name = parser.value(nameOption);
+    TraceGenerator generator(options);
+    auto events = generator.write(directory.toStdString(), name.toStdString());
+
+    QTextStream(stdout) << "Wrote " << events << " events to "
+                        << QDir(directory).filePath(name + ".otf2") << Qt::endl;
+
+    return EXIT_SUCCESS;
+}
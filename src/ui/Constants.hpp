@@ -23,8 +23,10 @@ namespace layers {
     const int Z_LAYER_HIGHLIGHTED_OFFSET = 20;
     const int Z_LAYER_P2P_COMMUNICATIONS = 100;
     const int Z_LAYER_COLLECTIVE_COMMUNICATIONS = 110;
+    const int Z_LAYER_CRITICAL_PATH = 120;
     const int Z_LAYER_SLOTS_MIN_PRIORITY = 10;
     const int Z_LAYER_SLOTS_MAX_PRIORITY = Z_LAYER_SLOTS_MIN_PRIORITY + Z_LAYER_HIGHLIGHTED_OFFSET - 1;
+    const int Z_LAYER_SLOT_HIGHLIGHTS = 50;
     const int Z_LAYER_SELECTION = 200;
 }
 
@@ -33,6 +35,8 @@ namespace colors {
     const QColor COLOR_SLOT_OPEN_MP = QColor::fromRgb(0xFF5722);
     const QColor COLOR_SLOT_PLAIN = QColor::fromRgb(0xBDBDBD);
     const QColor COLOR_COLLECTIVE_COMMUNICATION = QColor::fromRgb(0x42A5F5);
+    const QColor COLOR_WAIT_STATE = QColor::fromRgb(0xD32F2F);
+    const QColor COLOR_CRITICAL_PATH = QColor::fromRgb(0x7B1FA2);
 }
 
 #endif //MOTIV_CONSTANTS_HPP
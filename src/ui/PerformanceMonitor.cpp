@@ -0,0 +1,150 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PerformanceMonitor.hpp"
+
+#include <fstream>
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+PerformanceMonitor::ScopedTimer::ScopedTimer(PerformanceMonitor::Stage stage)
+    : stage(stage), enabled(PerformanceMonitor::getInstance().isEnabled()), traceScope(stageName(stage)) {
+    if (enabled) {
+        start = std::chrono::steady_clock::now();
+    }
+}
+
+PerformanceMonitor::ScopedTimer::~ScopedTimer() {
+    if (enabled) {
+        auto duration = std::chrono::steady_clock::now() - start;
+        PerformanceMonitor::getInstance().recordStage(
+            stage, std::chrono::duration_cast<std::chrono::microseconds>(duration));
+    }
+}
+
+bool PerformanceMonitor::isEnabled() const {
+    return enabled;
+}
+
+void PerformanceMonitor::setEnabled(bool enable) {
+    std::lock_guard lock(mutex);
+    enabled = enable;
+    current = PerformanceSample();
+    currentRecorded = false;
+}
+
+void PerformanceMonitor::recordStage(PerformanceMonitor::Stage stage, std::chrono::microseconds duration) {
+    if (!enabled) return;
+
+    std::lock_guard lock(mutex);
+    switch (stage) {
+        case Subtrace:
+            current.subtrace += duration;
+            break;
+        case ForResolution:
+            current.forResolution += duration;
+            break;
+        case PopulateScene:
+            current.populateScene += duration;
+            break;
+        case Paint:
+            current.paint += duration;
+            break;
+    }
+
+    // Painting alone, e.g. on hover, does not make a frame worth recording
+    if (stage != Paint) {
+        currentRecorded = true;
+    }
+}
+
+void PerformanceMonitor::recordElementCounts(size_t before, size_t after) {
+    if (!enabled) return;
+
+    std::lock_guard lock(mutex);
+    current.elementsBeforeLod = before;
+    current.elementsAfterLod = after;
+    currentRecorded = true;
+}
+
+void PerformanceMonitor::recordCacheAccess(bool hit) {
+    if (!enabled) return;
+
+    std::lock_guard lock(mutex);
+    if (hit) {
+        current.cacheHits++;
+    } else {
+        current.cacheMisses++;
+    }
+    currentRecorded = true;
+}
+
+void PerformanceMonitor::finishFrame() {
+    if (!enabled) return;
+
+    {
+        std::lock_guard lock(mutex);
+        if (!currentRecorded) {
+            current = PerformanceSample();
+            return;
+        }
+
+        current.residentSetSize = currentResidentSetSize();
+        history.push_back(current);
+        while (history.size() > PERFORMANCE_HISTORY_SIZE) {
+            history.pop_front();
+        }
+
+        current = PerformanceSample();
+        currentRecorded = false;
+    }
+
+    Q_EMIT historyChanged();
+}
+
+std::deque<PerformanceSample> PerformanceMonitor::getHistory() const {
+    std::lock_guard lock(mutex);
+    return history;
+}
+
+size_t PerformanceMonitor::currentResidentSetSize() {
+#ifdef __linux__
+    // The second field of statm is the number of resident pages
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0;
+    size_t resident = 0;
+    if (statm >> size >> resident) {
+        return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    }
+#endif
+    return 0;
+}
+
+const char *PerformanceMonitor::stageName(PerformanceMonitor::Stage stage) {
+    switch (stage) {
+        case Subtrace:
+            return "subtrace";
+        case ForResolution:
+            return "level of detail";
+        case PopulateScene:
+            return "scene population";
+        case Paint:
+            return "paint";
+    }
+    return "unknown";
+}
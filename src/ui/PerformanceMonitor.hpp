@@ -0,0 +1,210 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_PERFORMANCEMONITOR_HPP
+#define MOTIV_PERFORMANCEMONITOR_HPP
+
+
+#include <QObject>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+
+#include "src/SelfTracer.hpp"
+
+/**
+ * Defines the number of frames kept in the rolling history of the PerformanceMonitor
+ */
+#define PERFORMANCE_HISTORY_SIZE 240
+
+/**
+ * @brief Measurements of a single update of the timeline
+ */
+struct PerformanceSample {
+    /**
+     * Time spent in SubTrace::subtrace
+     */
+    std::chrono::microseconds subtrace{0};
+    /**
+     * Time spent in UITrace::forResolution
+     */
+    std::chrono::microseconds forResolution{0};
+    /**
+     * Time spent populating the scene of the timeline
+     */
+    std::chrono::microseconds populateScene{0};
+    /**
+     * Time spent painting the timeline
+     */
+    std::chrono::microseconds paint{0};
+    /**
+     * Number of elements in the selected time window
+     */
+    size_t elementsBeforeLod = 0;
+    /**
+     * Number of elements remaining after reducing the level of detail
+     */
+    size_t elementsAfterLod = 0;
+    /**
+     * Number of requests answered from a cache
+     */
+    size_t cacheHits = 0;
+    /**
+     * Number of requests a cache could not answer
+     */
+    size_t cacheMisses = 0;
+    /**
+     * Resident set size of the process in bytes, 0 if unknown
+     */
+    size_t residentSetSize = 0;
+
+    /**
+     * @return The sum of all timed stages
+     */
+    [[nodiscard]] std::chrono::microseconds total() const { return subtrace + forResolution + populateScene + paint; }
+};
+
+/**
+ * @brief Singleton collecting timings and counters of the rendering pipeline
+ *
+ * Measurements are accumulated into the current sample, which is completed by finishFrame() after the timeline was
+ * painted. Stages may be recorded from any thread. While the monitor is disabled nothing is recorded, so that
+ * instrumented code only pays for checking an atomic flag.
+ */
+class PerformanceMonitor : public QObject {
+Q_OBJECT
+private:
+    PerformanceMonitor() = default;
+
+public:
+    /**
+     * @brief Stages of the pipeline that are timed
+     */
+    enum Stage {
+        Subtrace,
+        ForResolution,
+        PopulateScene,
+        Paint,
+    };
+
+    /**
+     * @brief Records the time between its construction and destruction for a stage
+     */
+    class ScopedTimer {
+    public:
+        /**
+         * Starts measuring the stage if the monitor is enabled
+         * @param stage The measured stage
+         */
+        explicit ScopedTimer(Stage stage);
+        ~ScopedTimer();
+
+    private:
+        Stage stage;
+        bool enabled;
+        std::chrono::steady_clock::time_point start;
+        SelfTracer::Scope traceScope;
+    };
+
+    /**
+     * @return instance of PerformanceMonitor
+     */
+    static PerformanceMonitor &getInstance() {
+        static PerformanceMonitor instance;
+        return instance;
+    }
+
+    // Do not implement copy and copy assignment constructor.
+    PerformanceMonitor(PerformanceMonitor const &) = delete;
+    void operator=(PerformanceMonitor const &) = delete;
+
+    /**
+     * @brief Whether measurements are recorded
+     * @return true if measurements are recorded
+     */
+    [[nodiscard]] bool isEnabled() const;
+
+    /**
+     * @brief Adds the duration of a stage to the current sample
+     * @param stage The measured stage
+     * @param duration Time spent in the stage
+     */
+    void recordStage(Stage stage, std::chrono::microseconds duration);
+
+    /**
+     * @brief Sets the number of elements before and after reducing the level of detail of the current sample
+     * @param before Number of elements in the selected time window
+     * @param after Number of elements after reducing the level of detail
+     */
+    void recordElementCounts(size_t before, size_t after);
+
+    /**
+     * @brief Counts an access to a cache in the current sample
+     * @param hit Whether the cache could answer the request
+     */
+    void recordCacheAccess(bool hit);
+
+    /**
+     * @brief Completes the current sample and appends it to the history
+     *
+     * Nothing happens if nothing was recorded since the last frame, e.g. if the timeline was repainted on hover.
+     */
+    void finishFrame();
+
+    /**
+     * @brief Returns the most recent samples, oldest first
+     * @return The most recent samples
+     */
+    [[nodiscard]] std::deque<PerformanceSample> getHistory() const;
+
+    /**
+     * @brief Determines the resident set size of the process
+     * @return The resident set size in bytes, 0 if it cannot be determined on this platform
+     */
+    static size_t currentResidentSetSize();
+
+    /**
+     * @brief Returns the name of a stage as used in self traces
+     * @param stage The stage
+     * @return Name of the stage
+     */
+    static const char *stageName(Stage stage);
+
+public Q_SLOTS:
+    /**
+     * @brief Enables or disables recording measurements
+     * @param enable Whether measurements should be recorded
+     */
+    void setEnabled(bool enable);
+
+public: Q_SIGNALS:
+    /**
+     * @brief Signals a new sample was appended to the history
+     */
+    void historyChanged();
+
+private:
+    mutable std::mutex mutex;
+    std::atomic_bool enabled = false;
+    PerformanceSample current;
+    bool currentRecorded = false;
+    std::deque<PerformanceSample> history;
+};
+
+
+#endif //MOTIV_PERFORMANCEMONITOR_HPP
@@ -16,17 +16,163 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "TraceDataProxy.hpp"
+#include "src/models/MemoryAccounting.hpp"
+#include "src/models/MemoryBudget.hpp"
 #include "src/models/UITrace.hpp"
+#include "src/models/communication/CommunicationBundle.hpp"
+#include "src/ui/PerformanceMonitor.hpp"
+#include "src/SelfTracer.hpp"
+
+#include <QtConcurrent/QtConcurrent>
+
+static size_t elementCount(Trace *trace) {
+    size_t count = 0;
+    for (const auto &item: trace->getSlots()) {
+        count += std::distance(item.second.begin(), item.second.end());
+    }
+    auto communications = trace->getCommunications();
+    count += std::distance(communications.begin(), communications.end());
+    auto bundles = trace->getCommunicationBundles();
+    count += std::distance(bundles.begin(), bundles.end());
+    auto collectiveCommunications = trace->getCollectiveCommunications();
+    count += std::distance(collectiveCommunications.begin(), collectiveCommunications.end());
+    return count;
+}
+
+/**
+ * Computes the selection of a time window at full resolution. Safe to run concurrently as the trace is only read.
+ */
+static Trace *computeSelection(Trace *trace, types::TraceTime begin, types::TraceTime end, int resolution,
+                               ViewSettings settings, std::shared_ptr<const CompiledFilter> filter) {
+    Trace *subtrace;
+    {
+        PerformanceMonitor::ScopedTimer timer(PerformanceMonitor::Subtrace);
+        subtrace = trace->subtrace(begin, end);
+    }
+
+    Trace *selection;
+    {
+        PerformanceMonitor::ScopedTimer timer(PerformanceMonitor::ForResolution);
+        selection = UITrace::forResolution(subtrace, subtrace->getRuntime() / resolution, settings, filter.get());
+    }
+
+    auto &monitor = PerformanceMonitor::getInstance();
+    if (monitor.isEnabled()) {
+        monitor.recordElementCounts(elementCount(subtrace), elementCount(selection));
+    }
+
+    delete subtrace;
+    return selection;
+}
+
+/**
+ * Computes the levels of detail of the entire trace from coarse to fine together with their sizes in bytes. Safe to run
+ * concurrently as the trace is only read.
+ */
+static std::vector<std::pair<UITrace *, size_t>> computeLodLevels(Trace *trace, ViewSettings settings,
+                                                                   std::shared_ptr<const CompiledFilter> filter) {
+    SelfTracer::Scope scope("level of detail pyramid");
+    std::vector<std::pair<UITrace *, size_t>> levels;
+    auto timePerPixel = trace->getRuntime() / DEFAULT_RESOLUTION_PX;
+    for (int i = 0; i < PROGRESSIVE_LOD_LEVELS && timePerPixel.count() > 0; i++) {
+        auto level = UITrace::forResolution(trace, timePerPixel, settings, filter.get());
+        if (elementCount(level) > PROGRESSIVE_LOD_MAX_ELEMENTS) {
+            delete level;
+            break;
+        }
+
+        levels.emplace_back(level, MemoryReport::forDerivedTrace(level).total().bytes);
+        timePerPixel /= PROGRESSIVE_LOD_FACTOR;
+    }
+    return levels;
+}
+
 
 TraceDataProxy::TraceDataProxy(FileTrace *trace, ViewSettings *settings, QObject *parent)
     : QObject(parent), trace(trace), settings(settings), begin(trace->getStartTime()),
       end(trace->getStartTime() + trace->getRuntime()) {
-    updateSelection();
+    compiledFilter = std::make_shared<CompiledFilter>(settings->getFilter(), trace);
+    connect(&lodWatcher, &QFutureWatcher<LodLevels>::finished, this, &TraceDataProxy::lodLevelsComputed);
+    startLodComputation();
+    {
+        SelfTracer::Scope scope("window statistics");
+        windowStatistics = new WindowStatistics(trace);
+    }
+    selection = computeSelection(trace, begin, end, resolution, *settings, compiledFilter);
+
+    connect(&selectionWatcher, &QFutureWatcher<Trace *>::finished, this, &TraceDataProxy::selectionComputed);
+    connect(&waitStateWatcher, &QFutureWatcher<WaitStateAnalysis *>::finished, this,
+            &TraceDataProxy::waitStateAnalysisComputed);
+    connect(&criticalPathWatcher, &QFutureWatcher<CriticalPath *>::finished, this,
+            &TraceDataProxy::criticalPathComputed);
+
+    MemoryAccounting::getInstance().registerReporter(this, [this](MemoryReport &report) {
+        report.add(MemoryReport::forTrace(this->trace));
+        for (const auto &level: lodLevels) {
+            report.add(MemoryReport::forDerivedTrace(level));
+        }
+        for (const auto &level: retiredLevels) {
+            report.add(MemoryReport::forDerivedTrace(level));
+        }
+        if (auto uiSelection = dynamic_cast<UITrace *>(selection)) {
+            report.add(MemoryReport::forDerivedTrace(uiSelection));
+        }
+        report.add(MemoryReport::Aggregates, windowStatistics->breakpointCount(), windowStatistics->memoryUsage());
+        if (waitStateAnalysis) {
+            report.add(MemoryReport::Aggregates, waitStateAnalysis->waitStateCount(), waitStateAnalysis->memoryUsage());
+        }
+        if (criticalPath) {
+            report.add(MemoryReport::Aggregates, criticalPath->getSegments().size(), criticalPath->memoryUsage());
+        }
+        if (regionIndex) {
+            report.add(MemoryReport::Aggregates, 1, regionIndex->memoryUsage());
+        }
+        if (summary) {
+            report.add(MemoryReport::Aggregates, summary->locationCount(), summary->memoryUsage());
+        }
+        if (callingContextTree) {
+            report.add(MemoryReport::Aggregates, callingContextTree->getNodes().size(),
+                       callingContextTree->memoryUsage());
+        }
+    });
 }
 
 TraceDataProxy::~TraceDataProxy() {
+    MemoryAccounting::getInstance().unregisterReporter(this);
+    if (selectionComputing) {
+        selectionWatcher.waitForFinished();
+        delete selectionWatcher.result();
+    }
+    if (lodComputing) {
+        lodWatcher.waitForFinished();
+        for (const auto &entry: lodWatcher.result()) {
+            delete entry.first;
+        }
+    }
+    if (waitStatesComputing) {
+        waitStateWatcher.waitForFinished();
+        delete waitStateWatcher.result();
+    }
+    if (criticalPathComputing) {
+        criticalPathWatcher.waitForFinished();
+        delete criticalPathWatcher.result();
+    }
+    for (const auto &level: lodLevels) {
+        MemoryBudget::getInstance().remove(level);
+        delete level;
+    }
+    for (const auto &level: retiredLevels) {
+        delete level;
+    }
     delete this->selection;
+    delete this->windowStatistics;
+    delete this->waitStateAnalysis;
+    delete this->criticalPath;
+    delete this->regionIndex;
     delete this->trace;
+    delete this->summary;
+    delete this->thumbnail;
+    delete this->callingContextTree;
 }
 
 Trace *TraceDataProxy::getSelection() const {
@@ -59,10 +205,138 @@ types::TraceTime TraceDataProxy::getTotalRuntime() const {
 }
 
 void TraceDataProxy::updateSelection() {
+    Q_EMIT selectionRequested(begin, end);
+
+    // The coarse selection is only cut out of a precomputed level, nothing is aggregated while zooming
+    auto level = coarseLevel();
+    if (level) {
+        replaceSelection(level->SubTrace::subtrace(begin, end), level);
+    }
+
+    if (selectionComputing) {
+        // The running computation is discarded once finished and restarted for the latest window
+        selectionOutdated = true;
+        return;
+    }
+
+    startSelectionComputation();
+}
+
+void TraceDataProxy::startLodComputation() {
+    // The pyramid aggregates the whole trace several times, so it is built in the background. Until it is available
+    // zooming only shows the selection at full resolution.
+    lodComputing = true;
+    lodOutdated = false;
+    lodWatcher.setFuture(QtConcurrent::run(&computeLodLevels, trace, *settings, compiledFilter));
+}
+
+void TraceDataProxy::lodLevelsComputed() {
+    lodComputing = false;
+    auto levels = lodWatcher.result();
+
+    if (lodOutdated) {
+        for (const auto &entry: levels) {
+            delete entry.first;
+        }
+        startLodComputation();
+        return;
+    }
+
+    // Levels not fitting into the memory budget are left out, the selection is computed at full resolution instead
+    auto fits = true;
+    for (const auto &entry: levels) {
+        auto level = entry.first;
+        fits = fits && MemoryBudget::getInstance().add(level, entry.second, [this, level] { evictLodLevel(level); });
+        if (fits) {
+            lodLevels.push_back(level);
+        } else {
+            delete level;
+        }
+    }
+}
+
+void TraceDataProxy::clearLodLevels() {
+    for (const auto &level: lodLevels) {
+        MemoryBudget::getInstance().remove(level);
+        deleteLodLevel(level);
+    }
+    lodLevels.clear();
+}
+
+void TraceDataProxy::evictLodLevel(UITrace *level) {
+    std::erase(lodLevels, level);
+    deleteLodLevel(level);
+}
+
+void TraceDataProxy::deleteLodLevel(UITrace *level) {
+    if (level == selectionLevel) {
+        // The current selection points into the level, it is deleted once the selection is replaced
+        retiredLevels.push_back(level);
+        return;
+    }
+
+    if (selectedElement && level->owns(selectedElement)) {
+        setTimeElementSelection(nullptr);
+    }
+    delete level;
+}
+
+UITrace *TraceDataProxy::coarseLevel() const {
+    PerformanceMonitor::getInstance().recordCacheAccess(!lodLevels.empty());
+    if (lodLevels.empty()) {
+        return nullptr;
+    }
+
+    // Use the finest level which is not more detailed than required for the selection
+    auto timePerPixel = (end - begin) / resolution;
+    auto level = lodLevels.front();
+    for (const auto &candidate: lodLevels) {
+        if (candidate->getTimePerPx() < timePerPixel) break;
+        level = candidate;
+    }
+
+    MemoryBudget::getInstance().touch(level);
+    return level;
+}
+
+void TraceDataProxy::startSelectionComputation() {
+    selectionComputing = true;
+    selectionOutdated = false;
+    selectionWatcher.setFuture(
+        QtConcurrent::run(&computeSelection, trace, begin, end, resolution, *settings, compiledFilter));
+}
+
+void TraceDataProxy::selectionComputed() {
+    selectionComputing = false;
+    auto result = selectionWatcher.result();
+
+    if (selectionOutdated) {
+        delete result;
+        startSelectionComputation();
+        return;
+    }
+
+    replaceSelection(result);
+}
+
+void TraceDataProxy::replaceSelection(Trace *newSelection, UITrace *level) {
+    // Bundles and aggregates are owned by the selection or the level it was cut out of, unlike all other elements they
+    // do not outlive it
+    auto uiSelection = dynamic_cast<UITrace *>(selection);
+    if (selectedElement && uiSelection && uiSelection->owns(selectedElement)) {
+        setTimeElementSelection(nullptr);
+    }
+
     delete selection;
-    auto subtrace = trace->subtrace(begin, end);
-    selection = UITrace::forResolution(subtrace, subtrace->getRuntime() / 1920);
-    Q_EMIT selectionChanged(begin, end);
+    selection = newSelection;
+    selectionLevel = level;
+
+    auto retired = std::move(retiredLevels);
+    retiredLevels.clear();
+    for (const auto &retiredLevel: retired) {
+        deleteLodLevel(retiredLevel);
+    }
+    Q_EMIT selectionChanged(selection->getStartTime(), selection->getStartTime() + selection->getRuntime());
 }
 
 void TraceDataProxy::setSelection(types::TraceTime newBegin, types::TraceTime newEnd) {
@@ -92,15 +366,143 @@ void TraceDataProxy::setSelection(types::TraceTime newBegin, types::TraceTime ne
 }
 
 void TraceDataProxy::setTimeElementSelection(TimedElement *newSlot) {
+    selectedElement = newSlot;
     Q_EMIT infoElementSelected(newSlot);
 }
 
 void TraceDataProxy::setFilter(Filter filter) {
     settings->setFilter(filter);
+    {
+        SelfTracer::Scope scope("filter");
+        compiledFilter = std::make_shared<CompiledFilter>(filter, trace);
+    }
+
+    // The levels of detail only contain elements passing the filter, the new ones are computed in the background
+    clearLodLevels();
+    if (lodComputing) {
+        lodOutdated = true;
+    } else {
+        startLodComputation();
+    }
+    updateSelection();
 
     Q_EMIT filterChanged(filter);
 }
 
+void TraceDataProxy::setCallStackShown(bool shown) {
+    if (settings->isCallStackShown() == shown) return;
+
+    settings->setCallStackShown(shown);
+    updateSelection();
+}
+
+void TraceDataProxy::setWaitStatesShown(bool shown) {
+    if (settings->isWaitStatesShown() == shown) return;
+
+    settings->setWaitStatesShown(shown);
+    // The selection stays the same, views only have to redraw it
+    Q_EMIT selectionChanged(selection->getStartTime(), selection->getStartTime() + selection->getRuntime());
+}
+
+void TraceDataProxy::setCriticalPathShown(bool shown) {
+    if (settings->isCriticalPathShown() == shown) return;
+
+    settings->setCriticalPathShown(shown);
+    Q_EMIT selectionChanged(selection->getStartTime(), selection->getStartTime() + selection->getRuntime());
+}
+
 Trace *TraceDataProxy::getFullTrace() const {
     return trace;
 }
+
+const WindowStatistics *TraceDataProxy::getWindowStatistics() const {
+    return windowStatistics;
+}
+
+const WaitStateAnalysis *TraceDataProxy::getWaitStateAnalysis() {
+    // The analysis reads the whole trace, it is run in the background so that the views stay responsive
+    if (!waitStateAnalysis && !waitStatesComputing) {
+        waitStatesComputing = true;
+        waitStateWatcher.setFuture(QtConcurrent::run([trace = this->trace] {
+            SelfTracer::Scope scope("wait state analysis");
+            return new WaitStateAnalysis(trace);
+        }));
+    }
+    return waitStateAnalysis;
+}
+
+void TraceDataProxy::waitStateAnalysisComputed() {
+    waitStatesComputing = false;
+    waitStateAnalysis = waitStateWatcher.result();
+    Q_EMIT waitStateAnalysisFinished();
+}
+
+const CriticalPath *TraceDataProxy::getCriticalPath() {
+    if (!criticalPath && !criticalPathComputing) {
+        criticalPathComputing = true;
+        criticalPathWatcher.setFuture(QtConcurrent::run([trace = this->trace] {
+            SelfTracer::Scope scope("critical path");
+            return new CriticalPath(trace);
+        }));
+    }
+    return criticalPath;
+}
+
+void TraceDataProxy::criticalPathComputed() {
+    criticalPathComputing = false;
+    criticalPath = criticalPathWatcher.result();
+    Q_EMIT criticalPathFinished();
+}
+
+const TraceSummary *TraceDataProxy::getSummary() const {
+    return summary;
+}
+
+void TraceDataProxy::setSummary(TraceSummary *newSummary) {
+    delete summary;
+    summary = newSummary;
+}
+
+const CallingContextTree *TraceDataProxy::getCallingContextTree() const {
+    return callingContextTree;
+}
+
+void TraceDataProxy::setCallingContextTree(CallingContextTree *newTree) {
+    delete callingContextTree;
+    callingContextTree = newTree;
+}
+
+const TraceThumbnail *TraceDataProxy::getThumbnail() const {
+    return thumbnail;
+}
+
+void TraceDataProxy::setThumbnail(TraceThumbnail *newThumbnail) {
+    delete thumbnail;
+    thumbnail = newThumbnail;
+}
+
+const RegionIndex *TraceDataProxy::getRegionIndex() {
+    if (!regionIndex) {
+        SelfTracer::Scope scope("region index");
+        regionIndex = new RegionIndex(trace);
+    }
+    return regionIndex;
+}
+
+int TraceDataProxy::getResolution() const {
+    return resolution;
+}
+
+bool TraceDataProxy::isSelectionComputing() const {
+    return selectionComputing;
+}
+
+void TraceDataProxy::setResolution(int newResolution) {
+    newResolution = qMax(1, newResolution);
+    if (newResolution == resolution) {
+        return;
+    }
+
+    resolution = newResolution;
+    updateSelection();
+}
@@ -19,11 +19,43 @@
 #define MOTIV_TRACEDATAPROXY_HPP
 
 
+#include <QFutureWatcher>
 #include <QObject>
+#include <memory>
 
+#include "src/models/CallingContextTree.hpp"
+#include "src/models/CompiledFilter.hpp"
+#include "src/models/CriticalPath.hpp"
 #include "src/models/Filetrace.hpp"
+#include "src/models/RegionIndex.hpp"
+#include "src/models/TraceSummary.hpp"
+#include "src/models/TraceThumbnail.hpp"
 #include "src/models/ViewSettings.hpp"
+#include "src/models/WaitStateAnalysis.hpp"
+#include "src/models/WindowStatistics.hpp"
 
+/**
+ * Defines the horizontal resolution in device pixels assumed until a view reports its actual resolution
+ */
+#define DEFAULT_RESOLUTION_PX 1920
+
+class UITrace;
+
+/**
+ * Defines the number of precomputed levels of detail of the entire trace used for coarse previews
+ */
+#define PROGRESSIVE_LOD_LEVELS 4
+
+/**
+ * Defines how many times finer each precomputed level of detail is than the previous one
+ */
+#define PROGRESSIVE_LOD_FACTOR 8
+
+/**
+ * Defines the maximum number of elements of a precomputed level of detail, so that a preview can be cut out of it
+ * within a single frame
+ */
+#define PROGRESSIVE_LOD_MAX_ELEMENTS 100000
 
 /**
  * @brief Model class providing access to data and pub/sub architecture of change events
@@ -31,6 +63,11 @@
  * TraceDataProxy acts as an intermediate class between the views and the data.
  * This class tracks all state changes related to the representation of the trace, e.g. selections
  * and emits a signal on changes.
+ *
+ * Changing the selection is progressive: selectionRequested() is emitted right away so views can rescale what they
+ * currently show. A coarse selection derived from levels of detail precomputed in the background follows immediately
+ * once they are available and the selection at full resolution is computed in the background. selectionChanged() is
+ * emitted for both. Requests made while a computation is running are coalesced into a single follow-up computation.
  */
 class TraceDataProxy : public QObject {
     Q_OBJECT
@@ -81,17 +118,101 @@ public: // methods
      */
     [[nodiscard]] Trace *getFullTrace() const;
 
+    /**
+     * @brief Returns the statistics of the entire trace, which answer queries for any time window in constant time
+     * @return The window statistics of the full trace
+     */
+    [[nodiscard]] const WindowStatistics *getWindowStatistics() const;
+
+    /**
+     * @brief Returns the wait states of the entire trace
+     *
+     * The analysis is started in the background on the first call, waitStateAnalysisFinished() is emitted once it is
+     * available.
+     * @return The wait state analysis of the full trace or nullptr while it is computed
+     */
+    [[nodiscard]] const WaitStateAnalysis *getWaitStateAnalysis();
+
+    /**
+     * @brief Returns the critical path of the entire trace
+     *
+     * The path is computed in the background after the first call, criticalPathFinished() is emitted once it is
+     * available.
+     * @return The critical path of the full trace or nullptr while it is computed
+     */
+    [[nodiscard]] const CriticalPath *getCriticalPath();
+
+    /**
+     * @brief Returns the index of region names and calls of the entire trace, it is built on the first call
+     * @return The region index of the full trace
+     */
+    [[nodiscard]] const RegionIndex *getRegionIndex();
+
+    /**
+     * @brief Returns the summary the trace was created from if it was loaded as a summary only
+     * @return The summary or nullptr if all events of the trace were loaded
+     */
+    [[nodiscard]] const TraceSummary *getSummary() const;
+
+    /**
+     * @brief Sets the summary the trace was created from, ownership is transferred to the proxy
+     *
+     * The summary is deleted after the trace as the slots of the trace reference its definitions.
+     * @param newSummary The summary
+     */
+    void setSummary(TraceSummary *newSummary);
+
+    /**
+     * @brief Returns the calling context tree whose nodes the slots of the trace refer to
+     * @return The calling context tree or nullptr if none was built
+     */
+    [[nodiscard]] const CallingContextTree *getCallingContextTree() const;
+
+    /**
+     * @brief Sets the calling context tree built while loading the trace, ownership is transferred to the proxy
+     * @param newTree The calling context tree
+     */
+    void setCallingContextTree(CallingContextTree *newTree);
+
+    /**
+     * @brief Returns the thumbnails stored in the trace archive
+     * @return The thumbnails or nullptr if the archive has none
+     */
+    [[nodiscard]] const TraceThumbnail *getThumbnail() const;
+
+    /**
+     * @brief Sets the thumbnails stored in the trace archive, ownership is transferred to the proxy
+     * @param newThumbnail The thumbnails
+     */
+    void setThumbnail(TraceThumbnail *newThumbnail);
+
     /**
      * Returns the runtime of the entire loaded trace
      * @return
      */
     [[nodiscard]] types::TraceTime getTotalRuntime() const;
 
+    /**
+     * @brief Returns the horizontal resolution the selection is optimized for
+     * @return The horizontal resolution in device pixels
+     */
+    [[nodiscard]] int getResolution() const;
+
+    /**
+     * @brief Returns whether the selection at full resolution is still being computed
+     * @return true if the current selection is a preview
+     */
+    [[nodiscard]] bool isSelectionComputing() const;
+
 public: Q_SIGNALS:
     /**
      * Signals the selection has been changed
      */
     void selectionChanged(types::TraceTime newBegin, types::TraceTime newEnd);
+    /**
+     * Signals a new selection was requested, the selection itself is updated later
+     */
+    void selectionRequested(types::TraceTime newBegin, types::TraceTime newEnd);
     /**
      * Signals the begin was changed
      */
@@ -110,6 +231,16 @@ public: Q_SIGNALS:
      */
     void filterChanged(Filter);
 
+    /**
+     * Signals the wait state analysis is available
+     */
+    void waitStateAnalysisFinished();
+
+    /**
+     * Signals the critical path is available
+     */
+    void criticalPathFinished();
+
 public Q_SLOTS:
     /**
      * Change the start time of the selection
@@ -134,27 +265,112 @@ public Q_SLOTS:
 
     /**
      * Change the filter
+     *
+     * The filter is compiled against the trace and applied while the levels of detail are computed, so the levels
+     * and the selection are recomputed. Both are computed in the background.
      * @param filter
      */
     void setFilter(Filter filter);
 
+    /**
+     * Change whether slots are drawn in stacked lanes by their call depth
+     *
+     * The selection is recomputed, as slots are aggregated per lane then.
+     * @param shown Whether call stacks are shown
+     */
+    void setCallStackShown(bool shown);
+
+    /**
+     * Change whether waiting time in MPI slots is highlighted
+     *
+     * The wait state analysis is run when wait states are shown the first time.
+     * @param shown Whether wait states are shown
+     */
+    void setWaitStatesShown(bool shown);
+
+    /**
+     * Change whether the critical path is highlighted
+     *
+     * The critical path is computed when it is shown the first time.
+     * @param shown Whether the critical path is shown
+     */
+    void setCriticalPathShown(bool shown);
+
     /**
      * Change the selected slot
      * @param newSlot pass nullptr if none selected
      */
     void setTimeElementSelection(TimedElement *newSlot);
 
+    /**
+     * Change the horizontal resolution the selection is optimized for
+     *
+     * The selection is recomputed if the resolution changed. Views should report the width of their viewport
+     * multiplied by the device pixel ratio, so that smaller windows require less work and high density displays
+     * show the correct level of detail.
+     * @param newResolution The horizontal resolution in device pixels
+     */
+    void setResolution(int newResolution);
+
+private Q_SLOTS:
+    void selectionComputed();
+    void lodLevelsComputed();
+    void waitStateAnalysisComputed();
+    void criticalPathComputed();
+
 private: // methods
     void updateSelection();
     void updateSlotSelection();
+    void startLodComputation();
+    void clearLodLevels();
+    void evictLodLevel(UITrace *level);
+    void deleteLodLevel(UITrace *level);
+    void startSelectionComputation();
+    void replaceSelection(Trace *newSelection, UITrace *level = nullptr);
+    [[nodiscard]] UITrace *coarseLevel() const;
 
 private: // data
     FileTrace *trace = nullptr;
     Trace *selection = nullptr;
+    TimedElement *selectedElement = nullptr;
     ViewSettings *settings = nullptr;
 
     types::TraceTime begin{0};
     types::TraceTime end{0};
+
+    int resolution = DEFAULT_RESOLUTION_PX;
+
+    std::vector<UITrace *> lodLevels;
+    /**
+     * Level of detail the current selection was cut out of, if any
+     */
+    UITrace *selectionLevel = nullptr;
+    /**
+     * Levels no longer used for new selections but still referenced by the current one
+     */
+    std::vector<UITrace *> retiredLevels;
+    /**
+     * Levels of detail from coarse to fine with their sizes in bytes, as computed in the background
+     */
+    typedef std::vector<std::pair<UITrace *, size_t>> LodLevels;
+    QFutureWatcher<LodLevels> lodWatcher;
+    bool lodComputing = false;
+    bool lodOutdated = false;
+    std::shared_ptr<const CompiledFilter> compiledFilter;
+    WindowStatistics *windowStatistics = nullptr;
+    WaitStateAnalysis *waitStateAnalysis = nullptr;
+    CriticalPath *criticalPath = nullptr;
+    RegionIndex *regionIndex = nullptr;
+    TraceSummary *summary = nullptr;
+    CallingContextTree *callingContextTree = nullptr;
+    TraceThumbnail *thumbnail = nullptr;
+    QFutureWatcher<Trace *> selectionWatcher;
+    bool selectionComputing = false;
+    bool selectionOutdated = false;
+    QFutureWatcher<WaitStateAnalysis *> waitStateWatcher;
+    bool waitStatesComputing = false;
+    QFutureWatcher<CriticalPath *> criticalPathWatcher;
+    bool criticalPathComputing = false;
 };
 
 
@@ -0,0 +1,179 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "TraceOverviewRenderer.hpp"
+#include "src/ui/Constants.hpp"
+#include "src/SelfTracer.hpp"
+
+#include <algorithm>
+
+/**
+ * Priorities of the slot kinds in a pixel. If slots overlap in a pixel, the one with the highest priority is shown.
+ * 1. MPI events, 2. OpenMP events 3. all other events
+ */
+static uint8_t priority(SlotKind kind) {
+    switch (kind) {
+        case ::MPI:
+            return 3;
+        case ::OpenMP:
+            return 2;
+        case ::None:
+        case ::Plain:
+        default:
+            return 1;
+    }
+}
+
+static QRgb color(uint8_t priority) {
+    switch (priority) {
+        case 3:
+            return colors::COLOR_SLOT_MPI.rgba();
+        case 2:
+            return colors::COLOR_SLOT_OPEN_MP.rgba();
+        case 1:
+            return colors::COLOR_SLOT_PLAIN.rgba();
+        default:
+            return qRgba(0, 0, 0, 0);
+    }
+}
+
+static QImage toImage(const std::vector<uint8_t> &pixels, int width, int rows) {
+    QImage image(width, rows, QImage::Format_ARGB32_Premultiplied);
+    for (int row = 0; row < rows; row++) {
+        auto line = reinterpret_cast<QRgb *>(image.scanLine(row));
+        auto source = pixels.data() + static_cast<size_t>(row) * width;
+        for (int x = 0; x < width; x++) {
+            line[x] = color(source[x]);
+        }
+    }
+    return image;
+}
+
+/**
+ * Appends the image of the pixel buffer and the images derived from it to the levels
+ */
+static void appendLevels(std::vector<QImage> &levels, std::vector<uint8_t> pixels, int width, int rows) {
+    levels.push_back(toImage(pixels, width, rows));
+
+    // Derive less detailed levels by merging two neighbouring pixels, keeping the more important one
+    while (width / 2 >= OVERVIEW_MIN_RESOLUTION_PX) {
+        auto newWidth = width / 2;
+        std::vector<uint8_t> merged(static_cast<size_t>(newWidth) * rows);
+        for (int r = 0; r < rows; r++) {
+            auto source = pixels.data() + static_cast<size_t>(r) * width;
+            auto target = merged.data() + static_cast<size_t>(r) * newWidth;
+            for (int x = 0; x < newWidth; x++) {
+                target[x] = std::max(source[2 * x], source[2 * x + 1]);
+            }
+        }
+
+        pixels = std::move(merged);
+        width = newWidth;
+        levels.push_back(toImage(pixels, width, rows));
+    }
+}
+
+std::vector<QImage> TraceOverviewRenderer::render(Trace *trace) {
+    SelfTracer::Scope scope("overview rendering");
+    std::vector<QImage> levels;
+
+    auto slots = trace->getSlots();
+    auto rows = static_cast<int>(slots.size());
+    auto runtime = trace->getRuntime().count();
+    if (rows == 0 || runtime <= 0) {
+        return levels;
+    }
+
+    int width = OVERVIEW_MAX_RESOLUTION_PX;
+    while (width > OVERVIEW_MIN_RESOLUTION_PX && static_cast<long>(width) * rows > OVERVIEW_MAX_PIXELS) {
+        width /= 2;
+    }
+
+    // Rasterize all slots into the most detailed pixel buffer
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * rows, 0);
+    int row = 0;
+    for (const auto &item: slots) {
+        auto line = pixels.data() + static_cast<size_t>(row) * width;
+        for (const auto &slot: item.second) {
+            auto startTime = std::clamp<decltype(runtime)>(slot->startTime.count(), 0, runtime);
+            auto endTime = std::clamp<decltype(runtime)>(slot->endTime.count(), 0, runtime);
+
+            auto fromX = static_cast<int>(static_cast<double>(startTime) / static_cast<double>(runtime) * width);
+            auto toX = static_cast<int>(static_cast<double>(endTime) / static_cast<double>(runtime) * width);
+            fromX = std::min(fromX, width - 1);
+            // Slots shorter than a pixel still occupy the pixel they start in
+            toX = std::clamp(toX, fromX + 1, width);
+
+            auto p = priority(slot->getKind());
+            for (int x = fromX; x < toX; x++) {
+                line[x] = std::max(line[x], p);
+            }
+        }
+        row++;
+    }
+    appendLevels(levels, std::move(pixels), width, rows);
+
+    return levels;
+}
+
+std::vector<QImage> TraceOverviewRenderer::render(const TraceThumbnail *thumbnail) {
+    SelfTracer::Scope scope("overview rendering");
+    std::vector<QImage> levels;
+
+    const auto &thumbnails = thumbnail->rows();
+    auto rows = static_cast<int>(thumbnails.size());
+    auto width = static_cast<int>(std::min<size_t>(thumbnail->sampleCount(), OVERVIEW_MAX_RESOLUTION_PX));
+    if (rows == 0 || width == 0) {
+        return levels;
+    }
+
+    std::vector<uint8_t> pixels(static_cast<size_t>(width) * rows, 0);
+    for (int row = 0; row < rows; row++) {
+        const auto &samples = thumbnails[row].samples;
+        auto line = pixels.data() + static_cast<size_t>(row) * width;
+        // Thumbnails with fewer samples are stretched over the whole width
+        for (int x = 0; x < width; x++) {
+            const auto &sample = samples[static_cast<size_t>(x) * samples.size() / width];
+            if (sample[0] > 0) {
+                line[x] = priority(MPI);
+            } else if (sample[1] > 0) {
+                line[x] = priority(OpenMP);
+            } else if (sample[2] > 0) {
+                line[x] = priority(Plain);
+            }
+        }
+    }
+    appendLevels(levels, std::move(pixels), width, rows);
+
+    return levels;
+}
+
+QImage TraceOverviewRenderer::select(const std::vector<QImage> &levels, int width) {
+    if (levels.empty()) {
+        return {};
+    }
+
+    // Levels are ordered descending by width, so the last sufficiently wide level is the smallest one
+    auto selected = levels.front();
+    for (const auto &level: levels) {
+        if (level.width() < width) {
+            break;
+        }
+        selected = level;
+    }
+    return selected;
+}
@@ -0,0 +1,89 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_TRACEOVERVIEWRENDERER_HPP
+#define MOTIV_TRACEOVERVIEWRENDERER_HPP
+
+#include <QImage>
+#include <vector>
+
+#include "src/models/Trace.hpp"
+#include "src/models/TraceThumbnail.hpp"
+
+/**
+ * Defines the width in px of the most detailed image rendered for the trace overview
+ */
+#define OVERVIEW_MAX_RESOLUTION_PX 4096
+
+/**
+ * Defines the width in px of the least detailed image rendered for the trace overview
+ */
+#define OVERVIEW_MIN_RESOLUTION_PX 512
+
+/**
+ * Defines the maximum number of pixels of the most detailed image. Traces with many ranks are rendered with a smaller
+ * maximum width to stay within this limit.
+ */
+#define OVERVIEW_MAX_PIXELS (16 * 1024 * 1024)
+
+/**
+ * @brief Rasterizes a whole trace into images for the trace overview
+ *
+ * Instead of creating a graphics item for every slot, the slots are rasterized once into a pixel buffer storing the
+ * most important kind of slot per pixel. Each rank is rendered as a single pixel row. Less detailed images are derived
+ * from the most detailed one by merging neighbouring pixels, so only a single pass over the slots is needed.
+ *
+ * The renderer only reads the trace and can therefore be run in a background thread.
+ */
+class TraceOverviewRenderer {
+public:
+    /**
+     * @brief Renders the trace at several resolutions
+     *
+     * The first image has the highest resolution, each following image has half the width of its predecessor.
+     *
+     * @param trace The trace to render
+     * @return Images of the trace ordered from the highest to the lowest resolution
+     */
+    static std::vector<QImage> render(Trace *trace);
+
+    /**
+     * @brief Renders thumbnails stored in the trace archive at several resolutions
+     *
+     * Each thumbnail is rendered as a single pixel row with one pixel per sample, colored like the slots by the most
+     * important kind of region active in the sample. No slots are read.
+     *
+     * @param thumbnail The thumbnails to render
+     * @return Images of the thumbnails ordered from the highest to the lowest resolution
+     */
+    static std::vector<QImage> render(const TraceThumbnail *thumbnail);
+
+    /**
+     * @brief Selects the image best suited to be displayed at a given width
+     *
+     * The smallest image that is at least as wide as @p width is selected. If no image is wide enough, the most
+     * detailed image is returned.
+     *
+     * @param levels Images as returned by render()
+     * @param width The width in device pixels the image is displayed at
+     * @return The selected image or a null image if @p levels is empty
+     */
+    static QImage select(const std::vector<QImage> &levels, int width);
+};
+
+
+#endif //MOTIV_TRACEOVERVIEWRENDERER_HPP
@@ -0,0 +1,40 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_COMMUNICATIONBUNDLEINDICATOR_HPP
+#define MOTIV_COMMUNICATIONBUNDLEINDICATOR_HPP
+
+#include <QGraphicsPolygonItem>
+#include "GenericIndicator.hpp"
+#include "src/models/communication/CommunicationBundle.hpp"
+
+/**
+ * A QGraphicsItem showing a bundle of communications to be added to a QGraphicsScene
+ */
+class CommunicationBundleIndicator : public GenericIndicator<CommunicationBundle, QGraphicsPolygonItem> {
+public:
+    /**
+     * Creates a new instance
+     * @param bundle The represented bundle
+     * @param from Mean origin of the bundled communications
+     * @param to Mean target of the bundled communications
+     */
+    CommunicationBundleIndicator(CommunicationBundle *bundle, QPointF from, QPointF to);
+};
+
+
+#endif //MOTIV_COMMUNICATIONBUNDLEINDICATOR_HPP
@@ -21,6 +21,7 @@
 #include <QGraphicsSceneMouseEvent>
 
 #include "src/models/communication/Communication.hpp"
+#include "src/models/communication/CommunicationBundle.hpp"
 #include "src/models/Slot.hpp"
 #include "src/ui/Constants.hpp"
 #include "src/models/communication/CollectiveCommunicationEvent.hpp"
@@ -85,5 +86,6 @@ void GenericIndicator<T, G>::hoverLeaveEvent(QGraphicsSceneHoverEvent *event) {
 }
 
 template class GenericIndicator<Communication, QGraphicsPolygonItem>;
+template class GenericIndicator<CommunicationBundle, QGraphicsPolygonItem>;
 template class GenericIndicator<Slot, QGraphicsRectItem>;
 template class GenericIndicator<CollectiveCommunicationEvent, QGraphicsRectItem>;
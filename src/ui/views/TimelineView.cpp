@@ -17,13 +17,18 @@
  */
 #include "TimelineView.hpp"
 #include "src/ui/views/CommunicationIndicator.hpp"
+#include "src/ui/views/CommunicationBundleIndicator.hpp"
 #include "src/ui/views/SlotIndicator.hpp"
 #include "src/ui/Constants.hpp"
+#include "src/ui/PerformanceMonitor.hpp"
+#include "src/models/MemoryAccounting.hpp"
 #include "CollectiveCommunicationIndicator.hpp"
 
+#include <QGraphicsPathItem>
 #include <QGraphicsRectItem>
 #include <QApplication>
 #include <QWheelEvent>
+#include <cmath>
 
 TimelineView::TimelineView(TraceDataProxy *data, QWidget *parent) : QGraphicsView(parent), data(data) {
     auto scene = new QGraphicsScene();
@@ -35,8 +40,21 @@ TimelineView::TimelineView(TraceDataProxy *data, QWidget *parent) : QGraphicsVie
 
     // @formatter:off
     connect(this->data, SIGNAL(selectionChanged(types::TraceTime,types::TraceTime)), this, SLOT(updateView()));
+    connect(this->data, SIGNAL(selectionRequested(types::TraceTime,types::TraceTime)), this, SLOT(previewSelection(types::TraceTime,types::TraceTime)));
     connect(this->data, SIGNAL(filterChanged(Filter)), this, SLOT(updateView()));
+    connect(this->data, SIGNAL(waitStateAnalysisFinished()), this, SLOT(updateView()));
+    connect(this->data, SIGNAL(criticalPathFinished()), this, SLOT(updateView()));
     // @formatter:on
+
+    // Slots make up most of the items, their size is used as estimate for all items
+    MemoryAccounting::getInstance().registerReporter(this, [this](MemoryReport &report) {
+        auto items = static_cast<size_t>(this->scene()->items().size());
+        report.add(MemoryReport::SceneItems, items, items * sizeof(SlotIndicator));
+    });
+}
+
+TimelineView::~TimelineView() {
+    MemoryAccounting::getInstance().unregisterReporter(this);
 }
 
 
@@ -45,11 +63,21 @@ void TimelineView::populateScene(QGraphicsScene *scene) {
     auto selection = this->data->getSelection();
     auto runtime = selection->getRuntime().count();
     auto runtimeR = static_cast<qreal>(runtime);
-    auto begin = this->data->getBegin().count();
+    // The selection may lag behind the requested window while it is computed, hence its own start time is used
+    auto begin = selection->getStartTime().count();
     auto beginR = static_cast<qreal>(begin);
     auto end = begin + runtime;
     auto endR = static_cast<qreal>(end);
 
+    // The minimum sizes are defined in device pixels, the scene uses device independent pixels
+    auto minSlotWidth = data->getSettings()->getMinSlotSizePx() / this->devicePixelRatioF();
+
+    renderedBegin = selection->getStartTime();
+    renderedRuntime = selection->getRuntime();
+    contentItem = new QGraphicsRectItem();
+    contentItem->setFlag(QGraphicsItem::ItemHasNoContents);
+    scene->addItem(contentItem);
+
     QPen arrowPen(Qt::black, 1);
     QPen collectiveCommunicationPen(colors::COLOR_COLLECTIVE_COMMUNICATION, 2);
 
@@ -62,11 +90,32 @@ void TimelineView::populateScene(QGraphicsScene *scene) {
 
     auto top = 20;
     auto ROW_HEIGHT = 30;
+    auto callStackShown = data->getSettings()->isCallStackShown();
+    const WaitStateAnalysis *waitStates = nullptr;
+    std::map<uint64_t, size_t> waitStateRanks;
+    if (data->getSettings()->isWaitStatesShown()) {
+        // Null while the analysis runs in the background, the view is drawn again once it is available
+        waitStates = data->getWaitStateAnalysis();
+        for (size_t i = 0; waitStates && i < waitStates->getRanks().size(); i++) {
+            waitStateRanks[waitStates->getRanks()[i]->ref().get()] = i;
+        }
+    }
+    // Vertical center of the row of each rank, communications are drawn between these
+    std::map<uint64_t, qreal> rowCenters;
     for (const auto &item: selection->getSlots()) {
+        rowCenters[item.first->ref().get()] = top + .5 * ROW_HEIGHT;
+
+        // With call stacks shown the row is divided into a lane per call depth, otherwise slots overlap in the row
+        uint32_t maxDepth = 0;
+        if (callStackShown) {
+            for (const auto &slot: item.second) {
+                maxDepth = qMax(maxDepth, slot->depth);
+            }
+        }
+        auto laneHeight = static_cast<qreal>(ROW_HEIGHT) / (maxDepth + 1);
+
         // Display slots
         for (const auto &slot: item.second) {
-            if (!(slot->getKind() & data->getSettings()->getFilter().getSlotKinds())) continue;
-
             auto region = slot->region;
             auto regionName = region->name();
             auto regionNameStr = regionName.str();
@@ -83,7 +132,8 @@ void TimelineView::populateScene(QGraphicsScene *scene) {
             auto slotRuntime = static_cast<qreal>(effectiveEndTime - effectiveStartTime);
             auto rectWidth = (slotRuntime / static_cast<qreal>(runtime)) * width;
 
-            QRectF rect(slotBeginPos, top, qMax(rectWidth, 5.0), ROW_HEIGHT);
+            auto laneTop = callStackShown ? top + slot->depth * laneHeight : top;
+            QRectF rect(slotBeginPos, laneTop, qMax(rectWidth, minSlotWidth), laneHeight);
             auto rectItem = new SlotIndicator(rect, slot);
             rectItem->setOnDoubleClick(onTimedElementDoubleClicked);
             rectItem->setOnSelected(onTimedElementSelected);
@@ -108,7 +158,38 @@ void TimelineView::populateScene(QGraphicsScene *scene) {
                     break;
             }
             rectItem->setBrush(rectColor);
-            scene->addItem(rectItem);
+            rectItem->setParentItem(contentItem);
+        }
+
+        // Waiting time is marked in the lower third of the row, waits closer than a pixel are merged
+        if (waitStates && waitStateRanks.contains(item.first->ref().get())) {
+            auto [first, last] = waitStates->inWindow(waitStateRanks[item.first->ref().get()],
+                                                      types::TraceTime(begin), types::TraceTime(end));
+            QRectF pending;
+            auto flush = [&] {
+                if (pending.isNull()) return;
+                auto highlight = new QGraphicsRectItem(pending);
+                highlight->setBrush(colors::COLOR_WAIT_STATE);
+                highlight->setPen(Qt::NoPen);
+                highlight->setAcceptedMouseButtons(Qt::NoButton);
+                highlight->setZValue(layers::Z_LAYER_SLOT_HIGHLIGHTS);
+                highlight->setParentItem(contentItem);
+            };
+            for (auto it = first; it != last; ++it) {
+                auto waitBegin = qMax(begin, it->slot->startTime.count());
+                auto waitEnd = qMin(end, (it->slot->startTime + it->time).count());
+                if (waitEnd <= waitBegin) continue;
+
+                auto x = static_cast<qreal>(waitBegin - begin) / runtimeR * width;
+                auto w = qMax(static_cast<qreal>(waitEnd - waitBegin) / runtimeR * width, minSlotWidth);
+                if (!pending.isNull() && x <= pending.right() + 1) {
+                    pending.setRight(qMax(pending.right(), x + w));
+                    continue;
+                }
+                flush();
+                pending = QRectF(x, top + ROW_HEIGHT * 2. / 3, w, ROW_HEIGHT / 3.);
+            }
+            flush();
         }
 
         top += ROW_HEIGHT;
@@ -121,8 +202,8 @@ void TimelineView::populateScene(QGraphicsScene *scene) {
 
 
         const CommunicationEvent *endEvent = communication->getEndEvent();
-        auto endEventEnd = static_cast<qreal>(startEvent->getEndTime().count());
-        auto endEventStart = static_cast<qreal>(startEvent->getStartTime().count());
+        auto endEventEnd = static_cast<qreal>(endEvent->getEndTime().count());
+        auto endEventStart = static_cast<qreal>(endEvent->getStartTime().count());
 
 
         auto fromTime = startEventStart + (startEventEnd - startEventStart) / 2;
@@ -131,21 +212,46 @@ void TimelineView::populateScene(QGraphicsScene *scene) {
         auto toTime = endEventStart + (endEventEnd - endEventStart) / 2;
         auto effectiveToTime = qMin(endR, toTime) - beginR;
 
-        auto fromRank = startEvent->getLocation()->ref().get();
-        auto toRank = endEvent->getLocation()->ref().get();
+        auto fromRow = rowCenters.find(startEvent->getLocation()->location_group().ref().get());
+        auto toRow = rowCenters.find(endEvent->getLocation()->location_group().ref().get());
+        if (fromRow == rowCenters.end() || toRow == rowCenters.end()) continue;
 
         auto fromX = effectiveFromTime / runtimeR * width;
-        auto fromY = static_cast<qreal>(fromRank * ROW_HEIGHT) + .5 * ROW_HEIGHT + 20;
+        auto fromY = fromRow->second;
 
         auto toX = effectiveToTime / runtimeR * width;
-        auto toY = static_cast<qreal> (toRank * ROW_HEIGHT) + .5 * ROW_HEIGHT + 20;
+        auto toY = toRow->second;
 
         auto arrow = new CommunicationIndicator(communication, fromX, fromY, toX, toY);
         arrow->setOnSelected(onTimedElementSelected);
         arrow->setOnDoubleClick(onTimedElementDoubleClicked);
         arrow->setPen(arrowPen);
         arrow->setZValue(layers::Z_LAYER_P2P_COMMUNICATIONS);
-        scene->addItem(arrow);
+        arrow->setParentItem(contentItem);
+    }
+
+    for (const auto &bundle: selection->getCommunicationBundles()) {
+        auto representative = bundle->getRepresentative();
+        auto fromRow = rowCenters.find(representative->getStartEvent()->getLocation()->location_group().ref().get());
+        auto toRow = rowCenters.find(representative->getEndEvent()->getLocation()->location_group().ref().get());
+        if (fromRow == rowCenters.end() || toRow == rowCenters.end()) continue;
+
+        auto effectiveFromTime = qBound(beginR, bundle->getMeanSendTime(), endR) - beginR;
+        auto effectiveToTime = qBound(beginR, bundle->getMeanReceiveTime(), endR) - beginR;
+
+        QPointF from(effectiveFromTime / runtimeR * width, fromRow->second);
+        QPointF to(effectiveToTime / runtimeR * width, toRow->second);
+
+        // The line width grows logarithmically with the number of bundled messages
+        auto penWidth = qMin(1 + static_cast<int>(std::log2(static_cast<double>(bundle->getCount()))), 8);
+
+        auto line = new CommunicationBundleIndicator(bundle, from, to);
+        line->setOnSelected(onTimedElementSelected);
+        line->setOnDoubleClick(onTimedElementDoubleClicked);
+        line->setPen(QPen(Qt::black, penWidth));
+        line->setToolTip(QString("%1 messages, %2 bytes").arg(bundle->getCount()).arg(bundle->getBytes()));
+        line->setZValue(layers::Z_LAYER_P2P_COMMUNICATIONS);
+        line->setParentItem(contentItem);
     }
 
     for (const auto &communication: selection->getCollectiveCommunications()) {
@@ -166,20 +272,61 @@ void TimelineView::populateScene(QGraphicsScene *scene) {
         rectItem->setRect(QRectF(QPointF(fromX, fromY), QPointF(toX, toY)));
         rectItem->setPen(collectiveCommunicationPen);
         rectItem->setZValue(layers::Z_LAYER_COLLECTIVE_COMMUNICATIONS);
-        scene->addItem(rectItem);
+        rectItem->setParentItem(contentItem);
     }
 
+    // The critical path is drawn as a single line through the row centers, points closer than a pixel are skipped.
+    // It is null while it is computed in the background, the view is drawn again once it is available.
+    auto criticalPath = data->getSettings()->isCriticalPathShown() ? data->getCriticalPath() : nullptr;
+    if (criticalPath) {
+        auto [first, last] = criticalPath->inWindow(types::TraceTime(begin), types::TraceTime(end));
+        QPainterPath path;
+        QPointF pathEnd;
+        for (auto it = first; it != last; ++it) {
+            auto row = rowCenters.find(it->rank->ref().get());
+            if (row == rowCenters.end()) continue;
+
+            auto fromX = static_cast<qreal>(qMax(begin, it->from.count()) - begin) / runtimeR * width;
+            auto toX = static_cast<qreal>(qMin(end, it->to.count()) - begin) / runtimeR * width;
+            if (path.elementCount() == 0) {
+                path.moveTo(fromX, row->second);
+            } else if (path.currentPosition().y() != row->second || fromX - path.currentPosition().x() >= 1) {
+                path.lineTo(fromX, row->second);
+            }
+            if (toX - path.currentPosition().x() >= 1) {
+                path.lineTo(toX, row->second);
+            }
+            pathEnd = QPointF(toX, row->second);
+        }
+        if (path.elementCount() > 0 && path.currentPosition() != pathEnd) {
+            path.lineTo(pathEnd);
+        }
+
+        auto pathItem = new QGraphicsPathItem(path);
+        pathItem->setPen(QPen(colors::COLOR_CRITICAL_PATH, 3));
+        pathItem->setAcceptedMouseButtons(Qt::NoButton);
+        pathItem->setZValue(layers::Z_LAYER_CRITICAL_PATH);
+        pathItem->setParentItem(contentItem);
+    }
 }
 
 
 void TimelineView::resizeEvent(QResizeEvent *event) {
-    this->updateView();
     QGraphicsView::resizeEvent(event);
+
+    auto resolution = qRound(this->viewport()->width() * this->devicePixelRatioF());
+    if (resolution != this->data->getResolution()) {
+        // Recomputes the selection for the new resolution which in turn updates the view
+        this->data->setResolution(resolution);
+    } else {
+        this->updateView();
+    }
 }
 
 void TimelineView::updateView() {
     // TODO it might be more performant to keep track of items and add/remove new/leaving items and resizing them
     this->scene()->clear();
+    contentItem = nullptr;
 
     auto ROW_HEIGHT = 30;
     auto sceneHeight = this->data->getSelection()->getSlots().size() * ROW_HEIGHT;
@@ -187,9 +334,31 @@ void TimelineView::updateView() {
     sceneRect.setHeight(sceneHeight);
 
     this->scene()->setSceneRect(sceneRect);
+
+    PerformanceMonitor::ScopedTimer timer(PerformanceMonitor::PopulateScene);
     this->populateScene(this->scene());
 }
 
+void TimelineView::paintEvent(QPaintEvent *event) {
+    {
+        PerformanceMonitor::ScopedTimer timer(PerformanceMonitor::Paint);
+        QGraphicsView::paintEvent(event);
+    }
+
+    PerformanceMonitor::getInstance().finishFrame();
+}
+
+void TimelineView::previewSelection(types::TraceTime newBegin, types::TraceTime newEnd) {
+    auto newRuntime = static_cast<qreal>((newEnd - newBegin).count());
+    if (!contentItem || renderedRuntime.count() <= 0 || newRuntime <= 0) return;
+
+    // Maps the time window that was rendered onto the requested one
+    auto width = this->scene()->width();
+    auto scale = static_cast<qreal>(renderedRuntime.count()) / newRuntime;
+    auto offset = static_cast<qreal>((renderedBegin - newBegin).count()) / newRuntime * width;
+    contentItem->setTransform(QTransform(scale, 0, 0, 1, offset, 0));
+}
+
 void TimelineView::wheelEvent(QWheelEvent *event) {
     // Calculation according to https://doc.qt.io/qt-6/qwheelevent.html#angleDelta:
     // @c angleDelta is in eights of a degree and most mouse wheels work in steps of 15 degrees.
@@ -198,7 +367,9 @@ void TimelineView::wheelEvent(QWheelEvent *event) {
     if (!numDegrees.isNull() && QApplication::keyboardModifiers() & (Qt::CTRL | Qt::SHIFT)) {
         // See documentation and comment above
         QPoint numSteps = numDegrees / 15;
-        auto stepSize = data->getSelection()->getRuntime() / data->getSettings()->getZoomQuotient();
+        // The requested window is used rather than the selection, which may still be computed
+        auto runtime = data->getEnd() - data->getBegin();
+        auto stepSize = runtime / data->getSettings()->getZoomQuotient();
         auto deltaDuration = stepSize * numSteps.y();
         auto delta = static_cast<double>(deltaDuration.count());
 
@@ -211,20 +382,20 @@ void TimelineView::wheelEvent(QWheelEvent *event) {
             auto leftDelta = types::TraceTime(static_cast<long>(originFactor * 2 * delta));
             auto rightDelta = types::TraceTime(static_cast<long>((1 - originFactor) * 2 * delta));
 
-            newBegin = data->getSelection()->getStartTime() + leftDelta;
-            newEnd = data->getSelection()->getStartTime() + data->getSelection()->getRuntime() - rightDelta;
+            newBegin = data->getBegin() + leftDelta;
+            newEnd = data->getEnd() - rightDelta;
         } else {
             // Calculate new absolute times (might be negative or to large)
-            auto newBeginAbs = data->getSelection()->getStartTime() - deltaDuration;
-            auto newEndAbs = data->getSelection()->getStartTime() + data->getSelection()->getRuntime() - deltaDuration;
+            auto newBeginAbs = data->getBegin() - deltaDuration;
+            auto newEndAbs = data->getEnd() - deltaDuration;
 
             // Limit the times to their boundaries (0 for start and end of entire trace for end)
             auto newBeginBounded = qMax(newBeginAbs, types::TraceTime(0));
             auto newEndBounded = qMin(newEndAbs, data->getTotalRuntime());
 
             // If one time exceeds the bounds reject the changes
-            newBegin = qMin(newBeginBounded, newEndBounded - data->getSelection()->getRuntime());
-            newEnd = qMax(newEndBounded, newBeginBounded + data->getSelection()->getRuntime());
+            newBegin = qMin(newBeginBounded, newEndBounded - runtime);
+            newEnd = qMax(newEndBounded, newBeginBounded + runtime);
         }
 
         data->setSelection(newBegin, newEnd);
@@ -19,6 +19,7 @@
 #define MOTIV_TIMELINEVIEW_HPP
 
 
+#include <QGraphicsRectItem>
 #include <QGraphicsView>
 
 #include "src/ui/TraceDataProxy.hpp"
@@ -27,7 +28,8 @@
  * @brief The main view component rendering the trace
  *
  * This class is the main component responsible for rendering all slots, communications and collective communications.
- * The scene is rerendered whenever the selected time window of the trace changes or the window is resized.
+ * The scene is rerendered whenever the selected time window of the trace changes or the window is resized. While a new
+ * selection is computed, the previously rendered scene is rescaled to the requested time window.
  */
 class TimelineView : public QGraphicsView {
 Q_OBJECT
@@ -40,6 +42,7 @@ public:
      * @param parent The parent QWidget
      */
     explicit TimelineView(TraceDataProxy *data, QWidget *parent = nullptr);
+    ~TimelineView() override;
 
 public: Q_SIGNALS:
     /**
@@ -57,6 +60,15 @@ public Q_SLOTS:
      */
     void updateView();
 
+    /**
+     * @brief Rescales the currently rendered scene to a requested time window.
+     *
+     * This gives immediate feedback until the selection for the new time window is available.
+     * @param newBegin The requested start time
+     * @param newEnd The requested end time
+     */
+    void previewSelection(types::TraceTime newBegin, types::TraceTime newEnd);
+
 protected:
     /**
      * @copydoc QGraphicsView::resizeEvent(QResizeEvent*)
@@ -68,11 +80,23 @@ protected:
      */
     void wheelEvent(QWheelEvent *event) override;
 
+    /**
+     * @copydoc QGraphicsView::paintEvent(QPaintEvent*)
+     */
+    void paintEvent(QPaintEvent *event) override;
+
 private:
     void populateScene(QGraphicsScene *element);
 
 private:
     TraceDataProxy *data = nullptr;
+
+    /**
+     * Parent of all items rendering the selection, allows rescaling them at once
+     */
+    QGraphicsRectItem *contentItem = nullptr;
+    types::TraceTime renderedBegin{0};
+    types::TraceTime renderedRuntime{0};
 };
 
 
@@ -16,16 +16,20 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "TraceOverviewTimelineView.hpp"
-#include "src/ui/views/CommunicationIndicator.hpp"
 #include "src/ui/Constants.hpp"
-#include "src/models/UITrace.hpp"
+#include "src/ui/TraceOverviewRenderer.hpp"
+#include "src/ui/PerformanceMonitor.hpp"
+#include "src/models/MemoryAccounting.hpp"
+#include "src/models/MemoryBudget.hpp"
 
 #include <QGraphicsRectItem>
 #include <QApplication>
 #include <QWheelEvent>
 #include <QRubberBand>
+#include <QtConcurrent/QtConcurrent>
 
-TraceOverviewTimelineView::TraceOverviewTimelineView(Trace *fullTrace, QWidget *parent) : QGraphicsView(parent), fullTrace(fullTrace) {
+TraceOverviewTimelineView::TraceOverviewTimelineView(Trace *fullTrace, const TraceThumbnail *thumbnail, QWidget *parent)
+    : QGraphicsView(parent), fullTrace(fullTrace) {
     auto scene = new QGraphicsScene(this);
     this->setAutoFillBackground(false);
     this->setStyleSheet("background: transparent");
@@ -34,83 +38,118 @@ TraceOverviewTimelineView::TraceOverviewTimelineView(Trace *fullTrace, QWidget *
 
     selectionFrom = types::TraceTime(0);
     selectionTo = fullTrace->getRuntime();
+
+    // The items are created once and only updated afterwards
+    overviewItem = scene->addPixmap(QPixmap());
+
+    QPen selectionPen(Qt::black);
+    QBrush selectionBrush(QColor(0xFF, 0xFF, 0xFF, 0x7F));
+    selectionRectRight = scene->addRect(0, 0, 0, 0, selectionPen, selectionBrush);
+    selectionRectRight->setZValue(layers::Z_LAYER_SELECTION);
+    selectionRectLeft = scene->addRect(0, 0, 0, 0, selectionPen, selectionBrush);
+    selectionRectLeft->setZValue(layers::Z_LAYER_SELECTION);
+
+    connect(&renderWatcher, &QFutureWatcher<std::vector<QImage>>::finished, this,
+            &TraceOverviewTimelineView::renderFinished);
+    if (thumbnail) {
+        // Thumbnails only have a few samples per row, they are rendered right away and never evicted
+        overviewLevels = TraceOverviewRenderer::render(thumbnail);
+    } else {
+        renderWatcher.setFuture(QtConcurrent::run(qOverload<Trace *>(&TraceOverviewRenderer::render), fullTrace));
+    }
+
+    MemoryAccounting::getInstance().registerReporter(this, [this](MemoryReport &report) {
+        for (const auto &level: overviewLevels) {
+            report.add(MemoryReport::LodCaches, 1, static_cast<size_t>(level.sizeInBytes()));
+        }
+        auto items = static_cast<size_t>(this->scene()->items().size());
+        report.add(MemoryReport::SceneItems, items, items * sizeof(QGraphicsRectItem));
+    });
+}
+
+TraceOverviewTimelineView::~TraceOverviewTimelineView() {
+    MemoryAccounting::getInstance().unregisterReporter(this);
+    MemoryBudget::getInstance().remove(this);
+    // The renderer reads the trace, it must not keep running once the trace might be deleted
+    renderWatcher.waitForFinished();
+}
+
+void TraceOverviewTimelineView::renderFinished() {
+    auto levels = renderWatcher.result();
+    if (levels.empty()) return;
+    auto smallest = levels.back();
+
+    // The most detailed levels are dropped until the remaining ones fit into the budget
+    overviewLevels = std::move(levels);
+    while (!overviewLevels.empty()) {
+        size_t bytes = 0;
+        for (const auto &level: overviewLevels) {
+            bytes += static_cast<size_t>(level.sizeInBytes());
+        }
+        if (MemoryBudget::getInstance().add(this, bytes, [this] { evictOverview(); })) break;
+        overviewLevels.erase(overviewLevels.begin());
+    }
+
+    if (!overviewLevels.empty()) {
+        rejectedBudget = 0;
+        this->updateView();
+        return;
+    }
+
+    // Not even the smallest image fits. It is shown once and its pixmap kept, rendering it again would be rejected as
+    // well, so the trace is only rendered again once the budget changes.
+    rejectedBudget = MemoryBudget::getInstance().getBudget();
+    overviewLevels = {smallest};
+    this->updateView();
+    overviewLevels.clear();
 }
 
+void TraceOverviewTimelineView::evictOverview() {
+    overviewLevels.clear();
+    overviewEvicted = true;
+}
 
 void TraceOverviewTimelineView::populateScene(QGraphicsScene *scene) {
     auto width = scene->width();
-    auto runtime = uiTrace->getRuntime().count();
-    auto begin = 0;
-    auto end = begin + runtime;
-
-    qreal top = 0;
-    auto ROW_HEIGHT = scene->height() / static_cast<qreal>(uiTrace->getSlots().size());
-    for (const auto &item: uiTrace->getSlots()) {
-        // Display slots
-        for (const auto &slot: item.second) {
-            auto startTime = slot->startTime.count();
-            auto endTime = slot->endTime.count();
-
-
-            // Ensures slots starting before `begin` (like main) are considered to start at begin
-            auto effectiveStartTime = qMax(begin, startTime);
-            // Ensures slots ending after `end` (like main) are considered to end at end
-            auto effectiveEndTime = qMin(end, endTime);
-
-            auto slotBeginPos = qMax(0.0,
-                                     (static_cast<qreal>(effectiveStartTime - begin) / static_cast<qreal>(runtime)) *
-                                     width);
-            auto slotRuntime = static_cast<qreal>(effectiveEndTime - effectiveStartTime);
-            auto rectWidth = (slotRuntime / static_cast<qreal>(runtime)) * width;
-
-            QRectF rect(slotBeginPos, top, qMax(rectWidth, 5.0), ROW_HEIGHT);
-            auto rectItem = scene->addRect(rect);
-
-            // Determine color based on name
-            QColor rectColor;
-            switch (slot->getKind()) {
-                case ::MPI:
-                    rectColor = colors::COLOR_SLOT_MPI;
-                    rectItem->setZValue(layers::Z_LAYER_SLOTS_MIN_PRIORITY + 2);
-                    break;
-                case ::OpenMP:
-                    rectColor = colors::COLOR_SLOT_OPEN_MP;
-                    rectItem->setZValue(layers::Z_LAYER_SLOTS_MIN_PRIORITY + 1);
-                    break;
-                case ::None:
-                case ::Plain:
-                    rectColor = colors::COLOR_SLOT_PLAIN;
-                    rectItem->setZValue(layers::Z_LAYER_SLOTS_MIN_PRIORITY + 0);
-                    break;
-            }
-
-            rectItem->setBrush(rectColor);
-        }
+    auto height = scene->height();
+    auto ratio = this->devicePixelRatioF();
+    auto deviceWidth = qRound(width * ratio);
+    auto deviceHeight = qRound(height * ratio);
+
+    auto budgetChanged = rejectedBudget != 0 && rejectedBudget != MemoryBudget::getInstance().getBudget();
+    if ((overviewEvicted || budgetChanged) && !renderWatcher.isRunning()) {
+        // The previous pixmap is kept until the images are rendered again
+        overviewEvicted = false;
+        rejectedBudget = 0;
+        renderWatcher.setFuture(QtConcurrent::run(qOverload<Trace *>(&TraceOverviewRenderer::render), fullTrace));
+    }
 
-        top += ROW_HEIGHT;
+    auto level = TraceOverviewRenderer::select(overviewLevels, deviceWidth);
+    PerformanceMonitor::getInstance().recordCacheAccess(!level.isNull());
+    if (!level.isNull()) {
+        MemoryBudget::getInstance().touch(this);
+    }
+    if (!level.isNull() && deviceWidth > 0 && deviceHeight > 0) {
+        // Each rank is a single pixel row in the rendered image. Scaling without interpolation keeps the rows sharp.
+        auto pixmap = QPixmap::fromImage(
+            level.scaled(deviceWidth, deviceHeight, Qt::IgnoreAspectRatio, Qt::FastTransformation));
+        pixmap.setDevicePixelRatio(ratio);
+        overviewItem->setPixmap(pixmap);
     }
 
-    QPen selectionPen(Qt::black);
-    QBrush selectionBrush(QColor(0xFF, 0xFF, 0xFF, 0x7F));
-    selectionRectRight = scene->addRect(width - 1,0, 0, top, selectionPen, selectionBrush);
-    selectionRectRight->setZValue(layers::Z_LAYER_SELECTION);
-    selectionRectLeft = scene->addRect(0,0, 0, top, selectionPen, selectionBrush);
-    selectionRectLeft->setZValue(layers::Z_LAYER_SELECTION);
+    selectionRectRight->setRect(width - 1, 0, 0, height);
+    selectionRectLeft->setRect(0, 0, 0, height);
 
     setSelectionWindow(selectionFrom, selectionTo);
 }
 
 
 void TraceOverviewTimelineView::resizeEvent(QResizeEvent *event) {
-    uiTrace = UITrace::forResolution(fullTrace, event->size().width());
-
     this->updateView();
     QGraphicsView::resizeEvent(event);
 }
 
 void TraceOverviewTimelineView::updateView() {
-    this->scene()->clear();
-
     auto sceneRect = this->rect();
     sceneRect.setHeight(size().height() - 2);
 
@@ -121,7 +160,7 @@ void TraceOverviewTimelineView::updateView() {
 void TraceOverviewTimelineView::setSelectionWindow(types::TraceTime from, types::TraceTime to) {
     selectionFrom = from;
     selectionTo = to;
-    auto durationR = static_cast<qreal>(uiTrace->getRuntime().count());
+    auto durationR = static_cast<qreal>(fullTrace->getRuntime().count());
     auto fromR = static_cast<qreal>(from.count());
     auto toR = static_cast<qreal>(to.count());
     auto width = this->width();
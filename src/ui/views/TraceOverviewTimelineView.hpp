@@ -21,6 +21,9 @@
 
 #include <QGraphicsView>
 #include <QGraphicsScene>
+#include <QGraphicsPixmapItem>
+#include <QFutureWatcher>
+#include <QImage>
 #include <QResizeEvent>
 #include <QRubberBand>
 #include "src/ui/TraceDataProxy.hpp"
@@ -29,6 +32,10 @@
  *
  * A TraceOverviewTimelineView always shows the entire loaded trace but highlights the current selected time window.
  * Furthermore, it allows selecting a new time range by dragging a selection in the overview.
+ *
+ * The trace is rendered only once in the background into images of several resolutions (see TraceOverviewRenderer).
+ * If the trace archive contains thumbnails, they are rendered right away instead and the slots are not read.
+ * Resizing the view only rescales the best fitting image and changing the selection only moves the shading rectangles.
  */
 class TraceOverviewTimelineView : public QGraphicsView {
 Q_OBJECT
@@ -37,9 +44,12 @@ public:
     /**
      * @brief Creates a new instance of the TraceOverviewTimelineView class.
      * @param fullTrace Pointer to the entire loaded trace
+     * @param thumbnail Thumbnails of the trace archive to render instead of the trace, may be nullptr
      * @param parent The parent QWidget
      */
-    explicit TraceOverviewTimelineView(Trace *fullTrace, QWidget *parent = nullptr);
+    explicit TraceOverviewTimelineView(Trace *fullTrace, const TraceThumbnail *thumbnail = nullptr,
+                                       QWidget *parent = nullptr);
+    ~TraceOverviewTimelineView() override;
 
 public: Q_SIGNALS:
     /**
@@ -86,16 +96,34 @@ protected:
      */
     void resizeEvent(QResizeEvent *event) override;
 
+private Q_SLOTS:
+    /**
+     * @brief Takes over the images rendered in the background and shows them
+     */
+    void renderFinished();
+
 private:
     void populateScene(QGraphicsScene *scene);
 
+    /**
+     * Drops the rendered images, they are rendered again on the next update
+     */
+    void evictOverview();
+
 private:
+    QGraphicsPixmapItem *overviewItem = nullptr;
     QGraphicsRectItem *selectionRectLeft = nullptr;
     QGraphicsRectItem *selectionRectRight = nullptr;
 
 private:
     Trace *fullTrace = nullptr;
-    Trace *uiTrace = nullptr;
+    std::vector<QImage> overviewLevels;
+    QFutureWatcher<std::vector<QImage>> renderWatcher;
+    bool overviewEvicted = false;
+    /**
+     * Budget that was too small for even the smallest image, 0 if the images fit
+     */
+    size_t rejectedBudget = 0;
     QPoint rubberBandOrigin{};
     QRubberBand *rubberBand = nullptr;
     types::TraceTime selectionFrom;
@@ -0,0 +1,59 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CommunicationMatrixDock.hpp"
+
+#include <QVBoxLayout>
+
+CommunicationMatrixDock::CommunicationMatrixDock(TraceDataProxy *data, QWidget *parent)
+    : QDockWidget(parent), data(data) {
+    setWindowTitle(tr("Communication matrix"));
+
+    auto widget = new QWidget(this);
+    auto layout = new QVBoxLayout(widget);
+
+    metricField = new QComboBox;
+    metricField->addItem(tr("Messages"));
+    metricField->addItem(tr("Bytes"));
+    metricField->addItem(tr("Transfer time"));
+    statusField = new QLabel;
+    view = new CommunicationMatrixView;
+
+    layout->addWidget(metricField);
+    layout->addWidget(statusField);
+    layout->addWidget(view, 1);
+    widget->setLayout(layout);
+    setWidget(widget);
+
+    connect(metricField, &QComboBox::currentIndexChanged, view, &CommunicationMatrixView::setMetric);
+    connect(data, SIGNAL(selectionChanged(types::TraceTime,types::TraceTime)), this, SLOT(updateMatrix()));
+    connect(this, &QDockWidget::visibilityChanged, this, &CommunicationMatrixDock::updateMatrix);
+}
+
+void CommunicationMatrixDock::updateMatrix() {
+    if (!isVisible()) return;
+
+    if (!matrix) {
+        matrix = std::make_unique<CommunicationMatrix>(data->getFullTrace());
+        view->setMatrix(matrix.get());
+    }
+    matrix->setWindow(data->getBegin(), data->getEnd());
+    statusField->setText(tr("%1 messages between %2 ranks in the selected time window")
+                             .arg(matrix->windowSize())
+                             .arg(matrix->getRanks().size()));
+    view->refresh();
+}
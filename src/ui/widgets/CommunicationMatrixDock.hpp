@@ -0,0 +1,67 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_COMMUNICATIONMATRIXDOCK_HPP
+#define MOTIV_COMMUNICATIONMATRIXDOCK_HPP
+
+
+#include <QComboBox>
+#include <QDockWidget>
+#include <QLabel>
+#include <memory>
+
+#include "CommunicationMatrixView.hpp"
+#include "src/models/CommunicationMatrix.hpp"
+#include "src/ui/TraceDataProxy.hpp"
+
+/**
+ * @brief A DockWidget showing the communication matrix of the selected time window
+ *
+ * The number of messages, the transferred bytes or the transfer time between every sender and receiver are drawn as
+ * heatmap. The matrix follows the selected time window while the dock is visible.
+ */
+class CommunicationMatrixDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the CommunicationMatrixDock class
+     * @param data The data proxy providing the trace and the selected time window
+     * @param parent The parent QWidget
+     */
+    explicit CommunicationMatrixDock(TraceDataProxy *data, QWidget *parent = nullptr);
+
+public Q_SLOTS:
+    /**
+     * @brief Moves the matrix to the selected time window
+     */
+    void updateMatrix();
+
+private:
+    TraceDataProxy *data = nullptr;
+    QComboBox *metricField = nullptr;
+    QLabel *statusField = nullptr;
+    CommunicationMatrixView *view = nullptr;
+
+    /**
+     * Created when the dock is shown the first time
+     */
+    std::unique_ptr<CommunicationMatrix> matrix;
+};
+
+
+#endif //MOTIV_COMMUNICATIONMATRIXDOCK_HPP
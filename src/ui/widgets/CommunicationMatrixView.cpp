@@ -0,0 +1,150 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CommunicationMatrixView.hpp"
+
+#include <QLocale>
+#include <QMouseEvent>
+#include <QPainter>
+#include <QToolTip>
+#include <cmath>
+
+namespace {
+    const QColor COLOR_HEATMAP_LOW = QColor::fromRgb(0xFFF3E0);
+    const QColor COLOR_HEATMAP_HIGH = QColor::fromRgb(0xBF360C);
+}
+
+static QRgb interpolate(double t) {
+    auto mix = [t](int low, int high) { return static_cast<int>(low + t * (high - low)); };
+    return qRgb(mix(COLOR_HEATMAP_LOW.red(), COLOR_HEATMAP_HIGH.red()),
+                mix(COLOR_HEATMAP_LOW.green(), COLOR_HEATMAP_HIGH.green()),
+                mix(COLOR_HEATMAP_LOW.blue(), COLOR_HEATMAP_HIGH.blue()));
+}
+
+CommunicationMatrixView::CommunicationMatrixView(QWidget *parent) : QWidget(parent) {
+    setMinimumSize(100, 100);
+    setMouseTracking(true);
+}
+
+QSize CommunicationMatrixView::sizeHint() const {
+    return {300, 300};
+}
+
+void CommunicationMatrixView::setMatrix(const CommunicationMatrix *newMatrix) {
+    matrix = newMatrix;
+    refresh();
+}
+
+void CommunicationMatrixView::setMetric(int newMetric) {
+    metric = static_cast<Metric>(newMetric);
+    refresh();
+}
+
+void CommunicationMatrixView::refresh() {
+    if (!matrix || matrix->getRanks().empty()) {
+        cells.clear();
+        blocks = 0;
+        image = QImage();
+        update();
+        return;
+    }
+
+    // At most one block per pixel
+    auto ranks = matrix->getRanks().size();
+    auto side = static_cast<size_t>(std::max(1, std::min(width(), height())));
+    auto maxBlocks = std::min<size_t>(COMMUNICATION_MATRIX_MAX_BLOCKS, side);
+    blockSize = (ranks + maxBlocks - 1) / maxBlocks;
+    blocks = matrix->blocksPerAxis(blockSize);
+    cells = matrix->aggregate(blockSize);
+
+    double maxValue = 0;
+    for (const auto &cell: cells) {
+        maxValue = std::max(maxValue, value(cell));
+    }
+
+    image = QImage(static_cast<int>(blocks), static_cast<int>(blocks), QImage::Format_RGB32);
+    image.fill(palette().base().color());
+    for (size_t sender = 0; sender < blocks; sender++) {
+        auto line = reinterpret_cast<QRgb *>(image.scanLine(static_cast<int>(sender)));
+        for (size_t receiver = 0; receiver < blocks; receiver++) {
+            const auto &cell = cells[sender * blocks + receiver];
+            if (cell.messages == 0) continue;
+            line[receiver] = interpolate(maxValue > 0 ? std::log1p(value(cell)) / std::log1p(maxValue) : 0);
+        }
+    }
+    update();
+}
+
+void CommunicationMatrixView::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().window());
+    if (image.isNull()) return;
+
+    painter.setRenderHint(QPainter::SmoothPixmapTransform, false);
+    painter.drawImage(heatmapRect(), image);
+    painter.setPen(palette().mid().color());
+    painter.drawRect(heatmapRect().adjusted(0, 0, -1, -1));
+}
+
+void CommunicationMatrixView::resizeEvent(QResizeEvent *event) {
+    QWidget::resizeEvent(event);
+    refresh();
+}
+
+void CommunicationMatrixView::mouseMoveEvent(QMouseEvent *event) {
+    auto area = heatmapRect();
+    auto position = event->position().toPoint();
+    if (blocks == 0 || !area.contains(position)) {
+        QToolTip::hideText();
+        return;
+    }
+
+    auto sender = static_cast<size_t>((position.y() - area.top()) * static_cast<qint64>(blocks) / area.height());
+    auto receiver = static_cast<size_t>((position.x() - area.left()) * static_cast<qint64>(blocks) / area.width());
+    const auto &cell = cells[sender * blocks + receiver];
+    const auto &ranks = matrix->getRanks();
+    auto rankName = [&](size_t block) {
+        auto first = block * blockSize;
+        auto last = std::min(first + blockSize, ranks.size()) - 1;
+        auto name = QString::fromStdString(ranks[first]->name().str());
+        return first == last ? name : tr("%1 – %2").arg(name, QString::fromStdString(ranks[last]->name().str()));
+    };
+
+    auto text = tr("%1 → %2\n%3 messages, %4\nTransfer time: %5 ms")
+        .arg(rankName(sender), rankName(receiver))
+        .arg(cell.messages)
+        .arg(QLocale().formattedDataSize(static_cast<qint64>(cell.bytes)))
+        .arg(std::chrono::duration<double, std::milli>(cell.transferTime).count());
+    QToolTip::showText(event->globalPosition().toPoint(), text, this);
+}
+
+double CommunicationMatrixView::value(const CommunicationMatrixCell &cell) const {
+    switch (metric) {
+        case Bytes:
+            return static_cast<double>(cell.bytes);
+        case TransferTime:
+            return static_cast<double>(cell.transferTime.count());
+        default:
+            return static_cast<double>(cell.messages);
+    }
+}
+
+QRect CommunicationMatrixView::heatmapRect() const {
+    // Square and centered, every block gets at least one pixel
+    auto side = std::min(width(), height());
+    return {(width() - side) / 2, (height() - side) / 2, side, side};
+}
@@ -0,0 +1,110 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_COMMUNICATIONMATRIXVIEW_HPP
+#define MOTIV_COMMUNICATIONMATRIXVIEW_HPP
+
+
+#include <QImage>
+#include <QWidget>
+
+#include "src/models/CommunicationMatrix.hpp"
+
+/**
+ * Defines the maximal number of blocks along each axis of the heatmap
+ */
+#define COMMUNICATION_MATRIX_MAX_BLOCKS 512
+
+/**
+ * @brief A widget drawing a CommunicationMatrix as heatmap
+ *
+ * Senders are drawn as rows and receivers as columns. If there are more ranks than pixels, neighbouring ranks are
+ * aggregated into blocks. Colors are scaled logarithmically to the largest block.
+ */
+class CommunicationMatrixView : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief The value of a cell that is shown
+     */
+    enum Metric {
+        Messages,
+        Bytes,
+        TransferTime
+    };
+
+    /**
+     * @brief Creates a new instance of the CommunicationMatrixView class
+     * @param parent The parent QWidget
+     */
+    explicit CommunicationMatrixView(QWidget *parent = nullptr);
+
+    /**
+     * @copydoc QWidget::sizeHint()
+     */
+    [[nodiscard]] QSize sizeHint() const override;
+
+    /**
+     * @brief Sets the matrix to be drawn, it has to be refreshed() whenever the matrix changes
+     * @param newMatrix The matrix
+     */
+    void setMatrix(const CommunicationMatrix *newMatrix);
+
+public Q_SLOTS:
+    /**
+     * @brief Sets the shown value of the cells
+     * @param newMetric The metric
+     */
+    void setMetric(int newMetric);
+
+    /**
+     * @brief Aggregates the matrix again and redraws the heatmap
+     */
+    void refresh();
+
+protected:
+    /**
+     * @copydoc QWidget::paintEvent(QPaintEvent*)
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+    /**
+     * @copydoc QWidget::resizeEvent(QResizeEvent*)
+     */
+    void resizeEvent(QResizeEvent *event) override;
+
+    /**
+     * @copydoc QWidget::mouseMoveEvent(QMouseEvent*)
+     */
+    void mouseMoveEvent(QMouseEvent *event) override;
+
+private:
+    [[nodiscard]] double value(const CommunicationMatrixCell &cell) const;
+    [[nodiscard]] QRect heatmapRect() const;
+
+private:
+    const CommunicationMatrix *matrix = nullptr;
+    Metric metric = Messages;
+    size_t blockSize = 1;
+    size_t blocks = 0;
+    std::vector<CommunicationMatrixCell> cells;
+    QImage image;
+};
+
+
+#endif //MOTIV_COMMUNICATIONMATRIXVIEW_HPP
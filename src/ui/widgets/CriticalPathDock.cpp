@@ -0,0 +1,106 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "CriticalPathDock.hpp"
+
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+enum CriticalPathColumn {
+    NameColumn,
+    TimeColumn,
+    ShareColumn,
+    CriticalPathColumnCount
+};
+
+/**
+ * Creates a numeric item, so the table is sorted by value
+ */
+static QTableWidgetItem *numberItem(double value) {
+    auto item = new QTableWidgetItem;
+    item->setData(Qt::DisplayRole, value);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+static double milliseconds(types::TraceTime time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+CriticalPathDock::CriticalPathDock(TraceDataProxy *data, QWidget *parent) : QDockWidget(parent), data(data) {
+    setWindowTitle(tr("Critical path"));
+
+    auto widget = new QWidget(this);
+    auto layout = new QVBoxLayout(widget);
+
+    groupingField = new QComboBox;
+    groupingField->addItem(tr("By region"));
+    groupingField->addItem(tr("By rank"));
+    lengthField = new QLabel;
+
+    table = new QTableWidget(0, CriticalPathColumnCount);
+    table->setHorizontalHeaderLabels({tr("Name"), tr("Time on path (ms)"), tr("Share (%)")});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->verticalHeader()->hide();
+    table->horizontalHeader()->setSectionResizeMode(NameColumn, QHeaderView::Stretch);
+    table->setSortingEnabled(true);
+    table->sortByColumn(TimeColumn, Qt::DescendingOrder);
+
+    layout->addWidget(groupingField);
+    layout->addWidget(lengthField);
+    layout->addWidget(table);
+    widget->setLayout(layout);
+    setWidget(widget);
+
+    connect(groupingField, &QComboBox::currentIndexChanged, this, &CriticalPathDock::updateTable);
+    connect(this, &QDockWidget::visibilityChanged, this, &CriticalPathDock::updateTable);
+    connect(data, &TraceDataProxy::criticalPathFinished, this, &CriticalPathDock::updateTable);
+}
+
+void CriticalPathDock::updateTable() {
+    if (!isVisible()) return;
+
+    auto path = data->getCriticalPath();
+    if (!path) {
+        lengthField->setText(tr("Computing the critical path..."));
+        return;
+    }
+    auto length = milliseconds(path->length());
+    lengthField->setText(tr("Length: %1 ms in %2 segments").arg(length, 0, 'f', 3).arg(path->getSegments().size()));
+
+    // Sorting is suspended while filling, otherwise rows move while their cells are set
+    table->setSortingEnabled(false);
+    table->setRowCount(0);
+    auto addRow = [this, length](const std::string &name, types::TraceTime time) {
+        auto row = table->rowCount();
+        table->insertRow(row);
+        table->setItem(row, NameColumn, new QTableWidgetItem(QString::fromStdString(name)));
+        table->setItem(row, TimeColumn, numberItem(milliseconds(time)));
+        table->setItem(row, ShareColumn, numberItem(length > 0 ? 100 * milliseconds(time) / length : 0));
+    };
+    if (groupingField->currentIndex() == 0) {
+        for (const auto &share: path->getRegions()) {
+            addRow(share.element->name().str(), share.time);
+        }
+    } else {
+        for (const auto &share: path->getRanks()) {
+            addRow(share.element->name().str(), share.time);
+        }
+    }
+    table->setSortingEnabled(true);
+}
@@ -0,0 +1,56 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_CRITICALPATHDOCK_HPP
+#define MOTIV_CRITICALPATHDOCK_HPP
+
+
+#include <QComboBox>
+#include <QDockWidget>
+#include <QLabel>
+#include <QTableWidget>
+
+#include "src/ui/TraceDataProxy.hpp"
+
+/**
+ * @brief A DockWidget listing how much time regions or ranks spend on the CriticalPath
+ *
+ * The critical path is computed when the dock is shown the first time.
+ */
+class CriticalPathDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the CriticalPathDock class
+     * @param data The data proxy providing the critical path
+     * @param parent The parent QWidget
+     */
+    explicit CriticalPathDock(TraceDataProxy *data, QWidget *parent = nullptr);
+
+private Q_SLOTS:
+    void updateTable();
+
+private:
+    TraceDataProxy *data = nullptr;
+    QComboBox *groupingField = nullptr;
+    QLabel *lengthField = nullptr;
+    QTableWidget *table = nullptr;
+};
+
+
+#endif //MOTIV_CRITICALPATHDOCK_HPP
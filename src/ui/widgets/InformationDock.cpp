@@ -28,7 +28,6 @@ InformationDock::InformationDock(QWidget *parent) : QDockWidget(parent) {
 }
 
 InformationDock::~InformationDock() {
-    delete this->element_;
     for(auto &item : this->strategies_) {
         delete item.first;
         delete item.second;
@@ -80,7 +80,7 @@ public Q_SLOTS:
      */
     void setElement(TimedElement *element);
 
-protected:
+protected Q_SLOTS:
     /**
      * @brief Updates the view
      *
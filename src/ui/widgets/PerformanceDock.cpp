@@ -0,0 +1,113 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PerformanceDock.hpp"
+
+#include <QClipboard>
+#include <QFormLayout>
+#include <QGuiApplication>
+#include <QLocale>
+#include <QPushButton>
+#include <QTextStream>
+
+static QString formatDuration(std::chrono::microseconds duration) {
+    return QString("%1 ms").arg(static_cast<double>(duration.count()) / 1000, 0, 'f', 2);
+}
+
+PerformanceDock::PerformanceDock(QWidget *parent) : QDockWidget(parent) {
+    setWindowTitle(tr("Performance"));
+
+    auto widget = new QWidget(this);
+    auto layout = new QFormLayout(widget);
+    layout->setAlignment(Qt::AlignLeading | Qt::AlignTop);
+
+    subtraceField = new QLabel;
+    forResolutionField = new QLabel;
+    populateSceneField = new QLabel;
+    paintField = new QLabel;
+    totalField = new QLabel;
+    elementsField = new QLabel;
+    cacheField = new QLabel;
+    memoryField = new QLabel;
+    historyView = new PerformanceHistoryView;
+
+    layout->addRow(tr("Subtrace:"), subtraceField);
+    layout->addRow(tr("Level of detail:"), forResolutionField);
+    layout->addRow(tr("Scene:"), populateSceneField);
+    layout->addRow(tr("Paint:"), paintField);
+    layout->addRow(tr("Total:"), totalField);
+    layout->addRow(tr("Elements:"), elementsField);
+    layout->addRow(tr("Cache hits:"), cacheField);
+    layout->addRow(tr("Memory:"), memoryField);
+    layout->addRow(historyView);
+
+    auto copyReportButton = new QPushButton(tr("&Copy report"));
+    connect(copyReportButton, SIGNAL(clicked()), this, SLOT(copyReport()));
+    layout->addWidget(copyReportButton);
+
+    widget->setLayout(layout);
+    setWidget(widget);
+
+    auto &monitor = PerformanceMonitor::getInstance();
+    connect(&monitor, SIGNAL(historyChanged()), this, SLOT(updateView()));
+    connect(this, SIGNAL(visibilityChanged(bool)), &monitor, SLOT(setEnabled(bool)));
+}
+
+void PerformanceDock::updateView() {
+    auto history = PerformanceMonitor::getInstance().getHistory();
+    historyView->setHistory(history);
+    if (history.empty()) return;
+
+    const auto &sample = history.back();
+    subtraceField->setText(formatDuration(sample.subtrace));
+    forResolutionField->setText(formatDuration(sample.forResolution));
+    populateSceneField->setText(formatDuration(sample.populateScene));
+    paintField->setText(formatDuration(sample.paint));
+    totalField->setText(formatDuration(sample.total()));
+    elementsField->setText(tr("%1 → %2").arg(sample.elementsBeforeLod).arg(sample.elementsAfterLod));
+
+    // The hit rate is determined over the entire history as single frames only access the caches a few times
+    size_t hits = 0;
+    size_t accesses = 0;
+    for (const auto &item: history) {
+        hits += item.cacheHits;
+        accesses += item.cacheHits + item.cacheMisses;
+    }
+    if (accesses > 0) {
+        cacheField->setText(QString("%1 %").arg(100. * static_cast<double>(hits) / static_cast<double>(accesses), 0, 'f', 1));
+    } else {
+        cacheField->setText("-");
+    }
+
+    memoryField->setText(sample.residentSetSize ? QLocale().formattedDataSize(static_cast<qint64>(sample.residentSetSize))
+                                                : QString("-"));
+}
+
+void PerformanceDock::copyReport() {
+    QString report;
+    QTextStream stream(&report);
+    stream << "subtrace_us\tfor_resolution_us\tpopulate_scene_us\tpaint_us\telements_before_lod\telements_after_lod"
+              "\tcache_hits\tcache_misses\trss_bytes\n";
+    for (const auto &sample: PerformanceMonitor::getInstance().getHistory()) {
+        stream << sample.subtrace.count() << '\t' << sample.forResolution.count() << '\t'
+               << sample.populateScene.count() << '\t' << sample.paint.count() << '\t'
+               << sample.elementsBeforeLod << '\t' << sample.elementsAfterLod << '\t'
+               << sample.cacheHits << '\t' << sample.cacheMisses << '\t' << sample.residentSetSize << '\n';
+    }
+
+    QGuiApplication::clipboard()->setText(report);
+}
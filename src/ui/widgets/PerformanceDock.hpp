@@ -0,0 +1,67 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_PERFORMANCEDOCK_HPP
+#define MOTIV_PERFORMANCEDOCK_HPP
+
+
+#include <QDockWidget>
+#include <QLabel>
+
+#include "src/ui/widgets/PerformanceHistoryView.hpp"
+
+/**
+ * @brief A DockWidget showing the measurements of the PerformanceMonitor
+ *
+ * The latest sample is shown in detail, the rolling history as a chart. The PerformanceMonitor only records while the
+ * dock is visible. The history can be copied as tab separated values to report it.
+ */
+class PerformanceDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the PerformanceDock class
+     * @param parent The parent QWidget
+     */
+    explicit PerformanceDock(QWidget *parent = nullptr);
+
+public Q_SLOTS:
+    /**
+     * @brief Updates the view to the latest history of the PerformanceMonitor
+     */
+    void updateView();
+
+    /**
+     * @brief Copies the history to the clipboard
+     */
+    void copyReport();
+
+private:
+    QLabel *subtraceField = nullptr;
+    QLabel *forResolutionField = nullptr;
+    QLabel *populateSceneField = nullptr;
+    QLabel *paintField = nullptr;
+    QLabel *totalField = nullptr;
+    QLabel *elementsField = nullptr;
+    QLabel *cacheField = nullptr;
+    QLabel *memoryField = nullptr;
+    PerformanceHistoryView *historyView = nullptr;
+};
+
+
+#endif //MOTIV_PERFORMANCEDOCK_HPP
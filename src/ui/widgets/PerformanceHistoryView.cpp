@@ -0,0 +1,78 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "PerformanceHistoryView.hpp"
+
+#include <QPainter>
+
+namespace {
+    const QColor COLOR_STAGE_SUBTRACE = QColor::fromRgb(0x42A5F5);
+    const QColor COLOR_STAGE_FOR_RESOLUTION = QColor::fromRgb(0x66BB6A);
+    const QColor COLOR_STAGE_POPULATE_SCENE = QColor::fromRgb(0xFFA726);
+    const QColor COLOR_STAGE_PAINT = QColor::fromRgb(0xAB47BC);
+}
+
+PerformanceHistoryView::PerformanceHistoryView(QWidget *parent) : QWidget(parent) {
+    setMinimumHeight(60);
+    setToolTip(tr("Frame times, newest on the right.\n"
+                  "Blue: subtrace, green: level of detail, orange: scene, purple: paint.\n"
+                  "The line marks %1 ms.").arg(PERFORMANCE_FRAME_BUDGET_MS));
+}
+
+QSize PerformanceHistoryView::sizeHint() const {
+    return {PERFORMANCE_HISTORY_SIZE, 100};
+}
+
+void PerformanceHistoryView::setHistory(const std::deque<PerformanceSample> &samples) {
+    history = samples;
+    update();
+}
+
+void PerformanceHistoryView::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    // Scale to at least twice the budget, so the budget line is always visible
+    double maxMs = 2 * PERFORMANCE_FRAME_BUDGET_MS;
+    for (const auto &sample: history) {
+        maxMs = qMax(maxMs, static_cast<double>(sample.total().count()) / 1000);
+    }
+
+    auto h = static_cast<double>(height());
+    auto barWidth = static_cast<double>(width()) / PERFORMANCE_HISTORY_SIZE;
+    // Newest samples are aligned to the right
+    auto x = static_cast<double>(width()) - barWidth * static_cast<double>(history.size());
+
+    for (const auto &sample: history) {
+        auto y = h;
+        auto drawStage = [&](std::chrono::microseconds duration, const QColor &color) {
+            auto stageHeight = static_cast<double>(duration.count()) / 1000 / maxMs * h;
+            painter.fillRect(QRectF(x, y - stageHeight, barWidth, stageHeight), color);
+            y -= stageHeight;
+        };
+
+        drawStage(sample.subtrace, COLOR_STAGE_SUBTRACE);
+        drawStage(sample.forResolution, COLOR_STAGE_FOR_RESOLUTION);
+        drawStage(sample.populateScene, COLOR_STAGE_POPULATE_SCENE);
+        drawStage(sample.paint, COLOR_STAGE_PAINT);
+        x += barWidth;
+    }
+
+    auto budgetY = h - PERFORMANCE_FRAME_BUDGET_MS / maxMs * h;
+    painter.setPen(QPen(Qt::red, 1, Qt::DashLine));
+    painter.drawLine(QPointF(0, budgetY), QPointF(width(), budgetY));
+}
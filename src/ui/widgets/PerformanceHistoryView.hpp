@@ -0,0 +1,70 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_PERFORMANCEHISTORYVIEW_HPP
+#define MOTIV_PERFORMANCEHISTORYVIEW_HPP
+
+
+#include <QWidget>
+#include <deque>
+
+#include "src/ui/PerformanceMonitor.hpp"
+
+/**
+ * Defines the frame time budget in milliseconds that is marked in the history
+ */
+#define PERFORMANCE_FRAME_BUDGET_MS 16
+
+/**
+ * @brief A widget plotting the frame times of the PerformanceMonitor history
+ *
+ * Each sample is drawn as a bar stacking the durations of all stages. A horizontal line marks the frame budget.
+ */
+class PerformanceHistoryView : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the PerformanceHistoryView class
+     * @param parent The parent QWidget
+     */
+    explicit PerformanceHistoryView(QWidget *parent = nullptr);
+
+    /**
+     * @copydoc QWidget::sizeHint()
+     */
+    [[nodiscard]] QSize sizeHint() const override;
+
+public Q_SLOTS:
+    /**
+     * @brief Sets the samples to be plotted
+     * @param samples The samples, oldest first
+     */
+    void setHistory(const std::deque<PerformanceSample> &samples);
+
+protected:
+    /**
+     * @copydoc QWidget::paintEvent(QPaintEvent*)
+     */
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    std::deque<PerformanceSample> history;
+};
+
+
+#endif //MOTIV_PERFORMANCEHISTORYVIEW_HPP
@@ -0,0 +1,168 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ProfileDock.hpp"
+
+#include <QHeaderView>
+#include <QVBoxLayout>
+#include <QtConcurrent/QtConcurrent>
+
+enum ProfileColumn {
+    RegionColumn,
+    CallsColumn,
+    InclusiveColumn,
+    ExclusiveColumn,
+    MinColumn,
+    MaxColumn,
+    ProfileColumnCount
+};
+
+/**
+ * Creates a numeric item, so the table is sorted by value
+ */
+static QTableWidgetItem *numberItem(double value) {
+    auto item = new QTableWidgetItem;
+    item->setData(Qt::DisplayRole, value);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+static double milliseconds(types::TraceTime time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+ProfileDock::ProfileDock(TraceDataProxy *data, QWidget *parent) : QDockWidget(parent), data(data) {
+    setWindowTitle(tr("Profile"));
+
+    auto widget = new QWidget(this);
+    auto layout = new QVBoxLayout(widget);
+
+    rankField = new QComboBox;
+    rankField->addItem(tr("All ranks"));
+    for (const auto &[group, slots]: data->getFullTrace()->getSlots()) {
+        rankField->addItem(QString::fromStdString(group->name().str()));
+    }
+    // Call paths need the calling context tree, which is not built for summaries
+    viewField = new QComboBox;
+    viewField->addItem(tr("Flat profile"));
+    viewField->addItem(tr("Call paths"));
+    viewField->setEnabled(data->getCallingContextTree() != nullptr && data->getSummary() == nullptr);
+    windowField = new QCheckBox(tr("Selected time window only"));
+    windowField->setChecked(true);
+    statusField = new QLabel;
+
+    table = new QTableWidget(0, ProfileColumnCount);
+    table->setHorizontalHeaderLabels({tr("Region"), tr("Calls"), tr("Inclusive (ms)"), tr("Exclusive (ms)"),
+                                      tr("Min (ms)"), tr("Max (ms)")});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->verticalHeader()->hide();
+    table->horizontalHeader()->setSectionResizeMode(RegionColumn, QHeaderView::Stretch);
+    table->setSortingEnabled(true);
+    table->sortByColumn(ExclusiveColumn, Qt::DescendingOrder);
+
+    layout->addWidget(rankField);
+    layout->addWidget(viewField);
+    layout->addWidget(windowField);
+    layout->addWidget(statusField);
+    layout->addWidget(table);
+    widget->setLayout(layout);
+    setWidget(widget);
+
+    connect(&profileWatcher, &QFutureWatcher<ProfileResult>::finished, this, &ProfileDock::profileComputed);
+    connect(rankField, &QComboBox::currentIndexChanged, this, &ProfileDock::updateTable);
+    connect(viewField, &QComboBox::currentIndexChanged, this, &ProfileDock::updateTable);
+    connect(windowField, &QCheckBox::toggled, this, &ProfileDock::updateProfile);
+    connect(data, SIGNAL(selectionChanged(types::TraceTime,types::TraceTime)), this, SLOT(updateProfile()));
+    connect(this, &QDockWidget::visibilityChanged, this, &ProfileDock::updateProfile);
+}
+
+ProfileDock::~ProfileDock() {
+    // The computation reads the trace and the engine, it must not keep running once they are deleted
+    profileWatcher.waitForFinished();
+}
+
+void ProfileDock::updateProfile() {
+    if (!isVisible()) return;
+
+    auto begin = windowField->isChecked() ? data->getBegin() : types::TraceTime(0);
+    auto end = windowField->isChecked() ? data->getEnd() : data->getTotalRuntime();
+    if (profileComputing) {
+        profileOutdated = true;
+        return;
+    }
+    if (begin == profileBegin && end == profileEnd) return;
+
+    profileBegin = begin;
+    profileEnd = end;
+    profileComputing = true;
+    profileOutdated = false;
+    statusField->setText(engine ? tr("Computing…") : tr("Preparing profile…"));
+
+    auto trace = data->getFullTrace();
+    auto summary = data->getSummary();
+    profileWatcher.setFuture(QtConcurrent::run([this, trace, summary, begin, end] {
+        // A summary keeps the profiles of the calls it was loaded from, the slots of its trace are approximations
+        if (summary) {
+            return summary->profile(begin, end);
+        }
+        if (!engine) {
+            engine = std::make_unique<ProfileEngine>(trace);
+        }
+        return engine->compute(begin, end);
+    }));
+}
+
+void ProfileDock::profileComputed() {
+    profileComputing = false;
+    profile = profileWatcher.result();
+    statusField->setText(windowField->isChecked() ? tr("Selected time window") : tr("Whole trace"));
+    updateTable();
+
+    if (profileOutdated) {
+        updateProfile();
+    }
+}
+
+void ProfileDock::updateTable() {
+    auto rankIndex = rankField->currentIndex();
+    auto allRanks = rankIndex <= 0 || static_cast<size_t>(rankIndex) > profile.ranks.size();
+    auto tree = data->getCallingContextTree();
+    auto callPaths = viewField->currentIndex() == 1 && tree && !profile.rankCallPaths.empty();
+    const auto &regions = callPaths ? (allRanks ? profile.totalCallPaths : profile.rankCallPaths[rankIndex - 1])
+                                    : (allRanks ? profile.total : profile.ranks[rankIndex - 1].second);
+    table->setHorizontalHeaderItem(RegionColumn, new QTableWidgetItem(callPaths ? tr("Call path") : tr("Region")));
+
+    // Sorting is suspended while filling, otherwise rows move while their cells are set
+    table->setSortingEnabled(false);
+    table->setRowCount(0);
+    for (const auto &[ref, region]: regions) {
+        if (region.calls == 0) continue;
+
+        auto row = table->rowCount();
+        table->insertRow(row);
+        // Call paths are named from the outermost call, so sorting by name keeps callees below their callers
+        auto name = callPaths ? tree->pathName(ref, " > ") : region.region->name().str();
+        table->setItem(row, RegionColumn, new QTableWidgetItem(QString::fromStdString(name)));
+        table->setItem(row, CallsColumn, numberItem(static_cast<double>(region.calls)));
+        table->setItem(row, InclusiveColumn, numberItem(milliseconds(region.inclusive)));
+        table->setItem(row, ExclusiveColumn, numberItem(milliseconds(region.exclusive)));
+        table->setItem(row, MinColumn, numberItem(milliseconds(region.min)));
+        table->setItem(row, MaxColumn, numberItem(milliseconds(region.max)));
+    }
+    table->setSortingEnabled(true);
+}
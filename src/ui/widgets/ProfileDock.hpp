@@ -0,0 +1,83 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_PROFILEDOCK_HPP
+#define MOTIV_PROFILEDOCK_HPP
+
+
+#include <QCheckBox>
+#include <QComboBox>
+#include <QDockWidget>
+#include <QFutureWatcher>
+#include <QLabel>
+#include <QTableWidget>
+#include <memory>
+
+#include "src/models/ProfileEngine.hpp"
+#include "src/ui/TraceDataProxy.hpp"
+
+/**
+ * @brief A DockWidget showing the flat and the call-path profile of the trace
+ *
+ * Calls and inclusive, exclusive, minimum and maximum times are shown per region or per call path, either for all ranks
+ * or a single one and either for the whole trace or the selected time window. Profiles are computed in the background and only while
+ * the dock is visible.
+ */
+class ProfileDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the ProfileDock class
+     * @param data The data proxy providing the trace and the selected time window
+     * @param parent The parent QWidget
+     */
+    explicit ProfileDock(TraceDataProxy *data, QWidget *parent = nullptr);
+    ~ProfileDock() override;
+
+public Q_SLOTS:
+    /**
+     * @brief Recomputes the profile if the shown window changed
+     */
+    void updateProfile();
+
+private Q_SLOTS:
+    void profileComputed();
+    void updateTable();
+
+private:
+    TraceDataProxy *data = nullptr;
+    QComboBox *rankField = nullptr;
+    QComboBox *viewField = nullptr;
+    QCheckBox *windowField = nullptr;
+    QLabel *statusField = nullptr;
+    QTableWidget *table = nullptr;
+
+    /**
+     * Created by the first computation in the background
+     */
+    std::unique_ptr<ProfileEngine> engine;
+    QFutureWatcher<ProfileResult> profileWatcher;
+    ProfileResult profile;
+    bool profileComputing = false;
+    bool profileOutdated = false;
+    types::TraceTime profileBegin{-1};
+    types::TraceTime profileEnd{-1};
+};
+
+
+#endif //MOTIV_PROFILEDOCK_HPP
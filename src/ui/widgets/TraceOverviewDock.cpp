@@ -21,7 +21,7 @@
 #include "src/ui/views/TraceOverviewTimelineView.hpp"
 
 TraceOverviewDock::TraceOverviewDock(TraceDataProxy *data, QWidget *parent) : QDockWidget(parent), data(data) {
-    this->timelineView = new TraceOverviewTimelineView(data->getFullTrace());
+    this->timelineView = new TraceOverviewTimelineView(data->getFullTrace(), data->getThumbnail());
 
     this->setWidget(timelineView);
 
@@ -0,0 +1,106 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "WaitStateDock.hpp"
+
+#include <QHeaderView>
+#include <QVBoxLayout>
+
+enum WaitStateColumn {
+    RankColumn,
+    RegionColumn,
+    KindColumn,
+    CountColumn,
+    TimeColumn,
+    WaitStateColumnCount
+};
+
+/**
+ * Creates a numeric item, so the table is sorted by value
+ */
+static QTableWidgetItem *numberItem(double value) {
+    auto item = new QTableWidgetItem;
+    item->setData(Qt::DisplayRole, value);
+    item->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    return item;
+}
+
+static double milliseconds(types::TraceTime time) {
+    return std::chrono::duration<double, std::milli>(time).count();
+}
+
+WaitStateDock::WaitStateDock(TraceDataProxy *data, QWidget *parent) : QDockWidget(parent), data(data) {
+    setWindowTitle(tr("Wait states"));
+
+    auto widget = new QWidget(this);
+    auto layout = new QVBoxLayout(widget);
+
+    totalField = new QLabel;
+    totalField->setWordWrap(true);
+
+    table = new QTableWidget(0, WaitStateColumnCount);
+    table->setHorizontalHeaderLabels({tr("Rank"), tr("Region"), tr("Wait state"), tr("Slots"), tr("Time (ms)")});
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->verticalHeader()->hide();
+    table->horizontalHeader()->setSectionResizeMode(RegionColumn, QHeaderView::Stretch);
+    table->setSortingEnabled(true);
+    table->sortByColumn(TimeColumn, Qt::DescendingOrder);
+
+    layout->addWidget(totalField);
+    layout->addWidget(table);
+    widget->setLayout(layout);
+    setWidget(widget);
+
+    connect(this, &QDockWidget::visibilityChanged, this, &WaitStateDock::updateTable);
+    connect(data, &TraceDataProxy::waitStateAnalysisFinished, this, &WaitStateDock::updateTable);
+}
+
+void WaitStateDock::updateTable() {
+    if (!isVisible() || filled) return;
+
+    auto analysis = data->getWaitStateAnalysis();
+    if (!analysis) {
+        totalField->setText(tr("Analyzing wait states..."));
+        return;
+    }
+    filled = true;
+
+    QStringList totals;
+    for (int i = 0; i < WaitStateKindCount; i++) {
+        auto kind = static_cast<WaitStateKind>(i);
+        totals << tr("%1: %2 ms")
+            .arg(QString::fromStdString(WaitStateAnalysis::kindName(kind)))
+            .arg(milliseconds(analysis->total(kind)), 0, 'f', 3);
+    }
+    totalField->setText(totals.join(", "));
+
+    // Sorting is suspended while filling, otherwise rows move while their cells are set
+    table->setSortingEnabled(false);
+    const auto &summary = analysis->getSummary();
+    table->setRowCount(static_cast<int>(summary.size()));
+    for (int row = 0; row < static_cast<int>(summary.size()); row++) {
+        const auto &item = summary[row];
+        table->setItem(row, RankColumn, new QTableWidgetItem(QString::fromStdString(item.rank->name().str())));
+        table->setItem(row, RegionColumn, new QTableWidgetItem(QString::fromStdString(item.region->name().str())));
+        table->setItem(row, KindColumn,
+                       new QTableWidgetItem(QString::fromStdString(WaitStateAnalysis::kindName(item.kind))));
+        table->setItem(row, CountColumn, numberItem(static_cast<double>(item.count)));
+        table->setItem(row, TimeColumn, numberItem(milliseconds(item.time)));
+    }
+    table->setSortingEnabled(true);
+}
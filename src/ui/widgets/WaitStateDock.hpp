@@ -0,0 +1,56 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_WAITSTATEDOCK_HPP
+#define MOTIV_WAITSTATEDOCK_HPP
+
+
+#include <QDockWidget>
+#include <QLabel>
+#include <QTableWidget>
+
+#include "src/ui/TraceDataProxy.hpp"
+
+/**
+ * @brief A DockWidget listing the waiting time found by the WaitStateAnalysis
+ *
+ * Waiting time and the number of waiting slots are shown per rank, region and kind of wait state. The analysis is run
+ * when the dock is shown the first time.
+ */
+class WaitStateDock : public QDockWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the WaitStateDock class
+     * @param data The data proxy providing the wait state analysis
+     * @param parent The parent QWidget
+     */
+    explicit WaitStateDock(TraceDataProxy *data, QWidget *parent = nullptr);
+
+private Q_SLOTS:
+    void updateTable();
+
+private:
+    TraceDataProxy *data = nullptr;
+    QLabel *totalField = nullptr;
+    QTableWidget *table = nullptr;
+    bool filled = false;
+};
+
+
+#endif //MOTIV_WAITSTATEDOCK_HPP
@@ -0,0 +1,50 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "InformationDockCommunicationBundleStrategy.hpp"
+
+void InformationDockCommunicationBundleStrategy::setup(QFormLayout *layout) {
+    rankFromField = new QLabel;
+    rankToField = new QLabel;
+    countField = new QLabel;
+    bytesField = new QLabel;
+
+    layout->addRow(tr("From:"), rankFromField);
+    layout->addRow(tr("To:"), rankToField);
+    layout->addRow(tr("Messages:"), countField);
+    layout->addRow(tr("Bytes:"), bytesField);
+
+    InformationDockElementBaseStrategy::setup(layout);
+}
+
+void InformationDockCommunicationBundleStrategy::updateView(QFormLayout *layout, CommunicationBundle *element) {
+    auto representative = element->getRepresentative();
+
+    auto rankFrom = QString::fromStdString(representative->getStartEvent()->getLocation()->location_group().name().str());
+    auto rankTo = QString::fromStdString(representative->getEndEvent()->getLocation()->location_group().name().str());
+
+    rankFromField->setText(rankFrom);
+    rankToField->setText(rankTo);
+    countField->setText(QString::number(element->getCount()));
+    bytesField->setText(QString::number(element->getBytes()));
+
+    InformationDockElementBaseStrategy::updateView(layout, element);
+}
+
+std::string InformationDockCommunicationBundleStrategy::title() {
+    return tr("Bundled P2P communications").toStdString();
+}
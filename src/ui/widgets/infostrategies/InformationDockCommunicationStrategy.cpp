@@ -18,16 +18,20 @@
 #include "InformationDockCommunicationStrategy.hpp"
 #include "src/utils.hpp"
 
+#include <QLocale>
+
 void InformationDockCommunicationStrategy::setup(QFormLayout *layout) {
     communicatorField = new QLabel;
     startKindField = new QLabel;
     endKindField = new QLabel;
     rankFromField = new QLabel;
     rankToField = new QLabel;
+    messageField = new QLabel;
 
     layout->addRow(tr("From:"), rankFromField);
     layout->addRow(tr("To:"), rankToField);
     layout->addRow(tr("Communicator:"), communicatorField);
+    layout->addRow(tr("Message:"), messageField);
     layout->addRow(tr("Start event:"), startKindField);
     layout->addRow(tr("End event:"), endKindField);
 
@@ -50,6 +54,9 @@ void InformationDockCommunicationStrategy::updateView(QFormLayout *layout, Commu
     startKindField->setText(startKindName);
     endKindField->setText(endKindName);
     communicatorField->setText(communicatorName);
+    messageField->setText(tr("%1, tag %2")
+                              .arg(QLocale().formattedDataSize(static_cast<qint64>(element->getMessageLength())))
+                              .arg(element->getMessageTag()));
     
     InformationDockElementBaseStrategy::updateView(layout, element);
 }
@@ -49,6 +49,7 @@ private:
     QLabel *endKindField = nullptr;
     QLabel *rankFromField = nullptr;
     QLabel *rankToField = nullptr;
+    QLabel *messageField = nullptr;
 };
 
 
@@ -18,6 +18,7 @@
 #include "InformationDockElementBaseStrategy.hpp"
 #include "src/models/Slot.hpp"
 #include "src/models/Trace.hpp"
+#include "src/models/communication/CommunicationBundle.hpp"
 
 template<class T> requires std::is_base_of_v<TimedElement, T>
 void InformationDockElementBaseStrategy<T>::setup(QFormLayout *layout)  {
@@ -63,4 +64,5 @@ requires std::is_base_of_v<TimedElement, T>std::string InformationDockElementBas
 template class InformationDockElementBaseStrategy<Slot>;
 template class InformationDockElementBaseStrategy<Trace>;
 template class InformationDockElementBaseStrategy<Communication>;
+template class InformationDockElementBaseStrategy<CommunicationBundle>;
 template class InformationDockElementBaseStrategy<CollectiveCommunicationEvent>;
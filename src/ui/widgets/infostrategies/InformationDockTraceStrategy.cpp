@@ -16,6 +16,97 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 #include "InformationDockTraceStrategy.hpp"
+#include "src/models/MemoryAccounting.hpp"
+#include "src/models/MemoryBudget.hpp"
+
+#include <QLocale>
+
+static QString formatUsage(const MemoryUsage &usage) {
+    return QObject::tr("%1 (%2 objects)")
+        .arg(QLocale().formattedDataSize(static_cast<qint64>(usage.bytes)))
+        .arg(usage.objects);
+}
+
+static QString formatShare(types::TraceTime part, types::TraceTime whole) {
+    if (whole.count() <= 0) return QObject::tr("-");
+    return QString("%1 %").arg(100.0 * static_cast<double>(part.count()) / static_cast<double>(whole.count()), 0, 'f', 1);
+}
+
+InformationDockTraceStrategy::InformationDockTraceStrategy(TraceDataProxy *data) : data(data) {}
+
+void InformationDockTraceStrategy::setup(QFormLayout *layout) {
+    auto statistics = data->getWindowStatistics();
+    for (size_t i = 0; i < statistics->channelCount(); i++) {
+        auto field = new QLabel;
+        windowFields.push_back(field);
+        layout->addRow(QString::fromStdString(statistics->channelName(i)) + ":", field);
+    }
+    windowMpiRankField = new QLabel;
+    layout->addRow(tr("Most MPI time:"), windowMpiRankField);
+
+    for (int i = 0; i < MemoryReport::CategoryCount; i++) {
+        auto category = static_cast<MemoryReport::Category>(i);
+        auto name = QString::fromStdString(MemoryReport::categoryName(category));
+        name[0] = name[0].toUpper();
+        memoryFields[i] = new QLabel;
+        layout->addRow(name + ":", memoryFields[i]);
+    }
+    memoryTotalField = new QLabel;
+    layout->addRow(tr("Total memory:"), memoryTotalField);
+    cacheBudgetField = new QLabel;
+    layout->addRow(tr("Cache budget:"), cacheBudgetField);
+
+    InformationDockElementBaseStrategy::setup(layout);
+}
+
+void InformationDockTraceStrategy::updateView(QFormLayout *layout, Trace *element) {
+    // Shares of the location time in the selected window, every location contributes the length of the window
+    auto statistics = data->getWindowStatistics();
+    auto from = data->getBegin();
+    auto to = data->getEnd();
+    auto window = to - from;
+    auto times = statistics->total(from, to);
+    for (size_t i = 0; i < windowFields.size(); i++) {
+        windowFields[i]->setText(formatShare(times[i], window * static_cast<long>(statistics->locationCount())));
+    }
+
+    const auto &ranks = statistics->getRanks();
+    size_t mpiRank = 0;
+    double mpiShare = -1;
+    for (size_t rank = 0; rank < ranks.size(); rank++) {
+        auto rankTime = window.count() * static_cast<double>(statistics->locationCount(rank));
+        if (rankTime <= 0) continue;
+        auto share = static_cast<double>(statistics->forRank(rank, from, to)[WindowStatistics::MpiChannel].count()) / rankTime;
+        if (share > mpiShare) {
+            mpiShare = share;
+            mpiRank = rank;
+        }
+    }
+    if (mpiShare >= 0) {
+        windowMpiRankField->setText(tr("%1 (%2 %)")
+                                        .arg(QString::fromStdString(ranks[mpiRank]->name().str()))
+                                        .arg(100.0 * mpiShare, 0, 'f', 1));
+    } else {
+        windowMpiRankField->setText(tr("-"));
+    }
+
+    // The memory report walks the entire trace, so it is only refreshed when the element changes
+    if (element != lastElement) {
+        lastElement = element;
+        auto report = MemoryAccounting::getInstance().report();
+        for (int i = 0; i < MemoryReport::CategoryCount; i++) {
+            memoryFields[i]->setText(formatUsage(report.get(static_cast<MemoryReport::Category>(i))));
+        }
+        memoryTotalField->setText(formatUsage(report.total()));
+    }
+
+    auto &budget = MemoryBudget::getInstance();
+    cacheBudgetField->setText(tr("%1 of %2 used")
+                                  .arg(QLocale().formattedDataSize(static_cast<qint64>(budget.getUsage())))
+                                  .arg(QLocale().formattedDataSize(static_cast<qint64>(budget.getBudget()))));
+
+    InformationDockElementBaseStrategy::updateView(layout, element);
+}
 
 std::string InformationDockTraceStrategy::title() {
     return tr("Trace").toStdString();
@@ -20,17 +20,50 @@
 
 
 #include "InformationDockElementBaseStrategy.hpp"
+#include "src/models/MemoryReport.hpp"
 #include "src/models/Trace.hpp"
+#include "src/ui/TraceDataProxy.hpp"
+
+#include <array>
+#include <vector>
 
 /**
  * @brief A InformationDockElementStrategy to display information about a Trace
+ *
+ * Besides the time window the share of MPI, OpenMP, other and top region time in the selected time window and the memory
+ * used by MOTIV per category are shown.
  */
 class InformationDockTraceStrategy : public InformationDockElementBaseStrategy<Trace> {
 public:
+    /**
+     * @brief Creates a new instance of the InformationDockTraceStrategy class
+     * @param data The data proxy whose selected time window is summarised
+     */
+    explicit InformationDockTraceStrategy(TraceDataProxy *data);
+
+    /**
+     * @copydoc InformationDockElementBaseStrategy<T>::setup(QFormLayout*)
+     */
+    void setup(QFormLayout *layout) override;
+
+    /**
+     * @copydoc InformationDockElementBaseStrategy<T>::updateView(QFormLayout*, T*)
+     */
+    void updateView(QFormLayout *layout, Trace *element) override;
+
     /**
      * @copydoc InformationDockElementBaseStrategy<T>::title()
      */
     std::string title() override;
+
+private:
+    TraceDataProxy *data = nullptr;
+    Trace *lastElement = nullptr;
+    std::vector<QLabel *> windowFields;
+    QLabel *windowMpiRankField = nullptr;
+    std::array<QLabel *, MemoryReport::CategoryCount> memoryFields{};
+    QLabel *memoryTotalField = nullptr;
+    QLabel *cacheBudgetField = nullptr;
 };
 
 
@@ -0,0 +1,127 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "ExportDialog.hpp"
+
+#include <QDir>
+#include <QFileDialog>
+#include <QFileInfo>
+#include <QFormLayout>
+#include <QGridLayout>
+#include <QGroupBox>
+#include <QLabel>
+#include <QVBoxLayout>
+
+#include "src/ui/TimeUnit.hpp"
+
+ExportDialog::ExportDialog(TraceDataProxy *data, QWidget *parent) : QDialog(parent), data(data) {
+    auto grid = new QGridLayout();
+
+    // Selected time window
+    auto seconds = TimeUnit(TimeUnit::Second).multiplier();
+    auto windowLabel = new QLabel(tr("%1 s to %2 s")
+                                      .arg(static_cast<double>(data->getBegin().count()) / seconds, 0, 'f', 6)
+                                      .arg(static_cast<double>(data->getEnd().count()) / seconds, 0, 'f', 6));
+
+    pathField = new QLineEdit;
+    pathField->setPlaceholderText(tr("Anchor file of the new archive"));
+    auto browseButton = new QPushButton(tr("&Browse..."));
+    auto pathLayout = new QHBoxLayout;
+    pathLayout->addWidget(pathField);
+    pathLayout->addWidget(browseButton);
+
+    auto targetLayout = new QFormLayout;
+    targetLayout->addRow(tr("Time window:"), windowLabel);
+    targetLayout->addRow(tr("&File:"), pathLayout);
+
+    // Ranks of the trace, all are exported by default
+    auto ranksGroupBox = new QGroupBox(tr("Ranks"));
+    rankList = new QListWidget;
+    for (const auto &[group, slots]: data->getFullTrace()->getSlots()) {
+        auto item = new QListWidgetItem(QString::fromStdString(group->name().str()), rankList);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(Qt::Checked);
+        item->setData(Qt::UserRole, QVariant::fromValue(group->ref().get()));
+    }
+    auto ranksLayout = new QVBoxLayout;
+    ranksLayout->addWidget(rankList);
+    ranksGroupBox->setLayout(ranksLayout);
+
+    grid->addLayout(targetLayout, 0, 0, 1, 2);
+    grid->addWidget(ranksGroupBox, 1, 0, 1, 2);
+
+    exportButton = new QPushButton(tr("&Export"));
+    exportButton->setDefault(true);
+    connect(exportButton, SIGNAL(clicked()), this, SLOT(accept()));
+    auto cancelButton = new QPushButton(tr("&Cancel"));
+    connect(cancelButton, SIGNAL(clicked()), this, SLOT(reject()));
+
+    grid->addWidget(cancelButton, 2, 0, Qt::AlignLeft);
+    grid->addWidget(exportButton, 2, 1, Qt::AlignRight);
+
+    connect(browseButton, SIGNAL(clicked()), this, SLOT(browse()));
+    connect(pathField, SIGNAL(textChanged(QString)), this, SLOT(validate()));
+    connect(rankList, SIGNAL(itemChanged(QListWidgetItem*)), this, SLOT(validate()));
+    validate();
+
+    setLayout(grid);
+    setWindowTitle(tr("Export selection"));
+    setModal(true);
+}
+
+TraceExportOptions ExportDialog::exportOptions() const {
+    TraceExportOptions options;
+    options.begin = data->getBegin();
+    options.end = data->getEnd();
+    for (int i = 0; i < rankList->count(); i++) {
+        if (rankList->item(i)->checkState() == Qt::Checked) {
+            options.ranks.insert(rankList->item(i)->data(Qt::UserRole).toULongLong());
+        }
+    }
+    // All ranks are exported by an empty set
+    if (options.ranks.size() == static_cast<size_t>(rankList->count())) {
+        options.ranks.clear();
+    }
+    return options;
+}
+
+QString ExportDialog::anchorPath() const {
+    auto path = pathField->text();
+    return path.endsWith(".otf2") ? path : path + ".otf2";
+}
+
+void ExportDialog::browse() {
+    auto path = QFileDialog::getSaveFileName(this, tr("Export selection"), pathField->text(),
+                                             tr("OTF2 Traces (*.otf2)"));
+    if (!path.isEmpty()) {
+        pathField->setText(path);
+    }
+}
+
+void ExportDialog::validate() {
+    // OTF2 refuses to overwrite an existing archive
+    QFileInfo anchor(anchorPath());
+    auto pathValid = !pathField->text().isEmpty() && !anchor.exists() &&
+                     !QFileInfo::exists(anchor.dir().filePath(anchor.completeBaseName()));
+    pathField->setStyleSheet(pathValid || pathField->text().isEmpty() ? QString() : "color: red;");
+
+    bool anyRank = false;
+    for (int i = 0; i < rankList->count(); i++) {
+        anyRank |= rankList->item(i)->checkState() == Qt::Checked;
+    }
+    exportButton->setEnabled(pathValid && anyRank);
+}
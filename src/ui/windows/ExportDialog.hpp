@@ -0,0 +1,70 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_EXPORTDIALOG_HPP
+#define MOTIV_EXPORTDIALOG_HPP
+
+
+#include <QDialog>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QPushButton>
+
+#include "src/TraceExporter.hpp"
+#include "src/ui/TraceDataProxy.hpp"
+
+/**
+ * @brief A popup choosing the ranks and the target of an exported time window
+ *
+ * The selected time window of the trace is exported to a new OTF2 archive, see TraceExporter.
+ */
+class ExportDialog : public QDialog {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the ExportDialog class
+     * @param data The data proxy providing the selected time window and the ranks of the trace
+     * @param parent The parent QWidget
+     */
+    explicit ExportDialog(TraceDataProxy *data, QWidget *parent = nullptr);
+
+    /**
+     * @brief Returns the parts of the trace to export as chosen in the dialog
+     * @return The export options
+     */
+    [[nodiscard]] TraceExportOptions exportOptions() const;
+
+    /**
+     * @brief Returns the path of the anchor file of the archive to create
+     * @return The path ending with .otf2
+     */
+    [[nodiscard]] QString anchorPath() const;
+
+private Q_SLOTS:
+    void browse();
+    void validate();
+
+private:
+    TraceDataProxy *data = nullptr;
+    QLineEdit *pathField = nullptr;
+    QListWidget *rankList = nullptr;
+    QPushButton *exportButton = nullptr;
+};
+
+
+#endif //MOTIV_EXPORTDIALOG_HPP
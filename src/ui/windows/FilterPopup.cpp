@@ -19,9 +19,48 @@
 #include <QRadioButton>
 #include <QCheckBox>
 #include <QPushButton>
+#include <QFormLayout>
 #include "FilterPopup.hpp"
+#include "src/models/CompiledFilter.hpp"
+#include "src/ui/TimeUnit.hpp"
 
-FilterPopup::FilterPopup(const Filter &filter, QWidget *parent, const Qt::WindowFlags &f)
+/**
+ * Adds a checkable item per entry to a list, entries in @c checked or all entries if it is empty are checked
+ */
+static void addCheckableItems(QListWidget *list, const std::map<uint64_t, QString> &entries,
+                              const std::set<uint64_t> &checked) {
+    for (const auto &[ref, name]: entries) {
+        auto item = new QListWidgetItem(name, list);
+        item->setFlags(item->flags() | Qt::ItemIsUserCheckable);
+        item->setCheckState(checked.empty() || checked.contains(ref) ? Qt::Checked : Qt::Unchecked);
+        item->setData(Qt::UserRole, QVariant::fromValue(ref));
+    }
+}
+
+/**
+ * Returns the references of the checked items, or an empty set if all items are checked
+ */
+static std::set<uint64_t> checkedItems(const QListWidget *list) {
+    std::set<uint64_t> checked;
+    for (int i = 0; i < list->count(); i++) {
+        if (list->item(i)->checkState() == Qt::Checked) {
+            checked.insert(list->item(i)->data(Qt::UserRole).toULongLong());
+        }
+    }
+    if (checked.size() == static_cast<size_t>(list->count())) {
+        checked.clear();
+    }
+    return checked;
+}
+
+static bool anyChecked(const QListWidget *list) {
+    for (int i = 0; i < list->count(); i++) {
+        if (list->item(i)->checkState() == Qt::Checked) return true;
+    }
+    return list->count() == 0;
+}
+
+FilterPopup::FilterPopup(const Filter &filter, Trace *trace, QWidget *parent, const Qt::WindowFlags &f)
     : QDialog(parent, f), filter_(filter) {
 
     auto *grid = new QGridLayout();
@@ -43,9 +82,70 @@ FilterPopup::FilterPopup(const Filter &filter, QWidget *parent, const Qt::Window
     vbox->addStretch(1);
     slotKindsGroupBox->setLayout(vbox);
 
-    grid->addWidget(slotKindsGroupBox, 0, 0);
+    // Regions by name and duration
+    auto regionsGroupBox = new QGroupBox(tr("Regions"));
+    regionPatternField = new QLineEdit(QString::fromStdString(filter_.getRegionPattern()));
+    regionPatternField->setPlaceholderText(tr("All regions"));
+    regionPatternSyntaxBox = new QComboBox;
+    regionPatternSyntaxBox->addItem(tr("Wildcard"), static_cast<int>(FilterPatternSyntax::Glob));
+    regionPatternSyntaxBox->addItem(tr("Regular expression"), static_cast<int>(FilterPatternSyntax::Regex));
+    regionPatternSyntaxBox->setCurrentIndex(regionPatternSyntaxBox->findData(
+        static_cast<int>(filter_.getRegionPatternSyntax())));
+    TimeUnit microseconds(TimeUnit::MicroSecond);
+    minDurationBox = new QDoubleSpinBox;
+    minDurationBox->setRange(0, 1e12);
+    minDurationBox->setDecimals(3);
+    minDurationBox->setSuffix(" " + microseconds.str());
+    minDurationBox->setValue(static_cast<double>(filter_.getMinDuration().count()) / microseconds.multiplier());
 
-    auto okButton = new QPushButton(tr("&Ok"));
+    auto regionsLayout = new QFormLayout;
+    regionsLayout->addRow(tr("&Name:"), regionPatternField);
+    regionsLayout->addRow(tr("&Syntax:"), regionPatternSyntaxBox);
+    regionsLayout->addRow(tr("Minimum &duration:"), minDurationBox);
+    regionsGroupBox->setLayout(regionsLayout);
+
+    // Ranks and communicators of the trace
+    std::map<uint64_t, QString> ranks;
+    for (const auto &[group, slots]: trace->getSlots()) {
+        ranks[group->ref().get()] = QString::fromStdString(group->name().str());
+    }
+    std::map<uint64_t, QString> communicators;
+    auto addCommunicator = [&communicators](const types::communicator *communicator) {
+        if (auto comm = std::get_if<otf2::definition::comm>(communicator)) {
+            communicators.try_emplace(comm->ref().get(), QString::fromStdString(comm->name().str()));
+        }
+    };
+    for (const auto &communication: trace->getCommunications()) {
+        addCommunicator(communication->getStartEvent()->getCommunicator());
+    }
+    for (const auto &event: trace->getCollectiveCommunications()) {
+        addCommunicator(event->getCommunicator());
+    }
+
+    auto ranksGroupBox = new QGroupBox(tr("Ranks"));
+    rankList = new QListWidget;
+    addCheckableItems(rankList, ranks, filter_.getRanks());
+    auto ranksLayout = new QVBoxLayout;
+    ranksLayout->addWidget(rankList);
+    ranksGroupBox->setLayout(ranksLayout);
+
+    auto communicatorsGroupBox = new QGroupBox(tr("Communicators"));
+    communicatorList = new QListWidget;
+    addCheckableItems(communicatorList, communicators, filter_.getCommunicators());
+    auto communicatorsLayout = new QVBoxLayout;
+    communicatorsLayout->addWidget(communicatorList);
+    communicatorsGroupBox->setLayout(communicatorsLayout);
+
+    auto leftColumn = new QVBoxLayout;
+    leftColumn->addWidget(slotKindsGroupBox);
+    leftColumn->addWidget(regionsGroupBox);
+    auto rightColumn = new QVBoxLayout;
+    rightColumn->addWidget(ranksGroupBox);
+    rightColumn->addWidget(communicatorsGroupBox);
+    grid->addLayout(leftColumn, 0, 0);
+    grid->addLayout(rightColumn, 0, 1);
+
+    okButton = new QPushButton(tr("&Ok"));
     okButton->setDefault(true);
     connect(okButton, SIGNAL(clicked()), this, SLOT(accept()));
     auto cancelButton = new QPushButton(tr("&Cancel"));
@@ -56,6 +156,11 @@ FilterPopup::FilterPopup(const Filter &filter, QWidget *parent, const Qt::Window
 
 
     connect(this, SIGNAL(accepted()), this, SLOT(updateFilter()));
+    connect(regionPatternField, SIGNAL(textChanged(QString)), this, SLOT(validate()));
+    connect(regionPatternSyntaxBox, SIGNAL(currentIndexChanged(int)), this, SLOT(validate()));
+    connect(rankList, SIGNAL(itemChanged(QListWidgetItem*)), this, SLOT(validate()));
+    connect(communicatorList, SIGNAL(itemChanged(QListWidgetItem*)), this, SLOT(validate()));
+    validate();
 
     setLayout(grid);
     setWindowTitle(tr("Set filter"));
@@ -69,6 +174,20 @@ void FilterPopup::updateFilter() {
         SlotKind::MPI * mpiSlotKindCheckBox->isChecked());
 
     filter_.setSlotKinds(slotKinds);
+    filter_.setRegionPattern(regionPatternField->text().toStdString(),
+                             static_cast<FilterPatternSyntax>(regionPatternSyntaxBox->currentData().toInt()));
+    auto minDuration = minDurationBox->value() * TimeUnit(TimeUnit::MicroSecond).multiplier();
+    filter_.setMinDuration(types::TraceTime(static_cast<types::TraceTime::rep>(minDuration)));
+    filter_.setRanks(checkedItems(rankList));
+    filter_.setCommunicators(checkedItems(communicatorList));
 
     Q_EMIT filterChanged(filter_);
 }
+
+void FilterPopup::validate() {
+    auto syntax = static_cast<FilterPatternSyntax>(regionPatternSyntaxBox->currentData().toInt());
+    auto patternValid = CompiledFilter::isValidPattern(regionPatternField->text().toStdString(), syntax);
+    regionPatternField->setStyleSheet(patternValid ? QString() : "color: red;");
+
+    okButton->setEnabled(patternValid && anyChecked(rankList) && anyChecked(communicatorList));
+}
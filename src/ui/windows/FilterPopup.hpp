@@ -22,7 +22,13 @@
 #include <QDialog>
 #include <QGroupBox>
 #include <QCheckBox>
+#include <QComboBox>
+#include <QDoubleSpinBox>
+#include <QLineEdit>
+#include <QListWidget>
+#include <QPushButton>
 #include "src/models/Filter.hpp"
+#include "src/models/Trace.hpp"
 
 /**
  * @brief A simple popup showing filter options.
@@ -36,10 +42,12 @@ public: // constructors
     /**
      * Creates a new instance of this modal popup.
      * @param filter The current filter object
+     * @param trace The trace whose ranks and communicators can be selected
      * @param parent See QDialog::QDialog(QWidget*, Qt::WindowFlags)
      * @param f See QDialog::QDialog(QWidget*, Qt::WindowFlags)
      */
-    explicit FilterPopup(const Filter &filter, QWidget *parent = nullptr, const Qt::WindowFlags &f = Qt::WindowFlags());
+    FilterPopup(const Filter &filter, Trace *trace, QWidget *parent = nullptr,
+                const Qt::WindowFlags &f = Qt::WindowFlags());
 
 public: // methods
 
@@ -49,6 +57,11 @@ public Q_SLOTS:
      */
     void updateFilter();
 
+    /**
+     * Enables the ok button only if the region pattern is valid and at least one rank and communicator is selected
+     */
+    void validate();
+
 public: Q_SIGNALS:
     /**
      * Signals the filter was changes
@@ -62,6 +75,12 @@ private: // widgets
     QCheckBox *mpiSlotKindCheckBox = nullptr;
     QCheckBox *openMpSlotKindCheckBox = nullptr;
     QCheckBox *plainSlotKindCheckBox = nullptr;
+    QLineEdit *regionPatternField = nullptr;
+    QComboBox *regionPatternSyntaxBox = nullptr;
+    QDoubleSpinBox *minDurationBox = nullptr;
+    QListWidget *rankList = nullptr;
+    QListWidget *communicatorList = nullptr;
+    QPushButton *okButton = nullptr;
 };
 
 
@@ -0,0 +1,110 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "LoadingPreview.hpp"
+
+#include <QFileInfo>
+#include <QImage>
+#include <QPainter>
+#include <QVBoxLayout>
+#include <algorithm>
+
+#include "src/ui/Constants.hpp"
+#include "src/ui/TimeUnit.hpp"
+#include "src/ui/TraceOverviewRenderer.hpp"
+
+LoadingPreview::LoadingPreview(const QString &filepath, types::TraceTime runtime, QWidget *parent) :
+    QWidget(parent, Qt::Window), runtime(std::max(runtime, types::TraceTime(1))) {
+    auto layout = new QVBoxLayout;
+    statusLabel = new QLabel(tr("Reading a sample..."));
+    layout->addStretch();
+    layout->addWidget(statusLabel);
+    setLayout(layout);
+
+    setWindowTitle(tr("Loading %1").arg(QFileInfo(filepath).fileName()));
+    resize(800, 320);
+}
+
+void LoadingPreview::setSample(TraceSummary::Snapshot snapshot, types::TraceTime sampleRuntime) {
+    sample = std::move(snapshot);
+    runtime = std::max(sampleRuntime, types::TraceTime(1));
+    statusLabel->setText(tr("Showing a sample, reading the full trace..."));
+    update();
+}
+
+void LoadingPreview::setThumbnail(const TraceThumbnail *thumbnail) {
+    auto levels = TraceOverviewRenderer::render(thumbnail);
+    if (levels.empty()) return;
+
+    thumbnailImage = levels.front();
+    statusLabel->setText(tr("Showing the thumbnails, reading the full trace..."));
+    update();
+}
+
+void LoadingPreview::setProgress(TraceSummary::Snapshot snapshot, types::TraceTime until) {
+    progress = std::move(snapshot);
+    readUntil = until;
+    auto seconds = TimeUnit(TimeUnit::Second).multiplier();
+    auto percent = std::min<int64_t>(100, 100 * readUntil.count() / runtime.count());
+    statusLabel->setText(tr("Read %1 s of %2 s (about %3%)")
+                             .arg(static_cast<double>(readUntil.count()) / seconds, 0, 'f', 2)
+                             .arg(static_cast<double>(runtime.count()) / seconds, 0, 'f', 2)
+                             .arg(percent));
+    update();
+}
+
+void LoadingPreview::paintEvent(QPaintEvent *) {
+    auto area = rect().adjusted(0, 0, 0, -statusLabel->height() - layout()->spacing());
+    if (area.isEmpty()) return;
+
+    QImage image(area.size(), QImage::Format_ARGB32_Premultiplied);
+    image.fill(palette().color(QPalette::Window));
+    const std::array<QColor, 3> colors = {colors::COLOR_SLOT_MPI, colors::COLOR_SLOT_OPEN_MP, colors::COLOR_SLOT_PLAIN};
+
+    for (int x = 0; x < image.width(); x++) {
+        auto time = types::TraceTime(runtime.count() * x / image.width());
+        // The full read replaces the sample for the part that has been read already
+        const auto &snapshot = time < readUntil && !progress.rows.empty() ? progress : sample;
+        if (snapshot.rows.empty()) continue;
+
+        auto bin = std::min(static_cast<size_t>(time / snapshot.binWidth), static_cast<size_t>(SUMMARY_BINS - 1));
+        for (int y = 0; y < image.height(); y++) {
+            auto row = static_cast<size_t>(y) * snapshot.rows.size() / image.height();
+            const auto &times = snapshot.rows[row][bin];
+
+            auto dominant = std::max_element(times.begin(), times.end()) - times.begin();
+            auto busy = times[0] + times[1] + times[2];
+            if (busy.count() == 0) continue;
+
+            auto capacity = snapshot.binWidth.count() * static_cast<int64_t>(snapshot.rowLocations[row]);
+            auto color = colors[dominant];
+            color.setAlphaF(std::clamp(static_cast<double>(busy.count()) / capacity, 0.2, 1.0));
+            image.setPixelColor(x, y, color);
+        }
+    }
+
+    QPainter painter(this);
+    painter.drawImage(area.topLeft(), image);
+
+    // The thumbnails cover the part that has not been read yet
+    if (thumbnailImage.isNull()) return;
+    auto readWidth = progress.rows.empty() ? 0 : static_cast<int>(area.width() * std::min(readUntil, runtime) / runtime);
+    auto thumbnailX = thumbnailImage.width() * readWidth / area.width();
+    QRect target(area.left() + readWidth, area.top(), area.width() - readWidth, area.height());
+    QRect source(thumbnailX, 0, thumbnailImage.width() - thumbnailX, thumbnailImage.height());
+    if (!target.isEmpty() && !source.isEmpty()) painter.drawImage(target, thumbnailImage, source);
+}
@@ -0,0 +1,98 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_LOADINGPREVIEW_HPP
+#define MOTIV_LOADINGPREVIEW_HPP
+
+
+#include <QImage>
+#include <QLabel>
+#include <QWidget>
+
+#include "src/models/TraceSummary.hpp"
+#include "src/models/TraceThumbnail.hpp"
+#include "src/types.hpp"
+
+/**
+ * Defines the size of a trace archive in bytes from which on a preview is shown while loading
+ */
+#define PREVIEW_MIN_TRACE_BYTES (256ull << 20)
+
+/**
+ * Defines the approximate number of bytes read for the sampled preview, the ranks are thinned out accordingly
+ */
+#define PREVIEW_SAMPLE_BYTES (32ull << 20)
+
+/**
+ * Defines the interval in milliseconds at which the preview is refreshed
+ */
+#define PREVIEW_REFRESH_MS 250
+
+/**
+ * @brief A window showing a coarse picture of a trace while it is loaded
+ *
+ * The picture is first drawn from the thumbnails stored in the archive or, if it has none, from a summary of a sample of
+ * the ranks. While the full trace is read, the part up to the events read so far is replaced by snapshots of the full
+ * read. Every pixel is colored by the kind of region dominating
+ * its bin and shaded by how busy the locations were.
+ */
+class LoadingPreview : public QWidget {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the LoadingPreview class
+     * @param filepath Path of the trace shown in the title
+     * @param runtime Runtime of the trace, may be zero if it is only known from the sample
+     * @param parent The parent QWidget
+     */
+    LoadingPreview(const QString &filepath, types::TraceTime runtime, QWidget *parent = nullptr);
+
+    /**
+     * @brief Sets the snapshot of the sampled ranks
+     * @param snapshot Snapshot of the summary of the sample
+     * @param sampleRuntime Runtime of the sampled ranks, used as the runtime of the trace
+     */
+    void setSample(TraceSummary::Snapshot snapshot, types::TraceTime sampleRuntime);
+
+    /**
+     * @brief Sets the thumbnails stored in the archive, which are shown instead of a sample
+     * @param thumbnail The thumbnails, only used during the call
+     */
+    void setThumbnail(const TraceThumbnail *thumbnail);
+
+    /**
+     * @brief Sets the snapshot of the full read and how far it got
+     * @param snapshot Snapshot of the events read so far
+     * @param readUntil Time up to which the events have been read
+     */
+    void setProgress(TraceSummary::Snapshot snapshot, types::TraceTime readUntil);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+
+private:
+    types::TraceTime runtime;
+    types::TraceTime readUntil{0};
+    TraceSummary::Snapshot sample;
+    TraceSummary::Snapshot progress;
+    QImage thumbnailImage;
+    QLabel *statusLabel = nullptr;
+};
+
+
+#endif //MOTIV_LOADINGPREVIEW_HPP
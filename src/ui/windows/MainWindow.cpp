@@ -19,21 +19,32 @@
 
 #include <QApplication>
 #include <QCoreApplication>
+#include <QDirIterator>
 #include <QErrorMessage>
 #include <QFileDialog>
+#include <QFutureWatcher>
 #include <QHBoxLayout>
+#include <QInputDialog>
 #include <QMenuBar>
 #include <QMessageBox>
 #include <QProcess>
+#include <QStatusBar>
+#include <QTimer>
 #include <QToolBar>
+#include <QtConcurrent/QtConcurrent>
+#include <limits>
+#include <memory>
 #include <utility>
 
 #include "src/models/AppSettings.hpp"
+#include "src/models/MemoryBudget.hpp"
+#include "src/SelfTracer.hpp"
 #include "src/ui/widgets/License.hpp"
 #include "src/ui/widgets/Help.hpp"
 #include "src/ui/widgets/TimeInputField.hpp"
 #include "src/ui/widgets/Timeline.hpp"
 #include "src/ui/TimeUnit.hpp"
+#include "src/ui/windows/ExportDialog.hpp"
 #include "src/ui/windows/FilterPopup.hpp"
 #include "src/ui/widgets/About.hpp"
 #include "src/ui/widgets/TraceOverviewDock.hpp"
@@ -41,29 +52,35 @@
 #include "src/ui/widgets/infostrategies/InformationDockSlotStrategy.hpp"
 #include "src/ui/widgets/infostrategies/InformationDockTraceStrategy.hpp"
 #include "src/ui/widgets/infostrategies/InformationDockCommunicationStrategy.hpp"
+#include "src/ui/widgets/infostrategies/InformationDockCommunicationBundleStrategy.hpp"
 #include "src/ui/widgets/infostrategies/InformationDockCollectiveCommunicationStrategy.hpp"
 
 
-MainWindow::MainWindow(QString filepath) : QMainWindow(nullptr), filepath(std::move(filepath)) {
+MainWindow::MainWindow(QString filepath, LoadOptions options) :
+    QMainWindow(nullptr), filepath(std::move(filepath)), loadOptions(std::move(options)) {
     if (this->filepath.isEmpty()) {
         this->promptFile();
     }
     this->loadSettings();
     this->loadTrace();
-
-    this->createToolBars();
-    this->createDockWidgets();
-    this->createCentralWidget();
-    this->createMenus();
 }
 
 MainWindow::~MainWindow() {
+    // The overview and the profile read the trace in the background and have to be deleted before the trace
+    delete this->traceOverview;
+    delete this->profile;
+    delete this->communicationMatrix;
+    delete this->waitStates;
+    delete this->criticalPath;
+    delete this->searchPopup;
+
+    delete this->loadingPreview;
+    delete this->thumbnail;
     delete this->data;
     delete this->callbacks;
     delete this->reader;
     delete this->settings;
 
-    delete this->traceOverview;
     delete this->information;
 
     delete this->licenseWindow;
@@ -105,9 +122,19 @@ void MainWindow::createMenus() {
     quitAction->setShortcut(tr("Ctrl+Q"));
     connect(quitAction, SIGNAL(triggered()), this, SLOT(close()));
 
+    auto openDetailAction = new QAction(tr("Open selection in &detail"), this);
+    openDetailAction->setEnabled(this->data->getSummary() != nullptr);
+    connect(openDetailAction, &QAction::triggered, this, &MainWindow::openSelectionInDetail);
+
+    auto exportAction = new QAction(tr("&Export selection..."), this);
+    exportAction->setShortcut(tr("Ctrl+E"));
+    connect(exportAction, &QAction::triggered, this, &MainWindow::exportSelection);
+
     auto fileMenu = menuBar->addMenu(tr("&File"));
     fileMenu->addAction(openTraceAction);
     fileMenu->addMenu(openRecentMenu);
+    fileMenu->addAction(openDetailAction);
+    fileMenu->addAction(exportAction);
     fileMenu->addSeparator();
     fileMenu->addAction(quitAction);
 
@@ -118,12 +145,39 @@ void MainWindow::createMenus() {
 
     auto searchAction = new QAction(tr("&Find"));
     searchAction->setShortcut(tr("Ctrl+F"));
-    connect(searchAction, SIGNAL(triggered()), this, SLOT(openFilterPopup()));
+    connect(searchAction, SIGNAL(triggered()), this, SLOT(openSearchPopup()));
 
     auto resetZoomAction = new QAction(tr("&Reset zoom"));
     connect(resetZoomAction, SIGNAL(triggered()), this, SLOT(resetZoom()));
     resetZoomAction->setShortcut(tr("Ctrl+R"));
 
+    auto callStackAction = new QAction(tr("Show call &stacks"));
+    callStackAction->setCheckable(true);
+    callStackAction->setChecked(this->settings->isCallStackShown());
+    connect(callStackAction, &QAction::toggled, this->data, &TraceDataProxy::setCallStackShown);
+
+    auto waitStatesAction = new QAction(tr("Highlight &wait states"));
+    waitStatesAction->setCheckable(true);
+    waitStatesAction->setChecked(this->settings->isWaitStatesShown());
+    connect(waitStatesAction, &QAction::toggled, this->data, &TraceDataProxy::setWaitStatesShown);
+
+    auto criticalPathAction = new QAction(tr("Highlight critical &path"));
+    criticalPathAction->setCheckable(true);
+    criticalPathAction->setChecked(this->settings->isCriticalPathShown());
+    connect(criticalPathAction, &QAction::toggled, this->data, &TraceDataProxy::setCriticalPathShown);
+
+    auto memoryBudgetAction = new QAction(tr("Memory &budget..."));
+    connect(memoryBudgetAction, &QAction::triggered, this, [this] {
+        bool ok = false;
+        auto budget = QInputDialog::getInt(this, tr("Memory budget"), tr("Memory all caches may use (MiB):"),
+                                           static_cast<int>(AppSettings::getInstance().memoryBudget()), 64,
+                                           std::numeric_limits<int>::max(), 256, &ok);
+        if (!ok) return;
+
+        AppSettings::getInstance().memoryBudgetSet(budget);
+        MemoryBudget::getInstance().setBudget(static_cast<size_t>(budget) * 1024 * 1024);
+    });
+
     auto widgetMenu = new QMenu(tr("Tool Windows"));
 
     auto showOverviewAction = new QAction(tr("Show &trace overview"));
@@ -136,13 +190,48 @@ void MainWindow::createMenus() {
     connect(showDetailsAction, SIGNAL(toggled(bool)), this->information, SLOT(setVisible(bool)));
     connect(this->information, SIGNAL(visibilityChanged(bool)), showDetailsAction, SLOT(setChecked(bool)));
 
+    auto showPerformanceAction = new QAction(tr("Show &performance monitor"));
+    showPerformanceAction->setCheckable(true);
+    connect(showPerformanceAction, SIGNAL(toggled(bool)), this->performance, SLOT(setVisible(bool)));
+    connect(this->performance, SIGNAL(visibilityChanged(bool)), showPerformanceAction, SLOT(setChecked(bool)));
+
+    auto showProfileAction = new QAction(tr("Show p&rofile"));
+    showProfileAction->setCheckable(true);
+    connect(showProfileAction, SIGNAL(toggled(bool)), this->profile, SLOT(setVisible(bool)));
+    connect(this->profile, SIGNAL(visibilityChanged(bool)), showProfileAction, SLOT(setChecked(bool)));
+
+    auto showCommunicationMatrixAction = new QAction(tr("Show communication &matrix"));
+    showCommunicationMatrixAction->setCheckable(true);
+    connect(showCommunicationMatrixAction, SIGNAL(toggled(bool)), this->communicationMatrix, SLOT(setVisible(bool)));
+    connect(this->communicationMatrix, SIGNAL(visibilityChanged(bool)), showCommunicationMatrixAction,
+            SLOT(setChecked(bool)));
+
+    auto showWaitStatesAction = new QAction(tr("Show wait &states"));
+    showWaitStatesAction->setCheckable(true);
+    connect(showWaitStatesAction, SIGNAL(toggled(bool)), this->waitStates, SLOT(setVisible(bool)));
+    connect(this->waitStates, SIGNAL(visibilityChanged(bool)), showWaitStatesAction, SLOT(setChecked(bool)));
+
+    auto showCriticalPathAction = new QAction(tr("Show &critical path"));
+    showCriticalPathAction->setCheckable(true);
+    connect(showCriticalPathAction, SIGNAL(toggled(bool)), this->criticalPath, SLOT(setVisible(bool)));
+    connect(this->criticalPath, SIGNAL(visibilityChanged(bool)), showCriticalPathAction, SLOT(setChecked(bool)));
+
     widgetMenu->addAction(showOverviewAction);
     widgetMenu->addAction(showDetailsAction);
+    widgetMenu->addAction(showPerformanceAction);
+    widgetMenu->addAction(showProfileAction);
+    widgetMenu->addAction(showCommunicationMatrixAction);
+    widgetMenu->addAction(showWaitStatesAction);
+    widgetMenu->addAction(showCriticalPathAction);
 
     auto viewMenu = menuBar->addMenu(tr("&View"));
     viewMenu->addAction(filterAction);
     viewMenu->addAction(searchAction);
     viewMenu->addAction(resetZoomAction);
+    viewMenu->addAction(callStackAction);
+    viewMenu->addAction(waitStatesAction);
+    viewMenu->addAction(criticalPathAction);
+    viewMenu->addAction(memoryBudgetAction);
     viewMenu->addMenu(widgetMenu);
 
     /// Window menu
@@ -217,8 +306,9 @@ void MainWindow::createToolBars() {
 void MainWindow::createDockWidgets() {
     this->information = new InformationDock();
     information->addElementStrategy(new InformationDockSlotStrategy());
-    information->addElementStrategy(new InformationDockTraceStrategy());
+    information->addElementStrategy(new InformationDockTraceStrategy(this->data));
     information->addElementStrategy(new InformationDockCommunicationStrategy());
+    information->addElementStrategy(new InformationDockCommunicationBundleStrategy());
     information->addElementStrategy(new InformationDockCollectiveCommunicationStrategy());
 
     this->information->setElement(this->data->getFullTrace());
@@ -227,11 +317,35 @@ void MainWindow::createDockWidgets() {
             SLOT(setSelection(types::TraceTime, types::TraceTime)));
 
     connect(data, SIGNAL(infoElementSelected(TimedElement * )), information, SLOT(setElement(TimedElement * )));
+    connect(data, SIGNAL(selectionChanged(types::TraceTime, types::TraceTime)), information, SLOT(updateView()));
     // @formatter:on
     this->addDockWidget(Qt::RightDockWidgetArea, this->information);
 
     this->traceOverview = new TraceOverviewDock(this->data);
     this->addDockWidget(Qt::TopDockWidgetArea, this->traceOverview);
+
+    // Measurements are only recorded while the dock is visible
+    this->performance = new PerformanceDock();
+    this->addDockWidget(Qt::RightDockWidgetArea, this->performance);
+    this->performance->hide();
+
+    // Profiles are only computed while the dock is visible
+    this->profile = new ProfileDock(this->data);
+    this->addDockWidget(Qt::RightDockWidgetArea, this->profile);
+    this->profile->hide();
+
+    // The matrix is only built and updated while the dock is visible
+    this->communicationMatrix = new CommunicationMatrixDock(this->data);
+    this->addDockWidget(Qt::RightDockWidgetArea, this->communicationMatrix);
+    this->communicationMatrix->hide();
+
+    this->waitStates = new WaitStateDock(this->data);
+    this->addDockWidget(Qt::RightDockWidgetArea, this->waitStates);
+    this->waitStates->hide();
+
+    this->criticalPath = new CriticalPathDock(this->data);
+    this->addDockWidget(Qt::RightDockWidgetArea, this->criticalPath);
+    this->criticalPath->hide();
 }
 
 void MainWindow::createCentralWidget() {
@@ -252,20 +366,158 @@ QString MainWindow::promptFile() {
     return newFilePath;
 }
 
+/**
+ * Returns the size of a trace archive, consisting of the anchor file and the directory named like it
+ */
+static qint64 traceArchiveSize(const QString &anchorPath) {
+    QFileInfo anchor(anchorPath);
+    auto size = anchor.size();
+    QDirIterator it(anchor.dir().filePath(anchor.completeBaseName()), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        size += it.fileInfo().size();
+    }
+    return size;
+}
+
+/**
+ * Reads a summary of every n-th rank of a trace, n is chosen so that about PREVIEW_SAMPLE_BYTES are read
+ *
+ * @return Snapshot of the summary and the runtime of the sampled ranks
+ */
+static std::pair<TraceSummary::Snapshot, types::TraceTime> readPreviewSample(const QString &filepath,
+                                                                            const RegionFilter &regionFilter) {
+    SelfTracer::Scope scope("preview sample");
+    LoadOptions sampleOptions;
+    sampleOptions.regionFilter = regionFilter;
+    sampleOptions.summaryOnly = true;
+    sampleOptions.rankStride = std::max<uint64_t>(1, traceArchiveSize(filepath) / PREVIEW_SAMPLE_BYTES);
+
+    otf2::reader::reader sampleReader(filepath.toStdString());
+    ReaderCallbacks sampleCallbacks(sampleReader, sampleOptions);
+    sampleReader.set_callback(sampleCallbacks);
+    sampleReader.read_definitions();
+    sampleReader.read_events();
+
+    std::unique_ptr<TraceSummary> summary(sampleCallbacks.takeSummary());
+    return {summary->snapshot(PROGRESS_SNAPSHOT_ROWS), sampleCallbacks.duration()};
+}
+
 void MainWindow::loadTrace() {
+    // Large traces take a while to read, a preview is shown meanwhile
+    auto showPreview = !this->loadOptions.summaryOnly &&
+                       traceArchiveSize(this->filepath) >= static_cast<qint64>(PREVIEW_MIN_TRACE_BYTES);
+    auto options = this->loadOptions;
+    options.progressSnapshots = showPreview;
+
     this->reader = new otf2::reader::reader(this->filepath.toStdString());
-    this->callbacks = new ReaderCallbacks(*reader);
+    this->callbacks = new ReaderCallbacks(*reader, options);
 
     this->reader->set_callback(*callbacks);
-    this->reader->read_definitions();
-    this->reader->read_events();
+    {
+        SelfTracer::Scope scope("reading definitions");
+        this->reader->read_definitions();
+    }
+    {
+        SelfTracer::Scope scope("reading thumbnails");
+        this->thumbnail = TraceThumbnail::fromArchive(this->filepath.toStdString(), this->callbacks->getRegionKinds());
+    }
+    if (!showPreview) {
+        this->readEvents();
+        return;
+    }
 
-    auto slots = this->callbacks->getSlots();
+    auto runtime = this->callbacks->definedDuration();
+    this->loadingPreview = new LoadingPreview(this->filepath, runtime);
+    // Closing the preview must not quit the application while the trace is still read
+    this->loadingPreview->setAttribute(Qt::WA_QuitOnClose, false);
+    this->loadingPreview->show();
+
+    // The thumbnails only need the definitions and are shown before any event is read
+    if (this->thumbnail && runtime.count() > 0) {
+        this->loadingPreview->setThumbnail(this->thumbnail);
+        this->readEvents();
+        return;
+    }
+
+    // Otherwise a sample of the ranks is read in the background before the full read starts
+    typedef std::pair<TraceSummary::Snapshot, types::TraceTime> PreviewSample;
+    auto watcher = new QFutureWatcher<PreviewSample>(this);
+    connect(watcher, &QFutureWatcher<PreviewSample>::finished, this, [this, watcher] {
+        try {
+            auto [snapshot, sampleRuntime] = watcher->result();
+            this->loadingPreview->setSample(std::move(snapshot), sampleRuntime);
+        } catch (const std::exception &) {
+            // Errors of the archive are reported by the full read
+        }
+        watcher->deleteLater();
+        this->readEvents();
+    });
+    watcher->setFuture(QtConcurrent::run(readPreviewSample, this->filepath, this->loadOptions.regionFilter));
+}
+
+void MainWindow::readEvents() {
+    // The events are read in the background while the preview is refreshed with snapshots of what was read so far
+    if (this->loadingPreview) {
+        auto timer = new QTimer(this->loadingPreview);
+        connect(timer, &QTimer::timeout, this->loadingPreview, [this] {
+            this->loadingPreview->setProgress(this->callbacks->latestSnapshot(), this->callbacks->currentTime());
+            this->callbacks->requestSnapshot();
+        });
+        timer->start(PREVIEW_REFRESH_MS);
+    }
+
+    auto watcher = new QFutureWatcher<void>(this);
+    connect(watcher, &QFutureWatcher<void>::finished, this, [this, watcher] {
+        this->finishLoading(watcher->future());
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([this] {
+        // Matching of messages happens inside the event callbacks and is part of this phase
+        SelfTracer::Scope scope("reader callbacks and matching");
+        this->reader->read_events();
+    }));
+}
+
+void MainWindow::finishLoading(QFuture<void> events) {
+    delete this->loadingPreview;
+    this->loadingPreview = nullptr;
+
+    // Errors of the reader are reported instead of showing the window
+    try {
+        try {
+            events.waitForFinished();
+        } catch (const QUnhandledException &e) {
+            if (e.exception()) std::rethrow_exception(e.exception());
+            throw;
+        }
+    } catch (const std::exception &e) {
+        QMessageBox::critical(nullptr, tr("Loading failed"),
+                              tr("Could not read %1: %2").arg(this->filepath, QString::fromStdString(e.what())));
+        QCoreApplication::exit(EXIT_FAILURE);
+        return;
+    }
+
+    // A summary is shown through slots approximating its bins
+    auto summary = this->callbacks->takeSummary();
+    auto slots = summary ? summary->createSlots() : this->callbacks->getSlots();
     auto communications = this->callbacks->getCommunications();
     auto collectives = this->callbacks->getCollectiveCommunications();
     auto trace = new FileTrace(slots, communications, collectives, this->callbacks->duration());
 
     this->data = new TraceDataProxy(trace, this->settings, this);
+    this->data->setSummary(summary);
+    this->data->setCallingContextTree(this->callbacks->takeCallingContextTree());
+    this->data->setThumbnail(std::exchange(this->thumbnail, nullptr));
+    if (this->loadOptions.hasWindow()) {
+        this->data->setSelection(this->loadOptions.windowBegin, this->loadOptions.windowEnd);
+    }
+
+    this->createToolBars();
+    this->createDockWidgets();
+    this->createCentralWidget();
+    this->createMenus();
+    this->show();
 }
 
 void MainWindow::loadSettings() {
@@ -277,7 +529,7 @@ void MainWindow::resetZoom() {
 }
 
 void MainWindow::openFilterPopup() {
-    FilterPopup filterPopup(data->getSettings()->getFilter());
+    FilterPopup filterPopup(data->getSettings()->getFilter(), data->getFullTrace());
 
     auto connection = connect(&filterPopup, SIGNAL(filterChanged(Filter)), this->data, SLOT(setFilter(Filter)));
 
@@ -286,14 +538,70 @@ void MainWindow::openFilterPopup() {
     disconnect(connection);
 }
 
+void MainWindow::openSearchPopup() {
+    if (!this->searchPopup) this->searchPopup = new SearchPopup(this->data, this);
+    this->searchPopup->show();
+    this->searchPopup->raise();
+    this->searchPopup->activateWindow();
+}
+
 void MainWindow::openNewTrace() {
     auto path = this->promptFile();
     this->openNewWindow(path);
 }
 
-void MainWindow::openNewWindow(QString path) {
+void MainWindow::openSelectionInDetail() {
+    auto window = QString("%1:%2").arg(data->getBegin().count()).arg(data->getEnd().count());
+    QStringList arguments = {"--window", window};
+    // The detailed window reads the same regions and ranks as this one
+    if (!this->loadOptions.regionFilterFile.isEmpty()) {
+        arguments << "--region-filter" << this->loadOptions.regionFilterFile;
+    }
+    if (!this->loadOptions.excludedRegions.isEmpty()) {
+        arguments << "--exclude-regions" << this->loadOptions.excludedRegions.join(',');
+    }
+    if (this->loadOptions.rankStride != 1) {
+        arguments << "--rank-stride" << QString::number(this->loadOptions.rankStride);
+    }
+    this->openNewWindow(this->filepath, arguments);
+}
+
+void MainWindow::exportSelection() {
+    ExportDialog exportDialog(this->data, this);
+    if (exportDialog.exec() != QDialog::Accepted) return;
+
+    QFileInfo anchor(exportDialog.anchorPath());
+    auto directory = anchor.absolutePath().toStdString();
+    auto name = anchor.completeBaseName().toStdString();
+    TraceExporter exporter(this->filepath.toStdString(), exportDialog.exportOptions());
+
+    // The source archive is read again, so the export neither blocks the window nor accesses the loaded trace
+    auto watcher = new QFutureWatcher<uint64_t>(this);
+    connect(watcher, &QFutureWatcher<uint64_t>::finished, this, [this, watcher, anchor] {
+        try {
+            try {
+                watcher->waitForFinished();
+            } catch (const QUnhandledException &e) {
+                if (e.exception()) std::rethrow_exception(e.exception());
+                throw;
+            }
+            this->statusBar()->showMessage(
+                tr("Exported %1 events to %2").arg(watcher->result()).arg(anchor.absoluteFilePath()));
+        } catch (const std::exception &e) {
+            QMessageBox::critical(this, tr("Export failed"), QString::fromStdString(e.what()));
+        }
+        watcher->deleteLater();
+    });
+    watcher->setFuture(QtConcurrent::run([exporter, directory, name]() mutable {
+        return exporter.write(directory, name);
+    }));
+    this->statusBar()->showMessage(tr("Exporting to %1...").arg(anchor.absoluteFilePath()));
+}
+
+void MainWindow::openNewWindow(QString path, QStringList arguments) {
+    arguments.append(path);
     QProcess::startDetached(
             QFileInfo(QCoreApplication::applicationFilePath()).absoluteFilePath(),
-            QStringList(path));
+            arguments);
 }
 
@@ -19,6 +19,7 @@
 #define MOTIV_MAINWINDOW_HPP
 
 
+#include <QFuture>
 #include <QMainWindow>
 
 #include "src/ui/widgets/TimeInputField.hpp"
@@ -26,9 +27,16 @@
 #include "src/ReaderCallbacks.hpp"
 #include "src/ui/widgets/TraceOverviewDock.hpp"
 #include "src/ui/widgets/InformationDock.hpp"
+#include "src/ui/widgets/PerformanceDock.hpp"
+#include "src/ui/widgets/ProfileDock.hpp"
+#include "src/ui/widgets/CommunicationMatrixDock.hpp"
+#include "src/ui/widgets/WaitStateDock.hpp"
+#include "src/ui/widgets/CriticalPathDock.hpp"
 #include "src/ui/widgets/License.hpp"
 #include "src/ui/widgets/Help.hpp"
 #include "src/ui/widgets/About.hpp"
+#include "src/ui/windows/LoadingPreview.hpp"
+#include "src/ui/windows/SearchPopup.hpp"
 
 /**
  * @brief The main window of the application.
@@ -42,9 +50,12 @@ public: // constructors
     /**
      * @brief Creates a new instance of the MainWindow class.
      *
+     * The trace is read in the background, the window shows itself once it has been loaded.
+     *
      * @param filepath Path to trace file. If omitted the user is promted for it.
+     * @param options Options defining which parts of the trace are loaded
      */
-    explicit MainWindow(QString filepath = QString());
+    explicit MainWindow(QString filepath = QString(), LoadOptions options = LoadOptions());
     ~MainWindow() override;
 
 public: Q_SIGNALS:
@@ -61,11 +72,28 @@ public Q_SLOTS:
      */
     void openFilterPopup();
 
+    /**
+     * @brief Opens and shows the SearchPopup
+     */
+    void openSearchPopup();
+
     /**
      * @brief Asks for a new trace file and opens the trace
      */
     void openNewTrace();
 
+    /**
+     * @brief Opens the selected time window with all its events in a new window
+     *
+     * Used for traces loaded as a summary only, the trace is read again keeping only the elements of the window.
+     */
+    void openSelectionInDetail();
+
+    /**
+     * @brief Asks for the ranks and the target of the selected time window and exports it in the background
+     */
+    void exportSelection();
+
 private: // methods
     void createMenus();
     void createToolBars();
@@ -74,8 +102,10 @@ private: // methods
 
     QString promptFile();
     void loadTrace();
+    void readEvents();
+    void finishLoading(QFuture<void> events);
     void loadSettings();
-    void openNewWindow(QString path);
+    void openNewWindow(QString path, QStringList arguments = QStringList());
 
 private: // widgets
     QToolBar *topToolbar = nullptr;
@@ -83,21 +113,38 @@ private: // widgets
 
     InformationDock *information = nullptr;
     TraceOverviewDock *traceOverview = nullptr;
+    PerformanceDock *performance = nullptr;
+    ProfileDock *profile = nullptr;
+    CommunicationMatrixDock *communicationMatrix = nullptr;
+    WaitStateDock *waitStates = nullptr;
+    CriticalPathDock *criticalPath = nullptr;
 
     TimeInputField *startTimeInputField = nullptr;
     TimeInputField *endTimeInputField = nullptr;
 
     License *licenseWindow = nullptr;
     Help *helpWindow = nullptr;
+    SearchPopup *searchPopup = nullptr;
     About *aboutWindow = nullptr;
 
 private: // properties
     QString filepath;
+    LoadOptions loadOptions;
     TraceDataProxy *data = nullptr;
 
     otf2::reader::reader *reader = nullptr;
     ReaderCallbacks *callbacks = nullptr;
 
+    /**
+     * Shown while the trace is loaded, nullptr for small traces and once loading has finished
+     */
+    LoadingPreview *loadingPreview = nullptr;
+
+    /**
+     * Thumbnails of the archive until they are handed to the TraceDataProxy
+     */
+    TraceThumbnail *thumbnail = nullptr;
+
     ViewSettings *settings = nullptr;
 };
 
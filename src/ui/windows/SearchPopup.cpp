@@ -0,0 +1,132 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "SearchPopup.hpp"
+
+#include <QGridLayout>
+#include <QPushButton>
+#include <QShortcut>
+
+SearchPopup::SearchPopup(TraceDataProxy *data, QWidget *parent) : QDialog(parent), data(data) {
+    auto grid = new QGridLayout();
+
+    queryField = new QLineEdit;
+    queryField->setPlaceholderText(tr("Region name"));
+    queryField->setClearButtonEnabled(true);
+    resultList = new QListWidget;
+    positionField = new QLabel;
+
+    auto previousButton = new QPushButton(tr("&Previous"));
+    auto nextButton = new QPushButton(tr("&Next"));
+    nextButton->setDefault(true);
+
+    grid->addWidget(queryField, 0, 0, 1, 2);
+    grid->addWidget(resultList, 1, 0, 1, 2);
+    grid->addWidget(positionField, 2, 0, 1, 2);
+    grid->addWidget(previousButton, 3, 0, Qt::AlignLeft);
+    grid->addWidget(nextButton, 3, 1, Qt::AlignRight);
+
+    connect(queryField, &QLineEdit::textChanged, this, &SearchPopup::updateResults);
+    connect(queryField, &QLineEdit::returnPressed, this, &SearchPopup::findNext);
+    connect(resultList, &QListWidget::currentRowChanged, this, &SearchPopup::regionChosen);
+    connect(resultList, &QListWidget::itemActivated, this, &SearchPopup::findNext);
+    connect(previousButton, &QPushButton::clicked, this, &SearchPopup::findPrevious);
+    connect(nextButton, &QPushButton::clicked, this, &SearchPopup::findNext);
+    connect(new QShortcut(QKeySequence::FindNext, this), &QShortcut::activated, this, &SearchPopup::findNext);
+    connect(new QShortcut(QKeySequence::FindPrevious, this), &QShortcut::activated, this, &SearchPopup::findPrevious);
+
+    setLayout(grid);
+    setWindowTitle(tr("Find region"));
+    setModal(false);
+}
+
+void SearchPopup::updateResults() {
+    auto matches = data->getRegionIndex()->search(queryField->text().toStdString());
+
+    resultList->clear();
+    for (size_t i = 0; i < matches.size() && i < SEARCH_MAX_RESULTS; i++) {
+        const auto &match = matches[i];
+        auto item = new QListWidgetItem(tr("%1 (%2 calls)")
+                                            .arg(QString::fromStdString(match.region->name().str()))
+                                            .arg(match.count));
+        item->setData(Qt::UserRole, QVariant::fromValue(static_cast<qulonglong>(match.index)));
+        item->setData(Qt::UserRole + 1, QVariant::fromValue(static_cast<qulonglong>(match.count)));
+        resultList->addItem(item);
+    }
+    if (matches.size() > SEARCH_MAX_RESULTS) {
+        positionField->setText(tr("Showing %1 of %2 regions").arg(SEARCH_MAX_RESULTS).arg(matches.size()));
+    } else {
+        positionField->setText(tr("%1 regions").arg(matches.size()));
+    }
+    if (!matches.empty()) {
+        resultList->setCurrentRow(0);
+    }
+}
+
+void SearchPopup::regionChosen() {
+    current = nullptr;
+}
+
+void SearchPopup::findNext() {
+    if (!hasRegion()) return;
+
+    auto index = data->getRegionIndex();
+    // The first call is searched from the selected window on, later calls are taken in order
+    auto slot = current ? index->at(chosenRegion(), currentPosition + 1)
+                        : index->next(chosenRegion(), data->getBegin() - types::TraceTime(1));
+    if (slot) jumpTo(slot);
+}
+
+void SearchPopup::findPrevious() {
+    if (!hasRegion()) return;
+
+    auto index = data->getRegionIndex();
+    auto slot = current ? (currentPosition > 0 ? index->at(chosenRegion(), currentPosition - 1) : nullptr)
+                        : index->previous(chosenRegion(), data->getEnd());
+    if (slot) jumpTo(slot);
+}
+
+void SearchPopup::jumpTo(Slot *slot) {
+    auto index = data->getRegionIndex();
+    current = slot;
+    currentPosition = index->position(chosenRegion(), slot);
+
+    // The window keeps its width and is centered on the call, unless the call is longer
+    auto width = data->getEnd() - data->getBegin();
+    auto duration = slot->endTime - slot->startTime;
+    if (duration >= width) {
+        data->setSelection(slot->startTime, slot->endTime);
+    } else {
+        auto begin = slot->startTime - (width - duration) / 2;
+        begin = qBound(types::TraceTime(0), begin, data->getTotalRuntime() - width);
+        data->setSelection(begin, begin + width);
+    }
+    data->setTimeElementSelection(slot);
+
+    positionField->setText(tr("Call %1 of %2 on %3")
+                               .arg(currentPosition + 1)
+                               .arg(resultList->currentItem()->data(Qt::UserRole + 1).toULongLong())
+                               .arg(QString::fromStdString(slot->location->location_group().name().str())));
+}
+
+bool SearchPopup::hasRegion() const {
+    return resultList->currentItem() != nullptr;
+}
+
+size_t SearchPopup::chosenRegion() const {
+    return static_cast<size_t>(resultList->currentItem()->data(Qt::UserRole).toULongLong());
+}
@@ -0,0 +1,86 @@
+/*
+ * Marvelous OTF2 Traces Interactive Visualizer (MOTIV)
+ * Copyright (C) 2023 Florian Gallrein, Björn Gehrke
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+#ifndef MOTIV_SEARCHPOPUP_HPP
+#define MOTIV_SEARCHPOPUP_HPP
+
+
+#include <QDialog>
+#include <QLabel>
+#include <QLineEdit>
+#include <QListWidget>
+
+#include "src/ui/TraceDataProxy.hpp"
+
+/**
+ * Defines the maximal number of regions listed for a search
+ */
+#define SEARCH_MAX_RESULTS 200
+
+/**
+ * @brief A popup searching regions by name and jumping between their calls
+ *
+ * Matching regions are listed with their number of calls while typing. Next and previous move the selected time
+ * window to the calls of the chosen region and select them. The popup is not modal, so the timeline can be used while
+ * it is open.
+ */
+class SearchPopup : public QDialog {
+    Q_OBJECT
+
+public:
+    /**
+     * @brief Creates a new instance of the SearchPopup class
+     * @param data The data proxy providing the region index and the selection
+     * @param parent The parent QWidget
+     */
+    explicit SearchPopup(TraceDataProxy *data, QWidget *parent = nullptr);
+
+public Q_SLOTS:
+    /**
+     * @brief Selects the next call of the chosen region
+     */
+    void findNext();
+
+    /**
+     * @brief Selects the previous call of the chosen region
+     */
+    void findPrevious();
+
+private Q_SLOTS:
+    void updateResults();
+    void regionChosen();
+
+private:
+    void jumpTo(Slot *slot);
+    [[nodiscard]] bool hasRegion() const;
+    [[nodiscard]] size_t chosenRegion() const;
+
+private:
+    TraceDataProxy *data = nullptr;
+    QLineEdit *queryField = nullptr;
+    QListWidget *resultList = nullptr;
+    QLabel *positionField = nullptr;
+
+    /**
+     * The last selected call, nullptr if none was selected since the region was chosen
+     */
+    Slot *current = nullptr;
+    size_t currentPosition = 0;
+};
+
+
+#endif //MOTIV_SEARCHPOPUP_HPP
@@ -104,3 +104,36 @@ std::string collectiveCommunicationOperationName(otf2::collective_type type) {
             throw std::invalid_argument("Invalid operation type");
     }
 }
+
+bool isNxNCollective(otf2::collective_type type) {
+    switch (type) {
+        case otf2::common::collective_type::barrier:
+        case otf2::common::collective_type::all_gather:
+        case otf2::common::collective_type::all_gatherv:
+        case otf2::common::collective_type::all_to_all:
+        case otf2::common::collective_type::all_to_allv:
+        case otf2::common::collective_type::all_to_allw:
+        case otf2::common::collective_type::all_reduce:
+        case otf2::common::collective_type::reduce_scatter:
+        case otf2::common::collective_type::reduce_scatter_block:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isOneToNCollective(otf2::collective_type type) {
+    return type == otf2::common::collective_type::broadcast ||
+           type == otf2::common::collective_type::scatter ||
+           type == otf2::common::collective_type::scatterv;
+}
+
+std::optional<uint64_t> collectiveRootLocation(const CollectiveCommunicationEvent *event) {
+    auto communicator = std::get_if<otf2::definition::comm>(event->getCommunicator());
+    if (!communicator || !holds_alternative<otf2::definition::comm_group>(communicator->group())) {
+        return std::nullopt;
+    }
+    auto group = get<otf2::definition::comm_group>(communicator->group());
+    if (event->getRoot() >= group.size()) return std::nullopt;
+    return group[event->getRoot()].ref().get();
+}
@@ -21,6 +21,7 @@
 #include <QLayout>
 #include <QWidget>
 #include <QDebug>
+#include <optional>
 #include "src/models/communication/CommunicationKind.hpp"
 #include "src/models/Range.hpp"
 
@@ -37,6 +38,31 @@ std::string communicationKindName(CommunicationKind kind);
 
 std::string collectiveCommunicationOperationName(otf2::collective_type type);
 
+/**
+ * Returns whether every member of a collective operation depends on every other member, like in barriers and
+ * all-to-all operations.
+ *
+ * @param type the collective operation
+ * @return true for N×N operations
+ */
+bool isNxNCollective(otf2::collective_type type);
+
+/**
+ * Returns whether all members of a collective operation depend on its root, like in broadcasts and scatters.
+ *
+ * @param type the collective operation
+ * @return true for 1×N operations
+ */
+bool isOneToNCollective(otf2::collective_type type);
+
+/**
+ * Returns the location of the root of a collective operation.
+ *
+ * @param event the collective operation
+ * @return the ref of the root location or nullopt if the operation has no root or it cannot be resolved
+ */
+std::optional<uint64_t> collectiveRootLocation(const CollectiveCommunicationEvent *event);
+
 template<typename T, typename K, typename C = std::less<K>>
 std::map<K, Range<T>, C> groupBy(Range<T> range, std::function<K(const T)> keySelector, std::function<bool(const T, const T)> compare) {
 